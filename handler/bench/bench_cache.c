@@ -0,0 +1,83 @@
+#include "system.h"
+#include "../sectorcache.c"
+
+/*
+    Mesure du coût d'une recherche dans le cache de secteurs selon le nombre de buffers.
+    Compilation et exécution sur un hôte Unix, depuis le répertoire handler:
+        gcc -O2 -o bench_cache bench/bench_cache.c && ./bench_cache
+    Pour chaque taille, le cache est rempli puis interrogé sur des secteurs présents
+    et absents, d'abord par la table de hachage, puis par le parcours des listes que
+    Sch_Find() utilise quand la table n'a pas pu être allouée.
+
+    17-10-2026 (Seg)    Benchmark de Sch_Find()
+*/
+
+
+#define BENCH_SECTORS_PER_TRACK 16
+#define BENCH_LOOKUPS           2000000L
+
+
+/***** Prototypes */
+double P_Bench_Lookup(struct SectorCache *, LONG, long);
+
+volatile long Bench_CountOfHits;    /* Empêche le compilateur de supprimer les recherches */
+
+
+/*****
+    Durée moyenne d'une recherche en nanosecondes.
+    Un quart des recherches porte sur un secteur absent du cache.
+*****/
+
+double P_Bench_Lookup(struct SectorCache *SectorCachePtr, LONG Count, long CountOfLookups)
+{
+    clock_t Start;
+    long i,Found=0;
+
+    Start=clock();
+    for(i=0; i<CountOfLookups; i++)
+    {
+        LONG Idx=(LONG)((i*7919)%(Count+Count/3+1));
+        if(Sch_Find(SectorCachePtr,Idx/BENCH_SECTORS_PER_TRACK,Idx%BENCH_SECTORS_PER_TRACK+1)!=NULL) Found++;
+    }
+    Bench_CountOfHits=Found;
+
+    return (double)(clock()-Start)*1e9/CLOCKS_PER_SEC/(double)CountOfLookups;
+}
+
+
+int main(void)
+{
+    static const LONG Sizes[]={5,10,20,50,100,200,500,1000,2000,0};
+    LONG i,j;
+
+    printf("buffers   hash (ns)   listes (ns)\n");
+    for(i=0; Sizes[i]!=0; i++)
+    {
+        struct SectorCache Cache;
+        struct SectorCacheNode **HashTablePtr;
+        double HashTime,ListTime;
+        long CountOfLookups=BENCH_LOOKUPS;
+
+        Sch_Init(&Cache,256);
+        Sch_SetBufferMax(&Cache,Sizes[i]);
+        for(j=0; j<Sizes[i]; j++)
+        {
+            struct SectorCacheNode *NodePtr=Sch_Obtain(&Cache,j/BENCH_SECTORS_PER_TRACK,j%BENCH_SECTORS_PER_TRACK+1,TRUE);
+            Sch_SetStatus(&Cache,NodePtr,(j&7)==0?SCN_UPDATED:SCN_INITIALIZED);
+        }
+
+        HashTime=P_Bench_Lookup(&Cache,Sizes[i],CountOfLookups);
+
+        /* Le parcours des listes est d'autant plus lent que le cache est grand */
+        if(Sizes[i]>=500) CountOfLookups/=20;
+        HashTablePtr=Cache.HashTablePtr;
+        Cache.HashTablePtr=NULL;
+        ListTime=P_Bench_Lookup(&Cache,Sizes[i],CountOfLookups);
+        Cache.HashTablePtr=HashTablePtr;
+
+        printf("%7ld   %9.1f   %11.1f\n",(long)Sizes[i],HashTime,ListTime);
+        Sch_Dispose(&Cache);
+    }
+
+    return 0;
+}
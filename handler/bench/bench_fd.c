@@ -0,0 +1,151 @@
+#include "system.h"
+#include "debug.h"
+#include "../sectorcache.c"
+#include "../disklayer.c"
+#include "../datalayerfd.c"
+#include "../datalayersap.c"
+#include "../datalayertds.c"
+#include "../datalayerram.c"
+#include "../datalayersim.c"
+#include "datalayerfloppy.c"
+
+#include <sys/time.h>
+
+/*
+    Débit de la couche .fd comparé au lecteur de disquette simulé, sur la même image.
+    Compilation et exécution sur un hôte Unix, depuis le répertoire handler:
+        gcc -O2 -o bench_fd bench/bench_fd.c && ./bench_fd [image.fd]
+    L'image (une face de 80 pistes de 16 secteurs de 256 octets) est créée puis
+    supprimée. Elle est ouverte directement (DFd_ReadSectors(), DFd_WriteSectors() et
+    DFd_Finalize()), puis au travers de @sim: qui ajoute les temps d'accès d'un lecteur
+    3"1/2. Pour @sim:, la dernière colonne donne le temps simulé d'un passage sur le
+    disque, c'est à dire ce que coûterait la même opération sur une vraie disquette.
+
+    17-10-2026 (Seg)    Benchmark de la couche .fd
+*/
+
+
+#define BENCH_TRACKS            80
+#define BENCH_SECTORS           16
+#define BENCH_SECTOR_SIZE       256
+#define BENCH_FACE_SIZE         (BENCH_TRACKS*BENCH_SECTORS*BENCH_SECTOR_SIZE)
+#define BENCH_PASSES            200
+
+
+/***** Prototypes */
+double P_Bench_GetTime(void);
+BOOL P_Bench_CreateImage(const char *);
+void P_Bench_Run(const char *, const char *, BOOL);
+
+static UBYTE Bench_Track[BENCH_SECTORS*BENCH_SECTOR_SIZE];
+
+
+/*****
+    Temps écoulé en secondes (les écritures de DFd_Finalize() ne consomment pas de temps CPU)
+*****/
+
+double P_Bench_GetTime(void)
+{
+    struct timeval Time;
+
+    gettimeofday(&Time,NULL);
+    return (double)Time.tv_sec+(double)Time.tv_usec/1e6;
+}
+
+
+/*****
+    Création d'une image .fd d'une face
+*****/
+
+BOOL P_Bench_CreateImage(const char *FileName)
+{
+    FILE *File=fopen(FileName,"wb");
+    LONG i;
+
+    if(File==NULL) return FALSE;
+    for(i=0; i<BENCH_FACE_SIZE; i++) fputc(i*7&0xff,File);
+    return fclose(File)==0?TRUE:FALSE;
+}
+
+
+/*****
+    Lecture puis écriture de toutes les pistes, BENCH_PASSES fois.
+    Chaque passage d'écriture se termine par DL_Finalize(), qui réécrit les pistes modifiées.
+*****/
+
+void P_Bench_Run(const char *Label, const char *Name, BOOL IsSim)
+{
+    struct DiskLayer *DLayer;
+    struct DataLayerSimStats Stats;
+    double Start,ReadTime,WriteTime,ReadSimTime=0.0,WriteSimTime=0.0;
+    ULONG ErrorCode;
+    LONG Pass,Track;
+    BOOL IsOk=TRUE;
+
+    DLayer=DL_Open(Name,0,0,0,0,BENCH_TRACKS,BENCH_SECTORS,BENCH_SECTOR_SIZE,32,NULL,NULL,&ErrorCode);
+    if(DLayer==NULL)
+    {
+        printf("%-8s ouverture impossible: %s\n",Label,DL_GetDLTextErr(ErrorCode));
+        return;
+    }
+
+    Start=P_Bench_GetTime();
+    for(Pass=0; Pass<BENCH_PASSES && IsOk; Pass++)
+    {
+        for(Track=0; Track<BENCH_TRACKS && IsOk; Track++)
+        {
+            IsOk=DL_ReadSectorsData(DLayer,Track,1,BENCH_SECTORS,Bench_Track,BENCH_SECTOR_SIZE);
+        }
+        if(IsSim && Pass==0 && DL_GetSimStats(DLayer,&Stats,FALSE)) ReadSimTime=(double)Stats.Seconds+(double)Stats.Micros/1e6;
+    }
+    ReadTime=P_Bench_GetTime()-Start;
+    if(IsSim) DL_GetSimStats(DLayer,&Stats,TRUE);
+
+    Start=P_Bench_GetTime();
+    for(Pass=0; Pass<BENCH_PASSES && IsOk; Pass++)
+    {
+        Bench_Track[0]=(UBYTE)Pass;
+        for(Track=0; Track<BENCH_TRACKS && IsOk; Track++)
+        {
+            IsOk=DL_WriteSectorsData(DLayer,Track,1,BENCH_SECTORS,Bench_Track,BENCH_SECTOR_SIZE);
+        }
+        if(IsOk) IsOk=DL_Finalize(DLayer,FALSE);
+        if(IsSim && Pass==0 && DL_GetSimStats(DLayer,&Stats,FALSE)) WriteSimTime=(double)Stats.Seconds+(double)Stats.Micros/1e6;
+    }
+    WriteTime=P_Bench_GetTime()-Start;
+
+    if(!IsOk) printf("%-8s erreur: %s\n",Label,DL_GetDLTextErr(DL_GetError(DLayer)));
+    else
+    {
+        double Size=(double)BENCH_FACE_SIZE*BENCH_PASSES/(1024.0*1024.0);
+
+        printf("%-8s lecture    %9.1f Mo/s",Label,Size/ReadTime);
+        if(IsSim) printf("   %6.2f s (%5.1f Ko/s)",ReadSimTime,BENCH_FACE_SIZE/1024.0/ReadSimTime);
+        printf("\n%-8s écriture   %9.1f Mo/s",Label,Size/WriteTime);
+        if(IsSim) printf("   %6.2f s (%5.1f Ko/s)",WriteSimTime,BENCH_FACE_SIZE/1024.0/WriteSimTime);
+        printf("\n");
+    }
+
+    DL_Close(DLayer);
+}
+
+
+int main(int argc, char **argv)
+{
+    const char *FileName=argc>1?argv[1]:"bench.fd";
+    char SimName[256];
+
+    if(!P_Bench_CreateImage(FileName))
+    {
+        printf("Impossible de créer %s\n",FileName);
+        return 1;
+    }
+
+    printf("%d passages de %d Ko, temps hôte puis temps simulé d'un passage\n",BENCH_PASSES,BENCH_FACE_SIZE/1024);
+    P_Bench_Run("fd",FileName,FALSE);
+    sprintf(SimName,"%s:%s",SIM_NAME_PREFIX,FileName);
+    P_Bench_Run("@sim:fd",SimName,TRUE);
+
+    remove(FileName);
+    return 0;
+}
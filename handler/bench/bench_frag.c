@@ -0,0 +1,163 @@
+#include "system.h"
+#include "debug.h"
+#include "../sectorcache.c"
+#include "../disklayer.c"
+#include "../datalayerfd.c"
+#include "../datalayersap.c"
+#include "../datalayertds.c"
+#include "../datalayerram.c"
+#include "../datalayersim.c"
+#include "../util.c"
+#include "../convert.c"
+#include "../filesystem.c"
+#include "datalayerfloppy.c"
+
+/*
+    Coût de la lecture d'un fichier fragmenté au maximum, sur un disque virtuel @ram.
+    Compilation et exécution sur un hôte Unix, depuis le répertoire handler:
+        gcc -O2 -o bench_frag bench/bench_frag.c && ./bench_frag
+    Deux fichiers sont écrits bloc par bloc en alternance jusqu'à remplir le disque,
+    puis le second est effacé: aucun bloc du premier ne suit le précédent sur le disque.
+    Le fichier est ensuite lu avec la liste des blocs du handle (P_FS_UpdateClusterList()),
+    puis en l'invalidant avant chaque appel, ce qui oblige à reparcourir toute la chaîne
+    de la FAT. P_FS_GetGeoDetailFromOffset() s'arrêtait au bloc cherché: la seconde
+    colonne majore donc son coût, qui croissait avec la position dans le fichier.
+    Le disque entier tient dans le cache: seul le coût du file system est mesuré.
+
+    17-10-2026 (Seg)    Benchmark de la liste des blocs d'un handle
+*/
+
+
+#define BENCH_SEQ_PASSES        200
+#define BENCH_RANDOM_READS      200000L
+
+
+/***** Prototypes */
+LONG P_Bench_Fragment(struct FileSystem *);
+double P_Bench_Sequential(struct FSHandle *, BOOL);
+double P_Bench_Random(struct FSHandle *, LONG, LONG, BOOL);
+
+static UBYTE Bench_Buffer[4096];
+
+
+/*****
+    Ecriture du fichier "frag" en alternance avec le fichier "pad", bloc par bloc.
+    Retourne le nombre de blocs de "frag" qui ne suivent pas le bloc précédent sur le disque.
+*****/
+
+LONG P_Bench_Fragment(struct FileSystem *FS)
+{
+    static const LONG Type[2]={0x0200,0x0200};
+    struct FSHandle *FragPtr,*PadPtr,*h;
+    LONG BlockSize=FS->SectorsPerBlock*FS->FSSectorSize;
+    LONG ErrorCode,i,Count=0;
+
+    FragPtr=FS_OpenFile(FS,FS_MODE_NEWFILE,"frag",&Type[0],FALSE,FALSE,&ErrorCode);
+    PadPtr=FS_OpenFile(FS,FS_MODE_NEWFILE,"pad",&Type[1],FALSE,FALSE,&ErrorCode);
+    if(FragPtr==NULL || PadPtr==NULL) return -1;
+
+    for(i=0; i<BlockSize; i++) Bench_Buffer[i]=(UBYTE)(i*7);
+    while(FS_WriteFile(FragPtr,Bench_Buffer,BlockSize)==BlockSize && FS_WriteFile(PadPtr,Bench_Buffer,BlockSize)==BlockSize);
+
+    FS_CloseFile(PadPtr);
+    FS_CloseFile(FragPtr);
+    FS_DeleteFile(FS,"pad",&Type[1],FALSE);
+
+    h=FS_OpenFile(FS,FS_MODE_OLDFILE,"frag",&Type[0],FALSE,FALSE,&ErrorCode);
+    if(h==NULL) return -1;
+    P_FS_UpdateClusterList(h);
+    for(i=1; i<h->CountOfClusters; i++)
+    {
+        if(h->ClusterList[i]!=h->ClusterList[i-1]+1) Count++;
+    }
+    FS_CloseFile(h);
+
+    return Count;
+}
+
+
+/*****
+    Lecture séquentielle du fichier par morceaux d'un secteur.
+    Retourne le débit en Ko/s.
+*****/
+
+double P_Bench_Sequential(struct FSHandle *h, BOOL IsInvalidate)
+{
+    LONG Pass,Len;
+    double Size=0.0;
+    clock_t Start=clock();
+
+    for(Pass=0; Pass<BENCH_SEQ_PASSES; Pass++)
+    {
+        FS_Seek(h,0);
+        do
+        {
+            if(IsInvalidate) h->CountOfClusters=0;
+            Len=FS_ReadFile(h,Bench_Buffer,h->FS->FSSectorSize);
+            if(Len>0) Size+=(double)Len;
+        } while(Len>0);
+    }
+
+    return Size/1024.0/((double)(clock()-Start)/CLOCKS_PER_SEC);
+}
+
+
+/*****
+    Lectures d'un octet à des positions pseudo-aléatoires comprises entre Min et Max.
+    Retourne la durée moyenne d'une lecture en nanosecondes.
+*****/
+
+double P_Bench_Random(struct FSHandle *h, LONG Min, LONG Max, BOOL IsInvalidate)
+{
+    ULONG Seed=12345;
+    long i;
+    clock_t Start=clock();
+
+    for(i=0; i<BENCH_RANDOM_READS; i++)
+    {
+        Seed=Seed*1103515245+12345;
+        FS_Seek(h,Min+(LONG)((Seed>>8)%(ULONG)(Max-Min)));
+        if(IsInvalidate) h->CountOfClusters=0;
+        FS_ReadFile(h,Bench_Buffer,1);
+    }
+
+    return (double)(clock()-Start)*1e9/CLOCKS_PER_SEC/(double)BENCH_RANDOM_READS;
+}
+
+
+int main(void)
+{
+    static const LONG Type=0x0200;
+    struct DiskLayer *DLayer;
+    struct FileSystem *FS;
+    struct FSHandle *h;
+    ULONG ErrorCode;
+    LONG Fragments,Size,Error;
+    int i;
+
+    DLayer=DL_Open("@ram",0,0,0,0,80,16,256,2000,NULL,NULL,&ErrorCode);
+    FS=FS_AllocFileSystem(80,256,16,TRUE);
+    if(DLayer==NULL || FS==NULL) return 1;
+    FS->DiskLayerPtr=DLayer;
+    if(FS_Format(FS,"FRAG")!=0 || FS_InitFileSystem(FS,DLayer)!=0) return 1;
+
+    Fragments=P_Bench_Fragment(FS);
+    h=FS_OpenFile(FS,FS_MODE_OLDFILE,"frag",&Type,FALSE,FALSE,&Error);
+    if(Fragments<0 || h==NULL) return 1;
+    Size=FS_GetSize(h);
+    P_FS_UpdateClusterList(h);
+    printf("fichier de %ld octets, %ld blocs, %ld fragments\n\n",(long)Size,(long)h->CountOfClusters,(long)Fragments+1);
+
+    printf("                          liste du handle   parcours de la FAT\n");
+    printf("séquentiel (Ko/s)         %15.0f   %18.0f\n",P_Bench_Sequential(h,FALSE),P_Bench_Sequential(h,TRUE));
+    for(i=0; i<4; i++)
+    {
+        LONG Min=Size/4*i,Max=Size/4*(i+1);
+        printf("aléatoire %d/4 (ns)        %15.1f   %18.1f\n",i+1,P_Bench_Random(h,Min,Max,FALSE),P_Bench_Random(h,Min,Max,TRUE));
+    }
+
+    FS_CloseFile(h);
+    FS_FreeFileSystem(FS);
+    DL_Close(DLayer);
+    return 0;
+}
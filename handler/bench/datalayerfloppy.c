@@ -0,0 +1,29 @@
+#include "system.h"
+#include "../datalayerfloppy.h"
+#include "../disklayer.h"
+
+/*
+    Remplacement de ../datalayerfloppy.c pour les benchmarks: le trackdisk.device
+    n'existe pas sur l'hôte, l'ouverture du lecteur échoue toujours. Le lecteur est
+    remplacé par la source simulée @sim (voir ../datalayersim.c).
+*/
+
+
+struct DataLayerFloppy *DFlp_Open(const char *DeviceName, ULONG Flags, ULONG Unit, ULONG Side, LONG CountOfTracks, LONG SectorPerTrack, LONG SectorSize, void (*IntFuncPtr)(struct DataLayerFloppy *, void *), void *IntData, ULONG *ErrorCode)
+{
+    *ErrorCode=DL_OPEN_DEVICE;
+    return NULL;
+}
+
+void DFlp_Close(struct DataLayerFloppy *DLayer) {}
+BOOL DFlp_IsDiskIn(struct DataLayerFloppy *DLayer) {return FALSE;}
+BOOL DFlp_IsProtected(struct DataLayerFloppy *DLayer) {return TRUE;}
+void DFlp_Clean(struct DataLayerFloppy *DLayer) {}
+BOOL DFlp_IsChanged(struct DataLayerFloppy *DLayer) {return FALSE;}
+void DFlp_SetChanged(struct DataLayerFloppy *DLayer, BOOL IsChanged) {}
+void DFlp_MotorOff(struct DataLayerFloppy *DLayer) {}
+ULONG DFlp_Sync(struct DataLayerFloppy *DLayer) {return DL_SUCCESS;}
+ULONG DFlp_Finalize(struct DataLayerFloppy *DLayer) {return DL_SUCCESS;}
+ULONG DFlp_FormatTrack(struct DataLayerFloppy *DLayer, ULONG Track, ULONG Interleave, const UBYTE *BufferPtr) {return DL_NO_DISK;}
+ULONG DFlp_ReadSectors(struct DataLayerFloppy *DLayer, ULONG Track, ULONG Sector, ULONG Count, UBYTE *BufferPtr) {return DL_NO_DISK;}
+ULONG DFlp_WriteSectors(struct DataLayerFloppy *DLayer, ULONG Track, ULONG Sector, ULONG Count, const UBYTE *BufferPtr) {return DL_NO_DISK;}
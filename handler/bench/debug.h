@@ -0,0 +1,7 @@
+#ifndef DEBUG_H
+#define DEBUG_H
+
+/* Remplacement de ../debug.h pour les benchmarks: les traces sont supprimées */
+#define Debug(f)
+
+#endif  /* DEBUG_H */
@@ -0,0 +1,119 @@
+#ifndef SYSTEM_H
+#define SYSTEM_H
+
+/*
+    Remplacement de ../system.h pour compiler les sources du handler sur un hôte
+    Unix, en dehors d'AmigaOS. Chaque benchmark inclut ce fichier avant les
+    sources du handler: la garde SYSTEM_H écarte alors ../system.h. Un benchmark
+    forme une seule unité de compilation, les fonctions Sys_ sont donc définies ici.
+*/
+
+#define SYSTEM_UNIX 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <time.h>
+
+/* Types Amiga: LONG et ULONG font 32 bits comme sur la machine cible */
+typedef int             LONG;
+typedef unsigned int    ULONG;
+typedef short           WORD;
+typedef unsigned short  UWORD;
+typedef char            BYTE;
+typedef unsigned char   UBYTE;
+typedef char           *STRPTR;
+typedef void           *APTR;
+typedef long            BOOL;
+
+#ifndef TRUE
+#define TRUE            1
+#endif
+#ifndef FALSE
+#define FALSE           0
+#endif
+
+typedef void REGEX;
+
+#define MSIZEOF(s,m) sizeof(((s*)0)->m)
+
+#define Sys_CharToLower(Char) tolower(Char)
+#define Sys_CharToUpper(Char) toupper(Char)
+
+
+void *Sys_AllocMem(ULONG Size)
+{
+    return calloc(1,(size_t)Size);
+}
+
+void Sys_FreeMem(void *Ptr)
+{
+    free(Ptr);
+}
+
+void Sys_MemCopy(void *DstPtr, void *SrcPtr, LONG Size)
+{
+    memmove(DstPtr,SrcPtr,(size_t)Size);
+}
+
+void Sys_StrCopy(char *Dst, const char *Src, LONG MaxLen)
+{
+    strncpy(Dst,Src,(size_t)MaxLen);
+    Dst[MaxLen-1]=0;
+}
+
+LONG Sys_StrLen(const char *String)
+{
+    return (LONG)strlen(String);
+}
+
+LONG Sys_StrCmp(const char *String1, const char *String2)
+{
+    return (LONG)strcmp(String1,String2);
+}
+
+LONG Sys_StrCmpNoCase(const char *String1, const char *String2)
+{
+    return (LONG)strcasecmp(String1,String2);
+}
+
+void Sys_SPrintf(char *Dst, char *Format, ...)
+{
+    va_list Args;
+
+    va_start(Args,Format);
+    vsprintf(Dst,Format,Args);
+    va_end(Args);
+}
+
+/* Les motifs ne sont pas utilisés par les benchmarks: seul le nom exact correspond */
+REGEX *Sys_AllocPatternNoCase(const char *Pattern, BOOL *IsPatternPtr)
+{
+    char *Ptr=(char *)malloc(strlen(Pattern)+1);
+
+    if(Ptr!=NULL) strcpy(Ptr,Pattern);
+    if(IsPatternPtr!=NULL) *IsPatternPtr=FALSE;
+    return (REGEX *)Ptr;
+}
+
+void Sys_FreePattern(REGEX *RegEx)
+{
+    free(RegEx);
+}
+
+BOOL Sys_MatchPattern(REGEX *RegEx, const char *String)
+{
+    return strcasecmp((const char *)RegEx,String)==0?TRUE:FALSE;
+}
+
+LONG Sys_GetTime(LONG *Year, LONG *Month, LONG *Day, LONG *Hour, LONG *Min, LONG *Sec)
+{
+    *Year=2026; *Month=10; *Day=17;
+    *Hour=0; *Min=0; *Sec=0;
+    return 0;
+}
+
+#endif  /* SYSTEM_H */
@@ -4,8 +4,8 @@
 
 /*
     10-09-2020 (Seg)    Ajout de Cnv_SplitHostName()
-    27-08-2018 (Seg)    Ajout des fonctions pour grr les accents du file system
-    04-05-2017 (Seg)    Copie du systme de conversion de la commande ToDisk
+    27-08-2018 (Seg)    Ajout des fonctions pour gérér les accents du file system
+    04-05-2017 (Seg)    Copie du système de conversion de la commande ToDisk
 */
 
 
@@ -44,7 +44,7 @@ void Cnv_InitConvertContext(struct ConvertContext *Ctx, const UBYTE *Src, LONG S
 
 
 /*****
-    Rduction d'un nom hte en un autre nom hte respectant le nombre de caractres
+    Réduction d'un nom hôte en un autre nom hôte respectant le nombre de caractères
     possibles pour un nom de fichier du file system.
 *****/
 
@@ -58,9 +58,9 @@ void Cnv_SplitHostName(const char *HostName, char *SplittedHostName)
 
 
 /*****
-    Conversion d'un nom de fichier Hte dans le format de nom Thomson,
-    avec conversion du jeu de caractres accents.
-    - Name: chane ANSI
+    Conversion d'un nom de fichier Hôte dans le format de nom Thomson,
+    avec conversion du jeu de caractères accentés.
+    - Name: chaîne ANSI
     - ToName: buffer de 11 octets minimum (8 pour le nom + 3 pour le suffixe)
 *****/
 
@@ -70,7 +70,7 @@ void Cnv_ConvertHostNameToThomsonName(const char *Name, UBYTE *ToName)
     char Tmp[33];
     LONG Len;
 
-    /* Conversion du jeu de caractres */
+    /* Conversion du jeu de caractères */
     Cnv_InitConvertContext(&CtxConv,
         (UBYTE *)Name,Sys_StrLen(Name),
         (UBYTE *)Tmp,sizeof(Tmp)-sizeof(char),
@@ -78,16 +78,16 @@ void Cnv_ConvertHostNameToThomsonName(const char *Name, UBYTE *ToName)
     Len=Cnv_AnsiToAsciiG2(&CtxConv);
     Tmp[Len]=0;
 
-    /* Rduction du nom */
+    /* Réduction du nom */
     Utl_ConvertHostNameToThomsonName(Tmp,ToName);
 }
 
 
 /*****
-    Conversion d'un nom au format Thomson en nom de fichier Hte,
-    avec conversion du jeu de caractres accents.
+    Conversion d'un nom au format Thomson en nom de fichier Hôte,
+    avec conversion du jeu de caractères accentés.
     - ToName: buffer de 11 octets contenant le nom et le suffixe
-    - Name: buffer de 13 caractres minimum (12 pour le nom + 1 zro de terminaison)
+    - Name: buffer de 13 caractères minimum (12 pour le nom + 1 zéro de terminaison)
 *****/
 
 void Cnv_ConvertThomsonNameToHostName(const UBYTE *ToName, char *Name, BOOL IsNormalize)
@@ -98,21 +98,21 @@ void Cnv_ConvertThomsonNameToHostName(const UBYTE *ToName, char *Name, BOOL IsNo
 
     for(i=0; i<sizeof(Tmp); i++) Tmp[i]=' ';
 
-    /* Conversion du jeu de caractres du nom */
+    /* Conversion du jeu de caractères du nom */
     Cnv_InitConvertContext(&CtxConv,
         ToName,8,
         Tmp,sizeof(Tmp),
         0);
     Cnv_AsciiG2ToAnsi(&CtxConv);
 
-    /* Conversion du jeu de caractres du suffixe */
+    /* Conversion du jeu de caractères du suffixe */
     Cnv_InitConvertContext(&CtxConv,
         &ToName[8],3,
         &Tmp[8],sizeof(Tmp)-8,
         0);
     Cnv_AsciiG2ToAnsi(&CtxConv);
 
-    /* Gnration du nom sur le host */
+    /* Génération du nom sur le host */
     Utl_ConvertThomsonNameToHostName(Tmp,Name);
 
     /* Normalisation */
@@ -123,9 +123,9 @@ void Cnv_ConvertThomsonNameToHostName(const UBYTE *ToName, char *Name, BOOL IsNo
 
 /*****
     Conversopn d'un nom de volume dans le format thomson, avec conversion
-    du jeu de caractres accentus.
+    du jeu de caractères accentués.
     - Label: nom au format ANSI
-    - ToLabel: buffer de 8 caractres minimum
+    - ToLabel: buffer de 8 caractères minimum
 *****/
 
 void Cnv_ConvertHostLabelToThomsonLabel(const char *Label, UBYTE *ToLabel)
@@ -134,7 +134,7 @@ void Cnv_ConvertHostLabelToThomsonLabel(const char *Label, UBYTE *ToLabel)
     char Tmp[33];
     LONG Len;
 
-    /* Conversion du jeu de caractres */
+    /* Conversion du jeu de caractères */
     Cnv_InitConvertContext(&CtxConv,
         (UBYTE *)Label,Sys_StrLen(Label),
         (UBYTE *)Tmp,sizeof(Tmp)-sizeof(char),
@@ -142,16 +142,16 @@ void Cnv_ConvertHostLabelToThomsonLabel(const char *Label, UBYTE *ToLabel)
     Len=Cnv_AnsiToAsciiG2(&CtxConv);
     Tmp[Len]=0;
 
-    /* Rduction du nom */
+    /* Réduction du nom */
     Utl_ConvertHostLabelToThomsonLabel(Tmp,ToLabel);
 }
 
 
 /*****
     Conversion d'un nom de volume Thomson au format ANSI, avec conversion
-    du jeu de caractres accentus.
+    du jeu de caractères accentués.
     - ToLabel: buffer 8 octets contenant le nom
-    - Label: buffers de 9 caractres contenant le nom converti
+    - Label: buffers de 9 caractères contenant le nom converti
 *****/
 
 void Cnv_ConvertThomsonLabelToHostLabel(const UBYTE *ToLabel, char *Label, BOOL IsNormalize)
@@ -160,10 +160,10 @@ void Cnv_ConvertThomsonLabelToHostLabel(const UBYTE *ToLabel, char *Label, BOOL
     char Tmp[33];
     LONG Len;
 
-    /* Gnration du nom sur le host */
+    /* Génération du nom sur le host */
     Utl_ConvertThomsonLabelToHostLabel(ToLabel,Label);
 
-    /* Conversion du jeu de caractres du nom */
+    /* Conversion du jeu de caractères du nom */
     Cnv_InitConvertContext(&CtxConv,
         (UBYTE *)Label,Sys_StrLen(Label),
         (UBYTE *)Tmp,sizeof(Tmp),
@@ -179,12 +179,12 @@ void Cnv_ConvertThomsonLabelToHostLabel(const UBYTE *ToLabel, char *Label, BOOL
 
 /*****
     Conversion d'un commentaire dans le format de commentaire Thomson,
-    avec conversion du jeu de caractres accentus et extraction des metas
+    avec conversion du jeu de caractères accentués et extraction des metas
     informations.
-    - Comment: chane ANSI contenant le commentaire
+    - Comment: chaîne ANSI contenant le commentaire
     - ToComment: buffer de 8 octets pour la destination
-    - Type: pointeur sur un long qui va contenir le type extrait du commentaire Hte (NULL possible)
-    - ExtraData: pointeur sur un long qui va contenir les extradata du commentaire Hte (NULL possible)
+    - Type: pointeur sur un long qui va contenir le type extrait du commentaire Hôte (NULL possible)
+    - ExtraData: pointeur sur un long qui va contenir les extradata du commentaire Hôte (NULL possible)
 *****/
 
 void Cnv_ConvertHostCommentToThomsonComment(const char *Comment, UBYTE *ToComment, LONG *Type, LONG *ExtraData)
@@ -193,7 +193,7 @@ void Cnv_ConvertHostCommentToThomsonComment(const char *Comment, UBYTE *ToCommen
     char Tmp[33];
     LONG Len;
 
-    /* Conversion du jeu de caractres */
+    /* Conversion du jeu de caractères */
     Cnv_InitConvertContext(&CtxConv,
         Comment,Sys_StrLen(Comment),
         (UBYTE *)Tmp,sizeof(Tmp)-sizeof(char),
@@ -206,10 +206,10 @@ void Cnv_ConvertHostCommentToThomsonComment(const char *Comment, UBYTE *ToCommen
 
 
 /*****
-    Conversion d'un commentaire thomson au format de commentaire Hte,
-    avec conversion du jeu de caractres accentus.
+    Conversion d'un commentaire thomson au format de commentaire Hôte,
+    avec conversion du jeu de caractères accentués.
     - ToComment: buffer de 8 octets contenant le commentaire
-    - Comment: buffer de 9 caractres min pour la destination
+    - Comment: buffer de 9 caractères min pour la destination
 *****/
 
 void Cnv_ConvertThomsonCommentToHostComment(const UBYTE *ToComment, char *Comment, BOOL IsNormalize)
@@ -220,7 +220,7 @@ void Cnv_ConvertThomsonCommentToHostComment(const UBYTE *ToComment, char *Commen
 
     Utl_ConvertThomsonCommentToHostComment(ToComment,Comment);
 
-    /* Conversion du jeu de caractres du nom */
+    /* Conversion du jeu de caractères du nom */
     Cnv_InitConvertContext(&CtxConv,
         (UBYTE *)Comment,Sys_StrLen(Comment),
         (UBYTE *)Tmp,sizeof(Tmp)-sizeof(char),
@@ -254,12 +254,12 @@ LONG Cnv_AnsiToAsciiG2(struct ConvertContext *Ctx)
                 else DstPos+=P_Cnv_AnsiToAsciiG2(&Ctx->Dst[DstPos],CurChar);
                 break;
 
-            case 1: /* on est prcd d'un retour chariot */
+            case 1: /* on est précédé d'un retour chariot */
                 if(CurChar=='\n') {Ctx->Dst[DstPos++]='\r'; Ctx->Dst[DstPos++]='\n'; Ctx->State=0;}
                 else if(CurChar!='\r') {DstPos+=P_Cnv_AnsiToAsciiG2(&Ctx->Dst[DstPos],CurChar); Ctx->State=0;}
                 break;
 
-            case 2: /* on est prcd d'un \n */
+            case 2: /* on est précédé d'un \n */
                 Ctx->State=0;
                 Ctx->Dst[DstPos++]='\r';
                 Ctx->Dst[DstPos++]='\n';
@@ -302,7 +302,7 @@ LONG Cnv_AsciiG2ToAnsi(struct ConvertContext *Ctx)
             case 1:
                 switch(CurChar)
                 {
-                    case 0x23: NewChar=''; break;
+                    case 0x23: NewChar='£'; break;
                     case 0x24: NewChar='$'; break;
                     case 0x26: NewChar='#'; break;
                     case 0x27: NewChar=0xa7; break;
@@ -382,16 +382,16 @@ LONG P_Cnv_AnsiToAsciiG2(UBYTE *Buffer, char Char)
 
     static const struct AnsiToAsciiG2 Table[]=
     {
-        {'',  "\101a"}, {'',  "\101e"}, {0xec, "\101i"}, {0xf2, "\101o"}, {'',  "\101u"},
+        {'à',  "\101a"}, {'è',  "\101e"}, {0xec, "\101i"}, {0xf2, "\101o"}, {'ù',  "\101u"},
         {0xc0, "\101A"}, {0xc8, "\101E"}, {0xcc, "\101I"}, {0xd2, "\101O"}, {0xd9, "\101U"},
-        {0xe1, "\102a"}, {'',  "\102e"}, {0xed, "\102i"}, {0xf3, "\102o"}, {0xfa, "\102u"}, {0xfd, "\102y"},
+        {0xe1, "\102a"}, {'é',  "\102e"}, {0xed, "\102i"}, {0xf3, "\102o"}, {0xfa, "\102u"}, {0xfd, "\102y"},
         {0xc1, "\102A"}, {0xc9, "\102E"}, {0xcd, "\102I"}, {0xd3, "\102O"}, {0xda, "\102U"}, {0xdd, "\102Y"},
-        {'',  "\103a"}, {'',  "\103e"}, {'',  "\103i"}, {'',  "\103o"}, {'',  "\103u"},
-        {'',  "\103A"}, {'',  "\103E"}, {'',  "\103I"}, {'',  "\103O"}, {'',  "\103U"},
-        {'',  "\110a"}, {'',  "\110e"}, {'',  "\110i"}, {'',  "\110o"}, {'',  "\110u"}, {'',  "\110y"},
-        {'',  "\110A"}, {'',  "\110E"}, {'',  "\110I"}, {'',  "\110O"}, {'',  "\110U"}, {'',  "\110Y"},
-        {'',  "\113c"}, {0xc7, "\113C"},
-        {'',  "\x23"},  {0xa7, "\x27"},  {0xb1, "\x31"},  {0xf7, "\x38"},  {0xbc, "\x3c"},
+        {'â',  "\103a"}, {'ê',  "\103e"}, {'î',  "\103i"}, {'ô',  "\103o"}, {'û',  "\103u"},
+        {'Â',  "\103A"}, {'Ê',  "\103E"}, {'Î',  "\103I"}, {'Ô',  "\103O"}, {'Û',  "\103U"},
+        {'ä',  "\110a"}, {'ë',  "\110e"}, {'ï',  "\110i"}, {'ö',  "\110o"}, {'ü',  "\110u"}, {'ÿ',  "\110y"},
+        {'Ä',  "\110A"}, {'Ë',  "\110E"}, {'Ï',  "\110I"}, {'Ö',  "\110O"}, {'Ü',  "\110U"}, {'ÿ',  "\110Y"},
+        {'ç',  "\113c"}, {0xc7, "\113C"},
+        {'£',  "\x23"},  {0xa7, "\x27"},  {0xb1, "\x31"},  {0xf7, "\x38"},  {0xbc, "\x3c"},
         {0xbd, "\x3d"},  {0xbe, "\x3e"},  {0xdf, "\x7b"},
         {0,    ""},
     };
@@ -0,0 +1,370 @@
+#include "system.h"
+#include "datalayerfd.h"
+#include "disklayer.h"
+
+#ifdef SYSTEM_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
+/*
+    17-10-2026 (Seg)    Les pistes restent à réécrire tant que leur écriture n'a pas réussi
+    17-10-2026 (Seg)    Gestion des images disque brutes .fd
+*/
+
+
+/***** Prototypes */
+struct DataLayerFd *DFd_Open(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(struct DataLayerFd *, void *), void *, ULONG *);
+void DFd_Close(struct DataLayerFd *);
+BOOL DFd_IsDiskIn(struct DataLayerFd *);
+BOOL DFd_IsProtected(struct DataLayerFd *);
+void DFd_Clean(struct DataLayerFd *);
+BOOL DFd_IsChanged(struct DataLayerFd *);
+void DFd_SetChanged(struct DataLayerFd *, BOOL);
+ULONG DFd_Finalize(struct DataLayerFd *);
+ULONG DFd_FormatTrack(struct DataLayerFd *, ULONG, ULONG, const UBYTE *);
+ULONG DFd_ReadSectors(struct DataLayerFd *, ULONG, ULONG, ULONG, UBYTE *);
+ULONG DFd_WriteSectors(struct DataLayerFd *, ULONG, ULONG, ULONG, const UBYTE *);
+
+ULONG P_DFd_OpenFile(struct DataLayerFd *, const char *);
+ULONG P_DFd_WriteTracks(struct DataLayerFd *, LONG, LONG);
+BOOL P_DFd_IsGeoOk(struct DataLayerFd *, ULONG, ULONG, ULONG);
+
+
+/*****
+    Ouverture d'une image disque .fd.
+    Une image .fd est la copie brute des pistes d'une ou deux faces, les unes à la suite
+    des autres. La face demandée est entièrement accessible en mémoire: projetée par mmap()
+    sous Unix, chargée dans un buffer sous AmigaOS. Les écritures marquent les pistes
+    modifiées, qui sont reportées dans le fichier par DFd_Finalize().
+    * Paramètres:
+      FileName: nom du fichier image
+      Flags: non utilisé
+      Unit: non utilisé
+      Side: numéro de la face à utiliser dans l'image
+      CountOfTracks: nombre de pistes par face
+      SectorPerTrack: pour indiquer le nombre de secteurs par piste
+      SectorSize: pour indiquer la taille d'un secteur
+      IntFuncPtr: non utilisé (pas de changement de disque possible)
+      IntData: non utilisé
+      ErrorCode: pointeur vers un ULONG pour retourner un code d'erreur ou DL_SUCCESS
+    * Retourne:
+      - NULL si échec
+      - pointeur vers une structure DataLayerFd si succès
+*****/
+
+struct DataLayerFd *DFd_Open(const char *FileName, ULONG Flags, ULONG Unit, ULONG Side, LONG CountOfTracks, LONG SectorPerTrack, LONG SectorSize, void (*IntFuncPtr)(struct DataLayerFd *, void *), void *IntData, ULONG *ErrorCode)
+{
+    struct DataLayerFd *DLayer=(struct DataLayerFd *)Sys_AllocMem(sizeof(struct DataLayerFd));
+
+    *ErrorCode=DL_NOT_ENOUGH_MEMORY;
+    if(DLayer!=NULL)
+    {
+#ifdef SYSTEM_UNIX
+        DLayer->FileDesc=-1;
+#endif
+        DLayer->TrackSize=SectorPerTrack*SectorSize;
+        DLayer->SectorSize=SectorSize;
+        DLayer->CountOfTracks=CountOfTracks;
+        DLayer->FaceSize=DLayer->TrackSize*CountOfTracks;
+        DLayer->FaceOffset=DLayer->FaceSize*(LONG)Side;
+        DLayer->IsChanged=FALSE;
+
+        if((DLayer->DirtyTrackPtr=(UBYTE *)Sys_AllocMem(CountOfTracks))!=NULL)
+        {
+            *ErrorCode=P_DFd_OpenFile(DLayer,FileName);
+        }
+
+        if(*ErrorCode!=DL_SUCCESS)
+        {
+            DFd_Close(DLayer);
+            DLayer=NULL;
+        }
+    }
+
+    return DLayer;
+}
+
+
+/*****
+    Libération des ressources allouées par DFd_Open().
+    Les pistes encore modifiées sont reportées dans le fichier.
+*****/
+
+void DFd_Close(struct DataLayerFd *DLayer)
+{
+    if(DLayer!=NULL)
+    {
+        if(DLayer->FacePtr!=NULL) DFd_Finalize(DLayer);
+#ifdef SYSTEM_AMIGA
+        if(DLayer->FileHandle) Close(DLayer->FileHandle);
+        Sys_FreeMem((void *)DLayer->FacePtr);
+#endif
+#ifdef SYSTEM_UNIX
+        if(DLayer->MapPtr!=NULL) munmap((void *)DLayer->MapPtr,DLayer->MapSize);
+        if(DLayer->FileDesc>=0) close(DLayer->FileDesc);
+#endif
+        Sys_FreeMem((void *)DLayer->DirtyTrackPtr);
+        Sys_FreeMem((void *)DLayer);
+    }
+}
+
+
+/*****
+    Pour vérifier si un disque est présent (toujours vrai pour une image)
+*****/
+
+BOOL DFd_IsDiskIn(struct DataLayerFd *DLayer)
+{
+    return TRUE;
+}
+
+
+/*****
+    Pour vérifier si l'image est protégée en écriture
+*****/
+
+BOOL DFd_IsProtected(struct DataLayerFd *DLayer)
+{
+    return DLayer->IsProtected;
+}
+
+
+/*****
+    Nettoyage des caches (rien à faire pour une image)
+*****/
+
+void DFd_Clean(struct DataLayerFd *DLayer)
+{
+}
+
+
+/*****
+    Test si le disque a changé
+*****/
+
+BOOL DFd_IsChanged(struct DataLayerFd *DLayer)
+{
+    return DLayer->IsChanged;
+}
+
+
+/*****
+    Pour changer le flag de changement de disque
+*****/
+
+void DFd_SetChanged(struct DataLayerFd *DLayer, BOOL IsChanged)
+{
+    DLayer->IsChanged=IsChanged;
+}
+
+
+/*****
+    Report dans le fichier des pistes modifiées.
+    Les pistes modifiées consécutives sont écrites en une seule fois. Une piste n'est
+    marquée comme écrite qu'après le succès de son écriture: en cas d'échec, elle sera
+    réécrite lors du prochain appel.
+*****/
+
+ULONG DFd_Finalize(struct DataLayerFd *DLayer)
+{
+    ULONG ErrorCode=DL_SUCCESS;
+    LONG Track=0;
+
+    while(Track<DLayer->CountOfTracks && !ErrorCode)
+    {
+        if(DLayer->DirtyTrackPtr[Track])
+        {
+            LONG FirstTrack=Track;
+
+            while(Track<DLayer->CountOfTracks && DLayer->DirtyTrackPtr[Track]) Track++;
+            ErrorCode=P_DFd_WriteTracks(DLayer,FirstTrack,Track-FirstTrack);
+            if(!ErrorCode) while(FirstTrack<Track) DLayer->DirtyTrackPtr[FirstTrack++]=0;
+        }
+        else Track++;
+    }
+
+    return ErrorCode;
+}
+
+
+/*****
+    Formatage d'une piste: les données de la piste sont simplement remplacées
+    * Paramètres:
+      DLayer: structure allouée par DFd_Open()
+      Track: piste à formater
+      Interleave: non utilisé
+      BufferPtr: pointeur vers les données qui vont servir initialiser la piste.
+        Ce buffer doit avoir pour taille le nombre d'octets par secteur multiplié
+        par le nombre de secteurs par piste.
+    * Retourne:
+      Code d'erreur ou DL_SUCCESS
+*****/
+
+ULONG DFd_FormatTrack(struct DataLayerFd *DLayer, ULONG Track, ULONG Interleave, const UBYTE *BufferPtr)
+{
+    return DFd_WriteSectors(DLayer,Track,1,(ULONG)(DLayer->TrackSize/DLayer->SectorSize),BufferPtr);
+}
+
+
+/*****
+    Lecture de plusieurs secteurs consécutifs d'une piste
+    * Paramètres:
+      DLayer: structure allouée par DFd_Open()
+      Track: numéro de piste à lire
+      Sector: numéro du premier secteur de la piste à lire
+      Count: nombre de secteurs à lire
+      BufferPtr: récipiant pour recevoir les secteurs lus
+    * Retourne:
+      Code d'erreur ou DL_SUCCESS
+*****/
+
+ULONG DFd_ReadSectors(struct DataLayerFd *DLayer, ULONG Track, ULONG Sector, ULONG Count, UBYTE *BufferPtr)
+{
+    if(!P_DFd_IsGeoOk(DLayer,Track,Sector,Count)) return DL_SECTOR_GEO;
+
+    Sys_MemCopy(BufferPtr,&DLayer->FacePtr[Track*DLayer->TrackSize+DLayer->SectorSize*(Sector-1)],DLayer->SectorSize*Count);
+
+    return DL_SUCCESS;
+}
+
+
+/*****
+    Ecriture de plusieurs secteurs consécutifs d'une piste.
+    Les données sont recopiées dans l'image en mémoire, et la piste est marquée
+    pour être écrite par DFd_Finalize().
+    * Paramètres:
+      DLayer: structure allouée par DFd_Open()
+      Track: numéro de piste à écrire
+      Sector: numéro du premier secteur de la piste à écrire
+      Count: nombre de secteurs à écrire
+      BufferPtr: pointeur vers les données des secteurs à écrire
+    * Retourne:
+      Code d'erreur ou DL_SUCCESS
+*****/
+
+ULONG DFd_WriteSectors(struct DataLayerFd *DLayer, ULONG Track, ULONG Sector, ULONG Count, const UBYTE *BufferPtr)
+{
+    if(DLayer->IsProtected) return DL_PROTECTED;
+    if(!P_DFd_IsGeoOk(DLayer,Track,Sector,Count)) return DL_SECTOR_GEO;
+
+    Sys_MemCopy(&DLayer->FacePtr[Track*DLayer->TrackSize+DLayer->SectorSize*(Sector-1)],(void *)BufferPtr,DLayer->SectorSize*Count);
+    DLayer->DirtyTrackPtr[Track]=1;
+
+    return DL_SUCCESS;
+}
+
+
+/*****
+    Ouverture du fichier image et accès à la face demandée.
+    Le fichier est ouvert en lecture seule s'il est protégé en écriture.
+*****/
+
+ULONG P_DFd_OpenFile(struct DataLayerFd *DLayer, const char *FileName)
+{
+    ULONG ErrorCode=DL_OPEN_FILE;
+#ifdef SYSTEM_AMIGA
+    struct FileInfoBlock *FibPtr;
+
+    if((FibPtr=(struct FileInfoBlock *)Sys_AllocMem(sizeof(struct FileInfoBlock)))==NULL) return DL_NOT_ENOUGH_MEMORY;
+
+    if((DLayer->FileHandle=Open((STRPTR)FileName,MODE_OLDFILE))!=0)
+    {
+        if(ExamineFH(DLayer->FileHandle,FibPtr))
+        {
+            /* Les bits de protection sont actifs à 0 */
+            DLayer->IsProtected=(FibPtr->fib_Protection&FIBF_WRITE)?TRUE:FALSE;
+
+            /* La face 1 n'existe que si l'image contient deux faces */
+            ErrorCode=DL_UNIT_ACCESS;
+            if(FibPtr->fib_Size>=DLayer->FaceOffset+DLayer->FaceSize)
+            {
+                ErrorCode=DL_NOT_ENOUGH_MEMORY;
+                if((DLayer->FacePtr=(UBYTE *)Sys_AllocMem(DLayer->FaceSize))!=NULL)
+                {
+                    ErrorCode=DL_READ_FILE;
+                    if(Seek(DLayer->FileHandle,DLayer->FaceOffset,OFFSET_BEGINNING)>=0)
+                    {
+                        if(Read(DLayer->FileHandle,(APTR)DLayer->FacePtr,DLayer->FaceSize)==DLayer->FaceSize) ErrorCode=DL_SUCCESS;
+                    }
+                }
+            }
+        }
+    }
+
+    Sys_FreeMem((void *)FibPtr);
+#endif
+#ifdef SYSTEM_UNIX
+    struct stat Stat;
+
+    DLayer->IsProtected=FALSE;
+    if((DLayer->FileDesc=open(FileName,O_RDWR))<0)
+    {
+        DLayer->IsProtected=TRUE;
+        DLayer->FileDesc=open(FileName,O_RDONLY);
+    }
+
+    if(DLayer->FileDesc>=0 && !fstat(DLayer->FileDesc,&Stat))
+    {
+        /* La face 1 n'existe que si l'image contient deux faces */
+        ErrorCode=DL_UNIT_ACCESS;
+        if((LONG)Stat.st_size>=DLayer->FaceOffset+DLayer->FaceSize)
+        {
+            void *MapPtr;
+
+            ErrorCode=DL_READ_FILE;
+            DLayer->MapSize=(LONG)Stat.st_size;
+            MapPtr=mmap(NULL,DLayer->MapSize,DLayer->IsProtected?PROT_READ:PROT_READ|PROT_WRITE,MAP_SHARED,DLayer->FileDesc,0);
+            if(MapPtr!=MAP_FAILED)
+            {
+                DLayer->MapPtr=(UBYTE *)MapPtr;
+                DLayer->FacePtr=&DLayer->MapPtr[DLayer->FaceOffset];
+                ErrorCode=DL_SUCCESS;
+            }
+        }
+    }
+#endif
+    return ErrorCode;
+}
+
+
+/*****
+    Ecriture dans le fichier d'une suite de pistes consécutives
+*****/
+
+ULONG P_DFd_WriteTracks(struct DataLayerFd *DLayer, LONG FirstTrack, LONG CountOfTracks)
+{
+    ULONG ErrorCode=DL_WRITE_FILE;
+    LONG Offset=FirstTrack*DLayer->TrackSize;
+    LONG Size=CountOfTracks*DLayer->TrackSize;
+#ifdef SYSTEM_AMIGA
+    if(Seek(DLayer->FileHandle,DLayer->FaceOffset+Offset,OFFSET_BEGINNING)>=0)
+    {
+        if(Write(DLayer->FileHandle,(APTR)&DLayer->FacePtr[Offset],Size)==Size) ErrorCode=DL_SUCCESS;
+    }
+#endif
+#ifdef SYSTEM_UNIX
+    /* msync() demande une adresse alignée sur une page */
+    LONG PageSize=(LONG)sysconf(_SC_PAGESIZE);
+    LONG Start=(DLayer->FaceOffset+Offset)/PageSize*PageSize;
+
+    if(!msync((void *)&DLayer->MapPtr[Start],DLayer->FaceOffset+Offset+Size-Start,MS_SYNC)) ErrorCode=DL_SUCCESS;
+#endif
+    return ErrorCode;
+}
+
+
+/*****
+    Vérifie que les secteurs demandés sont dans la géométrie de l'image
+*****/
+
+BOOL P_DFd_IsGeoOk(struct DataLayerFd *DLayer, ULONG Track, ULONG Sector, ULONG Count)
+{
+    if((LONG)Track>=DLayer->CountOfTracks || Sector<1) return FALSE;
+    if((LONG)((Sector-1+Count)*DLayer->SectorSize)>DLayer->TrackSize) return FALSE;
+
+    return TRUE;
+}
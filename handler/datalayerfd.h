@@ -0,0 +1,42 @@
+#ifndef DATALAYERFD_H
+#define DATALAYERFD_H
+
+struct DataLayerFd
+{
+#ifdef SYSTEM_AMIGA
+    BPTR FileHandle;
+#endif
+#ifdef SYSTEM_UNIX
+    int FileDesc;
+    UBYTE *MapPtr;
+    LONG MapSize;
+#endif
+    UBYTE *FacePtr;         /* Image de la face en mémoire */
+    UBYTE *DirtyTrackPtr;   /* Un octet par piste, non nul si la piste est à réécrire */
+    LONG FaceOffset;
+    LONG FaceSize;
+    LONG TrackSize;
+    LONG SectorSize;
+    LONG CountOfTracks;
+    BOOL IsProtected;
+    BOOL IsChanged;
+};
+
+
+/***** VARIABLES ET FONCTIONS    *****/
+/***** PUBLIQUES UTILISABLES PAR *****/
+/***** D'AUTRES BLOCS DU PROJET  *****/
+
+extern struct DataLayerFd *DFd_Open(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(struct DataLayerFd *, void *), void *, ULONG *);
+extern void DFd_Close(struct DataLayerFd *);
+extern BOOL DFd_IsDiskIn(struct DataLayerFd *);
+extern BOOL DFd_IsProtected(struct DataLayerFd *);
+extern void DFd_Clean(struct DataLayerFd *);
+extern BOOL DFd_IsChanged(struct DataLayerFd *);
+extern void DFd_SetChanged(struct DataLayerFd *, BOOL);
+extern ULONG DFd_Finalize(struct DataLayerFd *);
+extern ULONG DFd_FormatTrack(struct DataLayerFd *, ULONG, ULONG, const UBYTE *);
+extern ULONG DFd_ReadSectors(struct DataLayerFd *, ULONG, ULONG, ULONG, UBYTE *);
+extern ULONG DFd_WriteSectors(struct DataLayerFd *, ULONG, ULONG, ULONG, const UBYTE *);
+
+#endif  /* DATALAYERFD_H */
@@ -8,29 +8,62 @@
 #endif
 
 /*
+    17-10-2026 (Seg)    Si le device refuse TO_MAKEFMTINTERLEAVE, une piste complète est
+                        écrite par CMD_WRITE au lieu d'être reformatée
+    17-10-2026 (Seg)    Une piste complète, ou une suite lue en moins d'un tour, reste traitée
+                        en une seule requête malgré l'entrelacement
+    17-10-2026 (Seg)    Ajout de DFlp_Sync() pour attendre la fin des écritures différées,
+                        pas de lecture anticipée au-delà de la dernière piste
+    17-10-2026 (Seg)    Ecriture d'une piste complète en une seule requête
+    17-10-2026 (Seg)    Ajout de DFlp_MotorOff(), DFlp_Finalize() n'arrête plus le moteur
+    17-10-2026 (Seg)    Lectures et écritures multi-secteurs dans l'ordre physique de la piste
+    17-10-2026 (Seg)    Ajout de DFlp_IsChanged() et DFlp_SetChanged() pour la table de fonctions
+    17-10-2026 (Seg)    Entrées/sorties asynchrones: lecture anticipée de la piste suivante
+                        et écritures différées via un pool de requêtes
+    17-10-2026 (Seg)    DFlp_ReadTrack() remplacée par DFlp_ReadSectors() et DFlp_WriteSectors()
+    17-10-2026 (Seg)    Ajout de la lecture d'une piste complète
     03-10-2020 (Seg)    On change la gestion des secteurs. La localisation des faces
-                        est maintenant gr par les flags du device.
+                        est maintenant géréé par les flags du device.
     10-09-2020 (Seg)    Refonte de la couche de la commande todisk pour le handler
-    27-08-2018 (Seg)    Gestion des paramtres gomtriques du file system
-    23-09-2013 (Seg)    Adaptation du code suite  la migration sous Unix
+    27-08-2018 (Seg)    Gestion des paramètres géométriques du file system
+    23-09-2013 (Seg)    Adaptation du code suite à la migration sous Unix
     25-12-2008 (Seg)    Ajout du formatage de piste
     22-12-2008 (Seg)    Gestion du floppy disk
 */
 
 
 /***** Prototypes */
-struct DataLayerFloppy *DFlp_Open(const char *, ULONG, ULONG, ULONG, LONG, LONG, void (*)(struct DataLayerFloppy *, void *), void *, ULONG *);
+struct DataLayerFloppy *DFlp_Open(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(struct DataLayerFloppy *, void *), void *, ULONG *);
 void DFlp_Close(struct DataLayerFloppy *);
 BOOL DFlp_IsDiskIn(struct DataLayerFloppy *);
 BOOL DFlp_IsProtected(struct DataLayerFloppy *);
 void DFlp_Clean(struct DataLayerFloppy *);
+BOOL DFlp_IsChanged(struct DataLayerFloppy *);
+void DFlp_SetChanged(struct DataLayerFloppy *, BOOL);
+void DFlp_MotorOff(struct DataLayerFloppy *);
+ULONG DFlp_Sync(struct DataLayerFloppy *);
 ULONG DFlp_Finalize(struct DataLayerFloppy *);
 ULONG DFlp_FormatTrack(struct DataLayerFloppy *, ULONG, ULONG, const UBYTE *);
+ULONG DFlp_ReadSectors(struct DataLayerFloppy *, ULONG, ULONG, ULONG, UBYTE *);
+ULONG DFlp_WriteSectors(struct DataLayerFloppy *, ULONG, ULONG, ULONG, const UBYTE *);
 ULONG DFlp_ReadSector(struct DataLayerFloppy *, ULONG, ULONG, UBYTE *);
 ULONG DFlp_WriteSector(struct DataLayerFloppy *, ULONG, ULONG, const UBYTE *);
 
 #ifdef SYSTEM_AMIGA
-ULONG P_DFlp_GetError(struct DataLayerFloppy *);
+ULONG P_DFlp_GetError(struct IOExtTD *);
+void P_DFlp_WaitRequest(struct DataLayerFloppy *, struct DataLayerFloppyRequest *);
+void P_DFlp_WaitAll(struct DataLayerFloppy *);
+void P_DFlp_CancelReads(struct DataLayerFloppy *, LONG);
+struct DataLayerFloppyRequest *P_DFlp_FindRead(struct DataLayerFloppy *, LONG);
+struct DataLayerFloppyRequest *P_DFlp_GetFreeRequest(struct DataLayerFloppy *, BOOL);
+void P_DFlp_SendRead(struct DataLayerFloppy *, LONG);
+ULONG P_DFlp_TakeDeferredError(struct DataLayerFloppy *);
+LONG P_DFlp_GetInterleave(struct DataLayerFloppy *, ULONG);
+BOOL P_DFlp_IsScattered(struct DataLayerFloppy *, ULONG, ULONG);
+void P_DFlp_ForgetInterleaves(struct DataLayerFloppy *);
+ULONG P_DFlp_ReadOrdered(struct DataLayerFloppy *, ULONG, ULONG, ULONG, UBYTE *);
+ULONG P_DFlp_SendWrite(struct DataLayerFloppy *, ULONG, ULONG, ULONG, const UBYTE *);
+ULONG P_DFlp_SendTrack(struct DataLayerFloppy *, ULONG, const UBYTE *);
 BYTE P_DFlp_SetMotorState(struct DataLayerFloppy *, ULONG);
 BOOL P_DFlp_IsFatalError(ULONG);
 BOOL P_DFlp_CheckDiskChanged(struct DataLayerFloppy *);
@@ -43,22 +76,23 @@ void __asm P_DFlp_InterruptFunc(register __a1 struct DataLayerFloppy *);
 /*****
     Allocation des ressources necessaires pour la lecture/ecriture
     du lecteur de disquette.
-    * Paramtres:
-      DeviceName: nom du device  utiliser
-      Flags: flags  passer au device lors de son ouverture
-      Unit: unit du device  ouvrir
+    * Paramètres:
+      DeviceName: nom du device à utiliser
+      Flags: flags à passer au device lors de son ouverture
+      Unit: unité du device à ouvrir
       Side: facultatif dans le cas de l'utilisation du device
+      CountOfTracks: nombre de pistes, pour mémoriser l'entrelacement de chaque piste
       SectorPerTrack: pour indiquer le nombre de secteurs par piste
       SectorSize: pour indiquer la taille d'un secteyur
-      IntFuncPtr: pointeur vers une fonction callback pour savoir si un disque vient d'tre insr ou retir
-      IntData: pointeur vers une structure utilisateur  passer lors de l'utilisation du callback
+      IntFuncPtr: pointeur vers une fonction callback pour savoir si un disque vient d'être inséré ou retiré
+      IntData: pointeur vers une structure utilisateur à passer lors de l'utilisation du callback
       ErrorCode: pointeur vers un ULONG pour retourner un code d'erreur ou DL_SUCCESS
     * Retourne:
-      - NULL si chec
-      - pointeur vers une structure DataLayerFloppy si succs
+      - NULL si échec
+      - pointeur vers une structure DataLayerFloppy si succès
 *****/
 
-struct DataLayerFloppy *DFlp_Open(const char *DeviceName, ULONG Flags, ULONG Unit, ULONG Side, LONG SectorPerTrack, LONG SectorSize, void (*IntFuncPtr)(struct DataLayerFloppy *, void *), void *IntData, ULONG *ErrorCode)
+struct DataLayerFloppy *DFlp_Open(const char *DeviceName, ULONG Flags, ULONG Unit, ULONG Side, LONG CountOfTracks, LONG SectorPerTrack, LONG SectorSize, void (*IntFuncPtr)(struct DataLayerFloppy *, void *), void *IntData, ULONG *ErrorCode)
 {
     struct DataLayerFloppy *DLayer=(struct DataLayerFloppy *)Sys_AllocMem(sizeof(struct DataLayerFloppy));
 
@@ -69,7 +103,9 @@ struct DataLayerFloppy *DFlp_Open(const char *DeviceName, ULONG Flags, ULONG Uni
         DLayer->Side=Side;
         DLayer->TrackSize=SectorPerTrack*SectorSize;
         DLayer->SectorSize=SectorSize;
+        DLayer->CountOfTracks=CountOfTracks;
         DLayer->IsChanged=FALSE;
+        DLayer->IsFmtInterleave=TRUE;
 #ifdef SYSTEM_AMIGA
         if((DLayer->DiskPort=CreatePort(NULL,NULL))!=NULL)
         {
@@ -80,11 +116,35 @@ struct DataLayerFloppy *DFlp_Open(const char *DeviceName, ULONG Flags, ULONG Uni
                     *ErrorCode=DL_OPEN_DEVICE;
                     if(!OpenDevice((STRPTR)DeviceName,Unit,(struct IORequest *)DLayer->DiskExtIO,Flags))
                     {
+                        LONG i;
+
                         DLayer->IntFuncPtr=IntFuncPtr;
                         DLayer->IntData=IntData;
                         P_DFlp_AddInterrupt(DLayer);
                         DLayer->Device=TRUE;
                         *ErrorCode=DL_SUCCESS;
+
+                        /* Allocation des requêtes asynchrones, avec un buffer d'une piste chacune */
+                        for(i=0; i<DFLP_COUNTOF_REQUEST && *ErrorCode==DL_SUCCESS; i++)
+                        {
+                            struct DataLayerFloppyRequest *ReqPtr=&DLayer->Request[i];
+
+                            *ErrorCode=DL_NOT_ENOUGH_MEMORY;
+                            if((ReqPtr->IoReq=(struct IOExtTD *)CreateExtIO(DLayer->DiskPort,sizeof(struct IOExtTD)))!=NULL)
+                            {
+                                if((ReqPtr->BufferPtr=(UBYTE *)Sys_AllocMem(DLayer->TrackSize))!=NULL)
+                                {
+                                    ReqPtr->IoReq->iotd_Req.io_Device=DLayer->DiskExtIO->iotd_Req.io_Device;
+                                    ReqPtr->IoReq->iotd_Req.io_Unit=DLayer->DiskExtIO->iotd_Req.io_Unit;
+                                    *ErrorCode=DL_SUCCESS;
+                                }
+                            }
+                        }
+
+                        if(*ErrorCode==DL_SUCCESS && (DLayer->InterleaveTablePtr=(UBYTE *)Sys_AllocMem(CountOfTracks))==NULL)
+                        {
+                            *ErrorCode=DL_NOT_ENOUGH_MEMORY;
+                        }
                     }
                 }
             }
@@ -110,12 +170,22 @@ void DFlp_Close(struct DataLayerFloppy *DLayer)
     if(DLayer!=NULL)
     {
 #ifdef SYSTEM_AMIGA
+        LONG i;
+
         if(DLayer->Device)
         {
+            P_DFlp_CancelReads(DLayer,-1);
+            P_DFlp_WaitAll(DLayer);
             P_DFlp_SetMotorState(DLayer,MOTOR_OFF);
             P_DFlp_RemInterrupt(DLayer);
             CloseDevice((struct IORequest *)DLayer->DiskExtIO);
         }
+        for(i=0; i<DFLP_COUNTOF_REQUEST; i++)
+        {
+            if(DLayer->Request[i].IoReq!=NULL) DeleteExtIO((struct IORequest *)DLayer->Request[i].IoReq);
+            Sys_FreeMem((void *)DLayer->Request[i].BufferPtr);
+        }
+        Sys_FreeMem((void *)DLayer->InterleaveTablePtr);
         if(DLayer->IntExtIO!=NULL) DeleteExtIO((struct IORequest *)DLayer->IntExtIO);
         if(DLayer->DiskExtIO!=NULL) DeleteExtIO((struct IORequest *)DLayer->DiskExtIO);
         if(DLayer->DiskPort!=NULL) DeletePort(DLayer->DiskPort);
@@ -126,7 +196,7 @@ void DFlp_Close(struct DataLayerFloppy *DLayer)
 
 
 /*****
-    Pour vrifier si un disque est prsent
+    Pour vérifier si un disque est présent
 *****/
 
 BOOL DFlp_IsDiskIn(struct DataLayerFloppy *DLayer)
@@ -145,7 +215,7 @@ BOOL DFlp_IsDiskIn(struct DataLayerFloppy *DLayer)
 
 
 /*****
-    Pour vrifier si le disque est protg
+    Pour vérifier si le disque est protégé
 *****/
 
 BOOL DFlp_IsProtected(struct DataLayerFloppy *DLayer)
@@ -164,7 +234,7 @@ BOOL DFlp_IsProtected(struct DataLayerFloppy *DLayer)
 
 
 /*****
-    Nettoyage des caches (suite  une insertion de disquette par exemple)
+    Nettoyage des caches (suite à une insertion de disquette par exemple)
 *****/
 
 void DFlp_Clean(struct DataLayerFloppy *DLayer)
@@ -172,6 +242,12 @@ void DFlp_Clean(struct DataLayerFloppy *DLayer)
 #ifdef SYSTEM_AMIGA
     struct IOExtTD *IoReq=DLayer->DiskExtIO;
 
+    /* Les données anticipées et les erreurs différées concernent l'ancien disque */
+    P_DFlp_CancelReads(DLayer,-1);
+    P_DFlp_WaitAll(DLayer);
+    DLayer->DeferredError=DL_SUCCESS;
+    P_DFlp_ForgetInterleaves(DLayer);
+
     IoReq->iotd_Req.io_Command=ETD_CLEAR;
     IoReq->iotd_Req.io_Flags=0;
     DoIO((struct IORequest *)IoReq); /* ETD_CLEAR */
@@ -179,9 +255,61 @@ void DFlp_Clean(struct DataLayerFloppy *DLayer)
 }
 
 
+/*****
+    Test si le disque a changé
+*****/
+
+BOOL DFlp_IsChanged(struct DataLayerFloppy *DLayer)
+{
+    return DLayer->IsChanged;
+}
+
+
+/*****
+    Pour changer le flag de changement de disque
+*****/
+
+void DFlp_SetChanged(struct DataLayerFloppy *DLayer, BOOL IsChanged)
+{
+    DLayer->IsChanged=IsChanged;
+}
+
+
+/*****
+    Arrêt du moteur.
+    Les lectures anticipées sont annulées pour qu'elles ne le relancent pas.
+*****/
+
+void DFlp_MotorOff(struct DataLayerFloppy *DLayer)
+{
+#ifdef SYSTEM_AMIGA
+    P_DFlp_CancelReads(DLayer,-1);
+    P_DFlp_WaitAll(DLayer);
+    P_DFlp_SetMotorState(DLayer,MOTOR_OFF);
+#endif
+}
+
+
+/*****
+    Attente de la fin des écritures différées.
+    * Retourne:
+      Code d'erreur de la première écriture en échec, ou DL_SUCCESS
+*****/
+
+ULONG DFlp_Sync(struct DataLayerFloppy *DLayer)
+{
+    ULONG ErrorCode=DL_SUCCESS;
+#ifdef SYSTEM_AMIGA
+    P_DFlp_WaitAll(DLayer);
+    ErrorCode=P_DFlp_TakeDeferredError(DLayer);
+#endif
+    return ErrorCode;
+}
+
+
 /*****
     Permet de terminer les operations en cache, avant de fermer
-    le DataLayer.
+    le DataLayer. Le moteur reste allumé (voir DFlp_MotorOff()).
 *****/
 
 ULONG DFlp_Finalize(struct DataLayerFloppy *DLayer)
@@ -190,13 +318,16 @@ ULONG DFlp_Finalize(struct DataLayerFloppy *DLayer)
 #ifdef SYSTEM_AMIGA
     struct IOExtTD *IoReq=DLayer->DiskExtIO;
 
+    /* On attend la fin des écritures en cours */
+    P_DFlp_CancelReads(DLayer,-1);
+    P_DFlp_WaitAll(DLayer);
+
     IoReq->iotd_Req.io_Flags=0;
     IoReq->iotd_Req.io_Command=CMD_UPDATE;
     DoIO((struct IORequest *)IoReq); /* on nettoie le cache */
 
-    ErrorCode=P_DFlp_GetError(DLayer);
-
-    P_DFlp_SetMotorState(DLayer,MOTOR_OFF);
+    ErrorCode=P_DFlp_TakeDeferredError(DLayer);
+    if(!ErrorCode) ErrorCode=P_DFlp_GetError(IoReq);
 #endif
     return ErrorCode;
 }
@@ -204,13 +335,13 @@ ULONG DFlp_Finalize(struct DataLayerFloppy *DLayer)
 
 /*****
     Formatage d'une piste
-    * Paramtres:
-      DLayer: structure alloue par DFlp_Open()
-      Track: piste  formater
-      Interleave: numro d'entrelacement des secteurs de la piste (passer 7 comme valeur par dfaut)
-      BufferPtr: pointeur vers les donnes qui vont servir initialiser la piste.
+    * Paramètres:
+      DLayer: structure allouée par DFlp_Open()
+      Track: piste à formater
+      Interleave: numéro d'entrelacement des secteurs de la piste (passer 7 comme valeur par défaut)
+      BufferPtr: pointeur vers les données qui vont servir initialiser la piste.
         Ce buffer doit avoir pour taille le nombre d'octets par secteur (soit 256 en principe),
-        multipli par le nombre de secteurs par piste (soit 16 en principe).
+        multiplié par le nombre de secteurs par piste (soit 16 en principe).
     * Retourne:
       Code d'erreur ou DL_SUCCESS
 *****/
@@ -221,9 +352,13 @@ ULONG DFlp_FormatTrack(struct DataLayerFloppy *DLayer, ULONG Track, ULONG Interl
 #ifdef SYSTEM_AMIGA
     struct IOExtTD *IoReq=DLayer->DiskExtIO;
 
+    P_DFlp_CancelReads(DLayer,-1);
+    P_DFlp_WaitAll(DLayer);
+
     IoReq->iotd_Req.io_Length=Interleave;
     IoReq->iotd_Req.io_Command=TO_MAKEFMTINTERLEAVE;
     DoIO((struct IORequest *)IoReq);
+    if(IoReq->iotd_Req.io_Error) DLayer->IsFmtInterleave=FALSE;
 
     IoReq->iotd_Req.io_Offset=Track*DLayer->TrackSize;
     IoReq->iotd_Req.io_Flags=0;
@@ -232,84 +367,172 @@ ULONG DFlp_FormatTrack(struct DataLayerFloppy *DLayer, ULONG Track, ULONG Interl
     IoReq->iotd_Req.io_Command=TD_FORMAT;
     DoIO((struct IORequest *)IoReq);
 
-    ErrorCode=P_DFlp_GetError(DLayer);
+    /* Sans TO_MAKEFMTINTERLEAVE, l'entrelacement réel de la piste n'est pas celui demandé */
+    ErrorCode=P_DFlp_GetError(IoReq);
+    if(!ErrorCode && (LONG)Track<DLayer->CountOfTracks) DLayer->InterleaveTablePtr[Track]=DLayer->IsFmtInterleave?(UBYTE)Interleave:0;
 #endif
     return ErrorCode;
 }
 
 
 /*****
-    Lecture d'un secteur
-    * Paramtres:
-      DLayer: structure alloue par DFlp_Open()
-      Track: numro de piste  lire
-      Sector: numro du secteur de la piste  lire
-      BufferPtr: rcipiant pour recevoir le secteur lu
+    Lecture de plusieurs secteurs consécutifs d'une piste.
+    Les secteurs sont lus en une seule requête, sauf si l'entrelacement les disperse sur
+    plusieurs tours (voir P_DFlp_IsScattered()): ils sont alors lus un par un dans l'ordre
+    où ils passent sous la tête.
+    Si la piste a été lue par anticipation, les secteurs sont copiés depuis le buffer de
+    la requête asynchrone. Après la lecture d'une piste complète, la lecture de la piste
+    suivante, s'il y en a une, est lancée en tâche de fond.
+    Une erreur survenue lors d'une écriture différée est retournée ici.
+    * Paramètres:
+      DLayer: structure allouée par DFlp_Open()
+      Track: numéro de piste à lire
+      Sector: numéro du premier secteur de la piste à lire
+      Count: nombre de secteurs à lire
+      BufferPtr: récipiant pour recevoir les secteurs lus. Ce buffer doit avoir pour taille
+        le nombre d'octets par secteur multiplié par le nombre de secteurs à lire.
     * Retourne:
       Code d'erreur ou DL_SUCCESS
 *****/
 
-ULONG DFlp_ReadSector(struct DataLayerFloppy *DLayer, ULONG Track, ULONG Sector, UBYTE *BufferPtr)
+ULONG DFlp_ReadSectors(struct DataLayerFloppy *DLayer, ULONG Track, ULONG Sector, ULONG Count, UBYTE *BufferPtr)
 {
     ULONG ErrorCode=DL_SUCCESS;
 #ifdef SYSTEM_AMIGA
     struct IOExtTD *IoReq=DLayer->DiskExtIO;
+    struct DataLayerFloppyRequest *ReqPtr;
+    BOOL IsFullTrack=(LONG)(DLayer->SectorSize*Count)>=DLayer->TrackSize?TRUE:FALSE;
 
     P_DFlp_CheckDiskChanged(DLayer);
-    IoReq->iotd_Req.io_Offset=Track*DLayer->TrackSize+DLayer->SectorSize*(Sector-1);
-    IoReq->iotd_Req.io_Flags=0;
-    IoReq->iotd_Req.io_Length=DLayer->SectorSize;
-    IoReq->iotd_Req.io_Data=BufferPtr;
-    IoReq->iotd_Req.io_Command=CMD_READ;
-    DoIO((struct IORequest *)IoReq);
+    if((ErrorCode=P_DFlp_TakeDeferredError(DLayer))!=DL_SUCCESS) return ErrorCode;
 
-    ErrorCode=P_DFlp_GetError(DLayer);
+    /* La piste a-t-elle été lue par anticipation? */
+    if((ReqPtr=P_DFlp_FindRead(DLayer,(LONG)Track))!=NULL)
+    {
+        P_DFlp_WaitRequest(DLayer,ReqPtr);
+        if(!ReqPtr->Error)
+        {
+            Sys_MemCopy(BufferPtr,&ReqPtr->BufferPtr[DLayer->SectorSize*(Sector-1)],DLayer->SectorSize*Count);
+            if(IsFullTrack && (LONG)Track+1<DLayer->CountOfTracks) P_DFlp_SendRead(DLayer,(LONG)Track+1);
+            return DL_SUCCESS;
+        }
+
+        /* En cas d'erreur, on refait la lecture de manière synchrone */
+        ReqPtr->Type=DFLP_REQ_NONE;
+    }
+
+    /* On termine les requêtes en cours avant la lecture synchrone */
+    P_DFlp_CancelReads(DLayer,-1);
+    P_DFlp_WaitAll(DLayer);
+
+    if(P_DFlp_IsScattered(DLayer,Track,Count)) ErrorCode=P_DFlp_ReadOrdered(DLayer,Track,Sector,Count,BufferPtr);
+    else
+    {
+        IoReq->iotd_Req.io_Offset=Track*DLayer->TrackSize+DLayer->SectorSize*(Sector-1);
+        IoReq->iotd_Req.io_Flags=0;
+        IoReq->iotd_Req.io_Length=DLayer->SectorSize*Count;
+        IoReq->iotd_Req.io_Data=BufferPtr;
+        IoReq->iotd_Req.io_Command=CMD_READ;
+        DoIO((struct IORequest *)IoReq);
+        ErrorCode=P_DFlp_GetError(IoReq);
+    }
+
+    if(!ErrorCode) ErrorCode=P_DFlp_TakeDeferredError(DLayer);
+    if(!ErrorCode && IsFullTrack && (LONG)Track+1<DLayer->CountOfTracks) P_DFlp_SendRead(DLayer,(LONG)Track+1);
 #endif
     return ErrorCode;
 }
 
 
 /*****
-    Ecriture d'un secteur
-    * Paramtres:
-      DLayer: structure alloue par DFlp_Open()
-      Track: numro de piste  crire
-      Sector: numro du secteur de la piste  crire
-      BufferPtr: pointeur vers les donnes du secteur  crire
+    Ecriture de plusieurs secteurs consécutifs d'une piste.
+    Une piste complète est écrite en une seule requête (voir P_DFlp_SendTrack()).
+    Sinon, les secteurs sont aussi écrits en une seule requête, sauf si l'entrelacement les
+    disperse sur plusieurs tours: une requête est alors envoyée par secteur, dans l'ordre
+    où les secteurs passent sous la tête.
+    Les données sont recopiées dans le buffer d'une requête asynchrone, et l'écriture se
+    fait en tâche de fond. Une erreur d'écriture est alors remontée par DFlp_Sync(), que la
+    couche disque appelle avant de considérer les secteurs comme écrits.
+    * Paramètres:
+      DLayer: structure allouée par DFlp_Open()
+      Track: numéro de piste à écrire
+      Sector: numéro du premier secteur de la piste à écrire
+      Count: nombre de secteurs à écrire
+      BufferPtr: pointeur vers les données des secteurs à écrire
     * Retourne:
       Code d'erreur ou DL_SUCCESS
 *****/
 
-ULONG DFlp_WriteSector(struct DataLayerFloppy *DLayer, ULONG Track, ULONG Sector, const UBYTE *BufferPtr)
+ULONG DFlp_WriteSectors(struct DataLayerFloppy *DLayer, ULONG Track, ULONG Sector, ULONG Count, const UBYTE *BufferPtr)
 {
     ULONG ErrorCode=DL_SUCCESS;
 #ifdef SYSTEM_AMIGA
-    struct IOExtTD *IoReq=DLayer->DiskExtIO;
+    /* Une lecture anticipée de cette piste n'est plus valide */
+    P_DFlp_CancelReads(DLayer,(LONG)Track);
 
-    IoReq->iotd_Req.io_Offset=Track*DLayer->TrackSize+DLayer->SectorSize*(Sector-1);
-    IoReq->iotd_Req.io_Flags=0;
-    IoReq->iotd_Req.io_Length=DLayer->SectorSize;
-    IoReq->iotd_Req.io_Data=(UBYTE *)BufferPtr;
-    IoReq->iotd_Req.io_Command=CMD_WRITE;
-    DoIO((struct IORequest *)IoReq);
+    if(Sector==1 && (LONG)(Count*DLayer->SectorSize)==DLayer->TrackSize) ErrorCode=P_DFlp_SendTrack(DLayer,Track,BufferPtr);
+    else if(P_DFlp_IsScattered(DLayer,Track,Count))
+    {
+        UBYTE Order[DL_MAX_SECTORS];
+        ULONG i;
 
-    ErrorCode=P_DFlp_GetError(DLayer);
+        DL_GetRotationalOrder(P_DFlp_GetInterleave(DLayer,Track),DLayer->TrackSize/DLayer->SectorSize,Sector,Count,Order);
+        for(i=0; i<Count && !ErrorCode; i++)
+        {
+            ErrorCode=P_DFlp_SendWrite(DLayer,Track,Sector+Order[i],1,&BufferPtr[Order[i]*DLayer->SectorSize]);
+        }
+    }
+    else ErrorCode=P_DFlp_SendWrite(DLayer,Track,Sector,Count,BufferPtr);
 #endif
     return ErrorCode;
 }
 
 
+/*****
+    Lecture d'un secteur
+    * Paramètres:
+      DLayer: structure allouée par DFlp_Open()
+      Track: numéro de piste à lire
+      Sector: numéro du secteur de la piste à lire
+      BufferPtr: récipiant pour recevoir le secteur lu
+    * Retourne:
+      Code d'erreur ou DL_SUCCESS
+*****/
+
+ULONG DFlp_ReadSector(struct DataLayerFloppy *DLayer, ULONG Track, ULONG Sector, UBYTE *BufferPtr)
+{
+    return DFlp_ReadSectors(DLayer,Track,Sector,1,BufferPtr);
+}
+
+
+/*****
+    Ecriture d'un secteur
+    * Paramètres:
+      DLayer: structure allouée par DFlp_Open()
+      Track: numéro de piste à écrire
+      Sector: numéro du secteur de la piste à écrire
+      BufferPtr: pointeur vers les données du secteur à écrire
+    * Retourne:
+      Code d'erreur ou DL_SUCCESS
+*****/
+
+ULONG DFlp_WriteSector(struct DataLayerFloppy *DLayer, ULONG Track, ULONG Sector, const UBYTE *BufferPtr)
+{
+    return DFlp_WriteSectors(DLayer,Track,Sector,1,BufferPtr);
+}
+
+
 #ifdef SYSTEM_AMIGA
 
 /*****
     Conversion des erreurs todisk.device en erreur ToDisk
 *****/
 
-ULONG P_DFlp_GetError(struct DataLayerFloppy *DLayer)
+ULONG P_DFlp_GetError(struct IOExtTD *IoReq)
 {
     ULONG Result=DL_SUCCESS;
 
-    switch(DLayer->DiskExtIO->iotd_Req.io_Error)
+    switch(IoReq->iotd_Req.io_Error)
     {
         case 0:
             break;
@@ -357,10 +580,332 @@ ULONG P_DFlp_GetError(struct DataLayerFloppy *DLayer)
 }
 
 
+/*****
+    Attente de la fin d'une requête asynchrone.
+    L'erreur d'une écriture est conservée pour être retournée lors d'un prochain accès.
+*****/
+
+void P_DFlp_WaitRequest(struct DataLayerFloppy *DLayer, struct DataLayerFloppyRequest *ReqPtr)
+{
+    if(ReqPtr->IsPending)
+    {
+        WaitIO((struct IORequest *)ReqPtr->IoReq);
+        ReqPtr->IsPending=FALSE;
+        ReqPtr->Error=P_DFlp_GetError(ReqPtr->IoReq);
+
+        if(ReqPtr->Type==DFLP_REQ_WRITE)
+        {
+            if(ReqPtr->Error && !DLayer->DeferredError) DLayer->DeferredError=ReqPtr->Error;
+            ReqPtr->Type=DFLP_REQ_NONE;
+        }
+    }
+}
+
+
+/*****
+    Attente de la fin de toutes les requêtes asynchrones
+*****/
+
+void P_DFlp_WaitAll(struct DataLayerFloppy *DLayer)
+{
+    LONG i;
+
+    for(i=0; i<DFLP_COUNTOF_REQUEST; i++) P_DFlp_WaitRequest(DLayer,&DLayer->Request[i]);
+}
+
+
+/*****
+    Annulation des lectures anticipées d'une piste, ou de toutes les pistes si Track vaut -1
+*****/
+
+void P_DFlp_CancelReads(struct DataLayerFloppy *DLayer, LONG Track)
+{
+    LONG i;
+
+    for(i=0; i<DFLP_COUNTOF_REQUEST; i++)
+    {
+        struct DataLayerFloppyRequest *ReqPtr=&DLayer->Request[i];
+
+        if(ReqPtr->Type==DFLP_REQ_READ && (Track<0 || ReqPtr->Track==Track))
+        {
+            if(ReqPtr->IsPending) AbortIO((struct IORequest *)ReqPtr->IoReq);
+            P_DFlp_WaitRequest(DLayer,ReqPtr);
+            ReqPtr->Type=DFLP_REQ_NONE;
+        }
+    }
+}
+
+
+/*****
+    Recherche d'une lecture anticipée de la piste Track
+*****/
+
+struct DataLayerFloppyRequest *P_DFlp_FindRead(struct DataLayerFloppy *DLayer, LONG Track)
+{
+    LONG i;
+
+    for(i=0; i<DFLP_COUNTOF_REQUEST; i++)
+    {
+        if(DLayer->Request[i].Type==DFLP_REQ_READ && DLayer->Request[i].Track==Track) return &DLayer->Request[i];
+    }
+
+    return NULL;
+}
+
+
+/*****
+    Recherche d'une requête disponible.
+    On prend en priorité une requête libre, puis une lecture anticipée terminée.
+    Si IsWait vaut TRUE et que toutes les requêtes sont en cours, on attend la plus ancienne.
+    Retourne NULL si aucune requête n'est disponible et que IsWait vaut FALSE.
+*****/
+
+struct DataLayerFloppyRequest *P_DFlp_GetFreeRequest(struct DataLayerFloppy *DLayer, BOOL IsWait)
+{
+    LONG i;
+    struct DataLayerFloppyRequest *ReqPtr=NULL;
+
+    for(i=0; i<DFLP_COUNTOF_REQUEST && ReqPtr==NULL; i++)
+    {
+        if(!DLayer->Request[i].IsPending && DLayer->Request[i].Type==DFLP_REQ_NONE) ReqPtr=&DLayer->Request[i];
+    }
+
+    for(i=0; i<DFLP_COUNTOF_REQUEST && ReqPtr==NULL; i++)
+    {
+        if(!DLayer->Request[i].IsPending) ReqPtr=&DLayer->Request[i];
+    }
+
+    if(ReqPtr==NULL && IsWait)
+    {
+        ReqPtr=&DLayer->Request[DLayer->NextRequestIdx];
+        DLayer->NextRequestIdx=(DLayer->NextRequestIdx+1)%DFLP_COUNTOF_REQUEST;
+        P_DFlp_WaitRequest(DLayer,ReqPtr);
+    }
+
+    if(ReqPtr!=NULL) ReqPtr->Type=DFLP_REQ_NONE;
+
+    return ReqPtr;
+}
+
+
+/*****
+    Lancement en tâche de fond de l'écriture de secteurs consécutifs d'une piste.
+    Les données sont recopiées dans le buffer d'une requête libre.
+*****/
+
+ULONG P_DFlp_SendWrite(struct DataLayerFloppy *DLayer, ULONG Track, ULONG Sector, ULONG Count, const UBYTE *BufferPtr)
+{
+    ULONG ErrorCode;
+    struct DataLayerFloppyRequest *ReqPtr=P_DFlp_GetFreeRequest(DLayer,TRUE);
+    struct IOExtTD *IoReq=ReqPtr->IoReq;
+
+    if((ErrorCode=P_DFlp_TakeDeferredError(DLayer))!=DL_SUCCESS) return ErrorCode;
+
+    Sys_MemCopy(ReqPtr->BufferPtr,(void *)BufferPtr,DLayer->SectorSize*Count);
+    ReqPtr->Type=DFLP_REQ_WRITE;
+    ReqPtr->Track=(LONG)Track;
+    ReqPtr->IsPending=TRUE;
+    IoReq->iotd_Req.io_Offset=Track*DLayer->TrackSize+DLayer->SectorSize*(Sector-1);
+    IoReq->iotd_Req.io_Flags=0;
+    IoReq->iotd_Req.io_Length=DLayer->SectorSize*Count;
+    IoReq->iotd_Req.io_Data=ReqPtr->BufferPtr;
+    IoReq->iotd_Req.io_Command=CMD_WRITE;
+    SendIO((struct IORequest *)IoReq);
+
+    return DL_SUCCESS;
+}
+
+
+/*****
+    Lancement en tâche de fond de l'écriture d'une piste complète.
+    Comme pour DFlp_FormatTrack(), une piste entrelacée est réécrite par un formatage avec
+    son entrelacement, ce qui se fait en un seul tour. Sinon, ou si le device refuse
+    TO_MAKEFMTINTERLEAVE, une seule écriture de la piste entière suffit. Le refus est
+    mémorisé pour l'unité.
+*****/
+
+ULONG P_DFlp_SendTrack(struct DataLayerFloppy *DLayer, ULONG Track, const UBYTE *BufferPtr)
+{
+    ULONG ErrorCode;
+    LONG Interleave=P_DFlp_GetInterleave(DLayer,Track);
+    struct DataLayerFloppyRequest *ReqPtr;
+    struct IOExtTD *IoReq;
+
+    if(Interleave<=1 || !DLayer->IsFmtInterleave) return P_DFlp_SendWrite(DLayer,Track,1,DLayer->TrackSize/DLayer->SectorSize,BufferPtr);
+
+    ReqPtr=P_DFlp_GetFreeRequest(DLayer,TRUE);
+    if((ErrorCode=P_DFlp_TakeDeferredError(DLayer))!=DL_SUCCESS) return ErrorCode;
+
+    /* Le device traite les requêtes dans l'ordre: l'entrelacement s'applique bien
+       au formatage qui suit */
+    IoReq=DLayer->DiskExtIO;
+    IoReq->iotd_Req.io_Length=Interleave;
+    IoReq->iotd_Req.io_Command=TO_MAKEFMTINTERLEAVE;
+    DoIO((struct IORequest *)IoReq);
+    if(IoReq->iotd_Req.io_Error)
+    {
+        /* Un formatage ne respecterait pas l'entrelacement de la piste */
+        DLayer->IsFmtInterleave=FALSE;
+        return P_DFlp_SendWrite(DLayer,Track,1,DLayer->TrackSize/DLayer->SectorSize,BufferPtr);
+    }
+
+    IoReq=ReqPtr->IoReq;
+    Sys_MemCopy(ReqPtr->BufferPtr,(void *)BufferPtr,DLayer->TrackSize);
+    ReqPtr->Type=DFLP_REQ_WRITE;
+    ReqPtr->Track=(LONG)Track;
+    ReqPtr->IsPending=TRUE;
+    IoReq->iotd_Req.io_Offset=Track*DLayer->TrackSize;
+    IoReq->iotd_Req.io_Flags=0;
+    IoReq->iotd_Req.io_Length=DLayer->TrackSize;
+    IoReq->iotd_Req.io_Data=ReqPtr->BufferPtr;
+    IoReq->iotd_Req.io_Command=TD_FORMAT;
+    SendIO((struct IORequest *)IoReq);
+
+    return DL_SUCCESS;
+}
+
+
+/*****
+    Lecture synchrone de secteurs consécutifs d'une piste, un par un, dans l'ordre
+    où ils passent sous la tête. Chaque secteur est lu à sa place dans BufferPtr.
+*****/
+
+ULONG P_DFlp_ReadOrdered(struct DataLayerFloppy *DLayer, ULONG Track, ULONG Sector, ULONG Count, UBYTE *BufferPtr)
+{
+    ULONG ErrorCode=DL_SUCCESS;
+    struct IOExtTD *IoReq=DLayer->DiskExtIO;
+    UBYTE Order[DL_MAX_SECTORS];
+    ULONG i;
+
+    DL_GetRotationalOrder(P_DFlp_GetInterleave(DLayer,Track),DLayer->TrackSize/DLayer->SectorSize,Sector,Count,Order);
+    for(i=0; i<Count && !ErrorCode; i++)
+    {
+        IoReq->iotd_Req.io_Offset=Track*DLayer->TrackSize+DLayer->SectorSize*(Sector+Order[i]-1);
+        IoReq->iotd_Req.io_Flags=0;
+        IoReq->iotd_Req.io_Length=DLayer->SectorSize;
+        IoReq->iotd_Req.io_Data=&BufferPtr[Order[i]*DLayer->SectorSize];
+        IoReq->iotd_Req.io_Command=CMD_READ;
+        DoIO((struct IORequest *)IoReq);
+        ErrorCode=P_DFlp_GetError(IoReq);
+    }
+
+    return ErrorCode;
+}
+
+
+/*****
+    Entrelacement d'une piste, demandé au device au premier accès à la piste puis
+    mémorisé jusqu'au prochain changement de disque.
+    Retourne 1 (ordre logique) si l'entrelacement ne peut pas être connu.
+*****/
+
+LONG P_DFlp_GetInterleave(struct DataLayerFloppy *DLayer, ULONG Track)
+{
+    if((LONG)Track>=DLayer->CountOfTracks) return 1;
+
+    if(!DLayer->InterleaveTablePtr[Track])
+    {
+        struct IOExtTD *IoReq=DLayer->DiskExtIO;
+
+        DLayer->InterleaveTablePtr[Track]=1;
+        IoReq->iotd_Req.io_Offset=Track*DLayer->TrackSize;
+        IoReq->iotd_Req.io_Flags=0;
+        IoReq->iotd_Req.io_Length=0;
+        IoReq->iotd_Req.io_Data=NULL;
+        IoReq->iotd_Req.io_Command=TO_GETTRKINTERLEAVE;
+        DoIO((struct IORequest *)IoReq);
+        if(!IoReq->iotd_Req.io_Error && IoReq->iotd_Req.io_Actual>1 && IoReq->iotd_Req.io_Actual<256)
+        {
+            DLayer->InterleaveTablePtr[Track]=(UBYTE)IoReq->iotd_Req.io_Actual;
+        }
+    }
+
+    return (LONG)DLayer->InterleaveTablePtr[Track];
+}
+
+
+/*****
+    Test si des secteurs consécutifs d'une piste doivent être traités un par un dans
+    l'ordre de rotation. Dans l'ordre logique, chaque secteur est Interleave positions
+    après le précédent: une suite qui tient en un tour reste plus rapide en une seule
+    requête. Une piste complète est toujours traitée en une seule requête.
+*****/
+
+BOOL P_DFlp_IsScattered(struct DataLayerFloppy *DLayer, ULONG Track, ULONG Count)
+{
+    LONG SectorsPerTrack=DLayer->TrackSize/DLayer->SectorSize;
+
+    if(Count<=1 || (LONG)Count>=SectorsPerTrack) return FALSE;
+    if((LONG)(Count-1)*P_DFlp_GetInterleave(DLayer,Track)<SectorsPerTrack) return FALSE;
+
+    return TRUE;
+}
+
+
+/*****
+    Oubli des entrelacements mémorisés (changement de disque)
+*****/
+
+void P_DFlp_ForgetInterleaves(struct DataLayerFloppy *DLayer)
+{
+    LONG i;
+
+    for(i=0; i<DLayer->CountOfTracks; i++) DLayer->InterleaveTablePtr[i]=0;
+}
+
+
+/*****
+    Lancement en tâche de fond de la lecture anticipée d'une piste.
+    Rien n'est fait si la piste est déjà lue, si une écriture est en cours sur
+    cette piste, ou si aucune requête n'est libre.
+*****/
+
+void P_DFlp_SendRead(struct DataLayerFloppy *DLayer, LONG Track)
+{
+    LONG i;
+    struct DataLayerFloppyRequest *ReqPtr;
+    struct IOExtTD *IoReq;
+
+    if(P_DFlp_FindRead(DLayer,Track)!=NULL) return;
+    for(i=0; i<DFLP_COUNTOF_REQUEST; i++)
+    {
+        if(DLayer->Request[i].Type==DFLP_REQ_WRITE && DLayer->Request[i].Track==Track) return;
+    }
+
+    if((ReqPtr=P_DFlp_GetFreeRequest(DLayer,FALSE))!=NULL)
+    {
+        IoReq=ReqPtr->IoReq;
+        ReqPtr->Type=DFLP_REQ_READ;
+        ReqPtr->Track=Track;
+        ReqPtr->IsPending=TRUE;
+        IoReq->iotd_Req.io_Offset=Track*DLayer->TrackSize;
+        IoReq->iotd_Req.io_Flags=0;
+        IoReq->iotd_Req.io_Length=DLayer->TrackSize;
+        IoReq->iotd_Req.io_Data=ReqPtr->BufferPtr;
+        IoReq->iotd_Req.io_Command=CMD_READ;
+        SendIO((struct IORequest *)IoReq);
+    }
+}
+
+
+/*****
+    Retourne l'erreur d'une écriture différée, et l'efface
+*****/
+
+ULONG P_DFlp_TakeDeferredError(struct DataLayerFloppy *DLayer)
+{
+    ULONG ErrorCode=DLayer->DeferredError;
+
+    DLayer->DeferredError=DL_SUCCESS;
+
+    return ErrorCode;
+}
+
+
 /*****
     Gestion du moteur
-    * Paramtres:
-      DLayer: structure alloue par DFlp_Open()
+    * Paramètres:
+      DLayer: structure allouée par DFlp_Open()
     * Retourne:
       Code d'erreur Amiga
 *****/
@@ -411,6 +956,9 @@ BOOL P_DFlp_CheckDiskChanged(struct DataLayerFloppy *DLayer)
         struct IOExtTD *IoReq=DLayer->DiskExtIO;
 
         DLayer->IsChanged=FALSE;
+        P_DFlp_CancelReads(DLayer,-1);
+        P_DFlp_WaitAll(DLayer);
+        P_DFlp_ForgetInterleaves(DLayer);
         IoReq->iotd_Req.io_Flags=0;
         IoReq->iotd_Req.io_Command=CMD_CLEAR;
         DoIO((struct IORequest *)IoReq);
@@ -4,6 +4,25 @@
 #define MOTOR_ON    1
 #define MOTOR_OFF   0
 
+#define DFLP_COUNTOF_REQUEST    2   /* Nombre de requêtes asynchrones */
+
+#define DFLP_REQ_NONE           0
+#define DFLP_REQ_READ           1
+#define DFLP_REQ_WRITE          2
+
+struct DataLayerFloppyRequest
+{
+#ifdef SYSTEM_AMIGA
+    struct IOExtTD *IoReq;
+#endif
+    UBYTE *BufferPtr;
+    LONG Type;
+    LONG Track;
+    BOOL IsPending;
+    ULONG Error;
+};
+
+
 struct DataLayerFloppy
 {
     ULONG Unit;
@@ -19,7 +38,13 @@ struct DataLayerFloppy
     void *IntData;
     LONG TrackSize;
     LONG SectorSize;
+    LONG CountOfTracks;
+    UBYTE *InterleaveTablePtr;  /* Entrelacement de chaque piste, 0 si inconnu */
     BOOL IsChanged;
+    BOOL IsFmtInterleave;       /* FALSE si le device refuse TO_MAKEFMTINTERLEAVE */
+    struct DataLayerFloppyRequest Request[DFLP_COUNTOF_REQUEST];
+    ULONG NextRequestIdx;
+    ULONG DeferredError;
 };
 
 
@@ -27,13 +52,19 @@ struct DataLayerFloppy
 /***** PUBLIQUES UTILISABLES PAR *****/
 /***** D'AUTRES BLOCS DU PROJET  *****/
 
-extern struct DataLayerFloppy *DFlp_Open(const char *, ULONG, ULONG, ULONG, LONG, LONG, void (*)(struct DataLayerFloppy *, void *), void *, ULONG *);
+extern struct DataLayerFloppy *DFlp_Open(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(struct DataLayerFloppy *, void *), void *, ULONG *);
 extern void DFlp_Close(struct DataLayerFloppy *);
 extern BOOL DFlp_IsDiskIn(struct DataLayerFloppy *);
 extern BOOL DFlp_IsProtected(struct DataLayerFloppy *);
 extern void DFlp_Clean(struct DataLayerFloppy *);
+extern BOOL DFlp_IsChanged(struct DataLayerFloppy *);
+extern void DFlp_SetChanged(struct DataLayerFloppy *, BOOL);
+extern void DFlp_MotorOff(struct DataLayerFloppy *);
+extern ULONG DFlp_Sync(struct DataLayerFloppy *);
 extern ULONG DFlp_Finalize(struct DataLayerFloppy *);
 extern ULONG DFlp_FormatTrack(struct DataLayerFloppy *, ULONG, ULONG, const UBYTE *);
+extern ULONG DFlp_ReadSectors(struct DataLayerFloppy *, ULONG, ULONG, ULONG, UBYTE *);
+extern ULONG DFlp_WriteSectors(struct DataLayerFloppy *, ULONG, ULONG, ULONG, const UBYTE *);
 extern ULONG DFlp_ReadSector(struct DataLayerFloppy *, ULONG, ULONG, UBYTE *);
 extern ULONG DFlp_WriteSector(struct DataLayerFloppy *, ULONG, ULONG, const UBYTE *);
 
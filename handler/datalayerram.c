@@ -0,0 +1,419 @@
+#include "system.h"
+#include "datalayerram.h"
+#include "disklayer.h"
+
+#ifdef SYSTEM_UNIX
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*
+    17-10-2026 (Seg)    Ajout de DRam_ChangeDisk(), DRam_SetProtected() retourne TRUE
+    17-10-2026 (Seg)    Disque virtuel en mémoire
+*/
+
+
+/***** Prototypes */
+struct DataLayerRam *DRam_Open(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(struct DataLayerRam *, void *), void *, ULONG *);
+void DRam_Close(struct DataLayerRam *);
+BOOL DRam_IsDiskIn(struct DataLayerRam *);
+BOOL DRam_IsProtected(struct DataLayerRam *);
+void DRam_Clean(struct DataLayerRam *);
+BOOL DRam_IsChanged(struct DataLayerRam *);
+void DRam_SetChanged(struct DataLayerRam *, BOOL);
+ULONG DRam_Finalize(struct DataLayerRam *);
+ULONG DRam_FormatTrack(struct DataLayerRam *, ULONG, ULONG, const UBYTE *);
+ULONG DRam_ReadSectors(struct DataLayerRam *, ULONG, ULONG, ULONG, UBYTE *);
+ULONG DRam_WriteSectors(struct DataLayerRam *, ULONG, ULONG, ULONG, const UBYTE *);
+void DRam_Insert(struct DataLayerRam *);
+void DRam_Eject(struct DataLayerRam *);
+BOOL DRam_ChangeDisk(struct DataLayerRam *, BOOL);
+BOOL DRam_SetProtected(struct DataLayerRam *, BOOL);
+ULONG DRam_Load(struct DataLayerRam *);
+ULONG DRam_Save(struct DataLayerRam *);
+
+void P_DRam_NotifyChange(struct DataLayerRam *);
+ULONG P_DRam_CheckAccess(struct DataLayerRam *, ULONG, ULONG, ULONG);
+
+
+/*****
+    Ouverture d'un disque virtuel en mémoire.
+    La face complète est gardée en mémoire, ce qui permet de faire tourner le file system
+    et la couche disque sans lecteur. Si un nom d'image est donné après le préfixe
+    (@ram:<image>), la face y est préchargée à l'ouverture et y est sauvegardée par
+    DRam_Finalize(). L'image a le format d'une image .fd.
+    * Paramètres:
+      Name: @ram ou @ram:<image>
+      Flags: non utilisé
+      Unit: non utilisé
+      Side: numéro de la face dans l'image
+      CountOfTracks: nombre de pistes
+      SectorPerTrack: pour indiquer le nombre de secteurs par piste
+      SectorSize: pour indiquer la taille d'un secteur
+      IntFuncPtr: pointeur vers une fonction callback appelée par DRam_Insert() et DRam_Eject()
+      IntData: pointeur vers une structure utilisateur à passer lors de l'utilisation du callback
+      ErrorCode: pointeur vers un ULONG pour retourner un code d'erreur ou DL_SUCCESS
+    * Retourne:
+      - NULL si échec
+      - pointeur vers une structure DataLayerRam si succès
+*****/
+
+struct DataLayerRam *DRam_Open(const char *Name, ULONG Flags, ULONG Unit, ULONG Side, LONG CountOfTracks, LONG SectorPerTrack, LONG SectorSize, void (*IntFuncPtr)(struct DataLayerRam *, void *), void *IntData, ULONG *ErrorCode)
+{
+    struct DataLayerRam *DLayer=(struct DataLayerRam *)Sys_AllocMem(sizeof(struct DataLayerRam));
+
+    *ErrorCode=DL_NOT_ENOUGH_MEMORY;
+    if(DLayer!=NULL)
+    {
+        const char *FileName=&Name[Sys_StrLen(RAM_NAME_PREFIX)];
+
+        DLayer->TrackSize=SectorPerTrack*SectorSize;
+        DLayer->SectorSize=SectorSize;
+        DLayer->CountOfTracks=CountOfTracks;
+        DLayer->FaceSize=DLayer->TrackSize*CountOfTracks;
+        DLayer->FaceOffset=DLayer->FaceSize*(LONG)Side;
+        DLayer->IntFuncPtr=IntFuncPtr;
+        DLayer->IntData=IntData;
+        DLayer->IsDiskIn=TRUE;
+
+        if((DLayer->FacePtr=(UBYTE *)Sys_AllocMem(DLayer->FaceSize))!=NULL)
+        {
+            *ErrorCode=DL_SUCCESS;
+            if(*FileName==':' && *(++FileName)!=0)
+            {
+                LONG Len=Sys_StrLen(FileName)+1;
+
+                *ErrorCode=DL_NOT_ENOUGH_MEMORY;
+                if((DLayer->FileNamePtr=(char *)Sys_AllocMem(Len))!=NULL)
+                {
+                    Sys_StrCopy(DLayer->FileNamePtr,FileName,Len);
+                    *ErrorCode=DL_SUCCESS;
+                }
+            }
+
+            if(*ErrorCode==DL_SUCCESS) *ErrorCode=DRam_Load(DLayer);
+        }
+
+        if(*ErrorCode!=DL_SUCCESS)
+        {
+            DRam_Close(DLayer);
+            DLayer=NULL;
+        }
+    }
+
+    return DLayer;
+}
+
+
+/*****
+    Libération des ressources allouées par DRam_Open()
+*****/
+
+void DRam_Close(struct DataLayerRam *DLayer)
+{
+    if(DLayer!=NULL)
+    {
+        Sys_FreeMem((void *)DLayer->FacePtr);
+        Sys_FreeMem((void *)DLayer->FileNamePtr);
+        Sys_FreeMem((void *)DLayer);
+    }
+}
+
+
+/*****
+    Pour vérifier si un disque est présent
+*****/
+
+BOOL DRam_IsDiskIn(struct DataLayerRam *DLayer)
+{
+    return DLayer->IsDiskIn;
+}
+
+
+/*****
+    Pour vérifier si le disque est protégé
+*****/
+
+BOOL DRam_IsProtected(struct DataLayerRam *DLayer)
+{
+    return DLayer->IsProtected;
+}
+
+
+/*****
+    Nettoyage des caches (rien à faire en mémoire)
+*****/
+
+void DRam_Clean(struct DataLayerRam *DLayer)
+{
+}
+
+
+/*****
+    Test si le disque a changé
+*****/
+
+BOOL DRam_IsChanged(struct DataLayerRam *DLayer)
+{
+    return DLayer->IsChanged;
+}
+
+
+/*****
+    Pour changer le flag de changement de disque
+*****/
+
+void DRam_SetChanged(struct DataLayerRam *DLayer, BOOL IsChanged)
+{
+    DLayer->IsChanged=IsChanged;
+}
+
+
+/*****
+    Sauvegarde de la face dans l'image, si elle a été modifiée
+*****/
+
+ULONG DRam_Finalize(struct DataLayerRam *DLayer)
+{
+    if(DLayer->IsUpdated) return DRam_Save(DLayer);
+
+    return DL_SUCCESS;
+}
+
+
+/*****
+    Formatage d'une piste: les données de la piste sont simplement remplacées
+    * Paramètres:
+      DLayer: structure allouée par DRam_Open()
+      Track: piste à formater
+      Interleave: non utilisé
+      BufferPtr: pointeur vers les données qui vont servir initialiser la piste.
+        Ce buffer doit avoir pour taille le nombre d'octets par secteur multiplié
+        par le nombre de secteurs par piste.
+    * Retourne:
+      Code d'erreur ou DL_SUCCESS
+*****/
+
+ULONG DRam_FormatTrack(struct DataLayerRam *DLayer, ULONG Track, ULONG Interleave, const UBYTE *BufferPtr)
+{
+    return DRam_WriteSectors(DLayer,Track,1,(ULONG)(DLayer->TrackSize/DLayer->SectorSize),BufferPtr);
+}
+
+
+/*****
+    Lecture de plusieurs secteurs consécutifs d'une piste
+    * Paramètres:
+      DLayer: structure allouée par DRam_Open()
+      Track: numéro de piste à lire
+      Sector: numéro du premier secteur de la piste à lire
+      Count: nombre de secteurs à lire
+      BufferPtr: récipiant pour recevoir les secteurs lus
+    * Retourne:
+      Code d'erreur ou DL_SUCCESS
+*****/
+
+ULONG DRam_ReadSectors(struct DataLayerRam *DLayer, ULONG Track, ULONG Sector, ULONG Count, UBYTE *BufferPtr)
+{
+    ULONG ErrorCode=P_DRam_CheckAccess(DLayer,Track,Sector,Count);
+
+    if(!ErrorCode)
+    {
+        Sys_MemCopy(BufferPtr,&DLayer->FacePtr[Track*DLayer->TrackSize+DLayer->SectorSize*(Sector-1)],DLayer->SectorSize*Count);
+    }
+
+    return ErrorCode;
+}
+
+
+/*****
+    Ecriture de plusieurs secteurs consécutifs d'une piste
+    * Paramètres:
+      DLayer: structure allouée par DRam_Open()
+      Track: numéro de piste à écrire
+      Sector: numéro du premier secteur de la piste à écrire
+      Count: nombre de secteurs à écrire
+      BufferPtr: pointeur vers les données des secteurs à écrire
+    * Retourne:
+      Code d'erreur ou DL_SUCCESS
+*****/
+
+ULONG DRam_WriteSectors(struct DataLayerRam *DLayer, ULONG Track, ULONG Sector, ULONG Count, const UBYTE *BufferPtr)
+{
+    ULONG ErrorCode=P_DRam_CheckAccess(DLayer,Track,Sector,Count);
+
+    if(!ErrorCode && DLayer->IsProtected) ErrorCode=DL_PROTECTED;
+    if(!ErrorCode)
+    {
+        Sys_MemCopy(&DLayer->FacePtr[Track*DLayer->TrackSize+DLayer->SectorSize*(Sector-1)],(void *)BufferPtr,DLayer->SectorSize*Count);
+        DLayer->IsUpdated=TRUE;
+    }
+
+    return ErrorCode;
+}
+
+
+/*****
+    Simulation de l'insertion d'un disque: le contenu est rechargé depuis l'image
+    et le changement est signalé par le callback.
+*****/
+
+void DRam_Insert(struct DataLayerRam *DLayer)
+{
+    DRam_Load(DLayer);
+    DLayer->IsDiskIn=TRUE;
+    P_DRam_NotifyChange(DLayer);
+}
+
+
+/*****
+    Simulation du retrait du disque: le changement est signalé par le callback
+*****/
+
+void DRam_Eject(struct DataLayerRam *DLayer)
+{
+    DLayer->IsDiskIn=FALSE;
+    P_DRam_NotifyChange(DLayer);
+}
+
+
+/*****
+    Insertion ou retrait du disque selon IsDiskIn (voir DL_ChangeDisk()).
+    Retourne toujours TRUE.
+*****/
+
+BOOL DRam_ChangeDisk(struct DataLayerRam *DLayer, BOOL IsDiskIn)
+{
+    if(IsDiskIn) DRam_Insert(DLayer);
+    else DRam_Eject(DLayer);
+    return TRUE;
+}
+
+
+/*****
+    Simulation de l'onglet de protection du disque (voir DL_SetProtected()).
+    Retourne toujours TRUE.
+*****/
+
+BOOL DRam_SetProtected(struct DataLayerRam *DLayer, BOOL IsProtected)
+{
+    DLayer->IsProtected=IsProtected;
+    return TRUE;
+}
+
+
+/*****
+    Chargement de la face depuis l'image.
+    La face est d'abord vierge; la partie présente dans l'image est ensuite lue.
+    Une image inexistante n'est pas une erreur: elle sera créée par DRam_Save().
+*****/
+
+ULONG DRam_Load(struct DataLayerRam *DLayer)
+{
+    ULONG ErrorCode=DL_SUCCESS;
+    LONG i;
+
+    for(i=0; i<DLayer->FaceSize; i++) DLayer->FacePtr[i]=RAM_BLANK_BYTE;
+    DLayer->IsUpdated=FALSE;
+
+    if(DLayer->FileNamePtr!=NULL)
+    {
+#ifdef SYSTEM_AMIGA
+        BPTR FileHandle;
+
+        if((FileHandle=Open((STRPTR)DLayer->FileNamePtr,MODE_OLDFILE))!=0)
+        {
+            ErrorCode=DL_READ_FILE;
+            if(Seek(FileHandle,0,OFFSET_END)>=0)
+            {
+                LONG Size=Seek(FileHandle,DLayer->FaceOffset,OFFSET_BEGINNING)-DLayer->FaceOffset;
+
+                if(Size>DLayer->FaceSize) Size=DLayer->FaceSize;
+                if(Size<=0 || Read(FileHandle,(APTR)DLayer->FacePtr,Size)==Size) ErrorCode=DL_SUCCESS;
+            }
+            Close(FileHandle);
+        }
+#endif
+#ifdef SYSTEM_UNIX
+        int FileDesc;
+
+        if((FileDesc=open(DLayer->FileNamePtr,O_RDONLY))>=0)
+        {
+            if(pread(FileDesc,(void *)DLayer->FacePtr,(size_t)DLayer->FaceSize,(off_t)DLayer->FaceOffset)<0) ErrorCode=DL_READ_FILE;
+            close(FileDesc);
+        }
+        else if(errno!=ENOENT) ErrorCode=DL_OPEN_FILE;
+#endif
+    }
+
+    return ErrorCode;
+}
+
+
+/*****
+    Sauvegarde de la face dans l'image (rien à faire sans image)
+*****/
+
+ULONG DRam_Save(struct DataLayerRam *DLayer)
+{
+    ULONG ErrorCode=DL_SUCCESS;
+
+    if(DLayer->FileNamePtr!=NULL)
+    {
+#ifdef SYSTEM_AMIGA
+        BPTR FileHandle;
+
+        ErrorCode=DL_OPEN_FILE;
+        if((FileHandle=Open((STRPTR)DLayer->FileNamePtr,MODE_READWRITE))!=0)
+        {
+            ErrorCode=DL_WRITE_FILE;
+            if(Seek(FileHandle,DLayer->FaceOffset,OFFSET_BEGINNING)>=0)
+            {
+                if(Write(FileHandle,(APTR)DLayer->FacePtr,DLayer->FaceSize)==DLayer->FaceSize) ErrorCode=DL_SUCCESS;
+            }
+            Close(FileHandle);
+        }
+#endif
+#ifdef SYSTEM_UNIX
+        int FileDesc;
+
+        ErrorCode=DL_OPEN_FILE;
+        if((FileDesc=open(DLayer->FileNamePtr,O_WRONLY|O_CREAT,0644))>=0)
+        {
+            ErrorCode=DL_WRITE_FILE;
+            if(pwrite(FileDesc,(const void *)DLayer->FacePtr,(size_t)DLayer->FaceSize,(off_t)DLayer->FaceOffset)==(ssize_t)DLayer->FaceSize) ErrorCode=DL_SUCCESS;
+            close(FileDesc);
+        }
+#endif
+    }
+
+    if(!ErrorCode) DLayer->IsUpdated=FALSE;
+
+    return ErrorCode;
+}
+
+
+/*****
+    Signale un changement de disque, comme le fait l'interruption du lecteur
+*****/
+
+void P_DRam_NotifyChange(struct DataLayerRam *DLayer)
+{
+    DLayer->IsChanged=TRUE;
+    if(DLayer->IntFuncPtr!=NULL) DLayer->IntFuncPtr(DLayer,DLayer->IntData);
+}
+
+
+/*****
+    Vérifie que le disque est présent et que les secteurs demandés sont dans
+    la géométrie du disque
+*****/
+
+ULONG P_DRam_CheckAccess(struct DataLayerRam *DLayer, ULONG Track, ULONG Sector, ULONG Count)
+{
+    if(!DLayer->IsDiskIn) return DL_NO_DISK;
+    if((LONG)Track>=DLayer->CountOfTracks || Sector<1) return DL_SECTOR_GEO;
+    if((LONG)((Sector-1+Count)*DLayer->SectorSize)>DLayer->TrackSize) return DL_SECTOR_GEO;
+
+    return DL_SUCCESS;
+}
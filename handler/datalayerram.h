@@ -0,0 +1,47 @@
+#ifndef DATALAYERRAM_H
+#define DATALAYERRAM_H
+
+#define RAM_NAME_PREFIX         "@ram"  /* Nom de la source: @ram ou @ram:<image> */
+#define RAM_BLANK_BYTE          0xe5    /* Contenu d'un secteur jamais écrit */
+
+struct DataLayerRam
+{
+    char *FileNamePtr;      /* Image de préchargement et de sauvegarde, ou NULL */
+    UBYTE *FacePtr;         /* La face complète en mémoire */
+    LONG FaceOffset;        /* Position de la face dans l'image */
+    LONG FaceSize;
+    LONG TrackSize;
+    LONG SectorSize;
+    LONG CountOfTracks;
+    void (*IntFuncPtr)(struct DataLayerRam *, void *);
+    void *IntData;
+    BOOL IsDiskIn;
+    BOOL IsProtected;
+    BOOL IsChanged;
+    BOOL IsUpdated;         /* Modifiée depuis la dernière sauvegarde */
+};
+
+
+/***** VARIABLES ET FONCTIONS    *****/
+/***** PUBLIQUES UTILISABLES PAR *****/
+/***** D'AUTRES BLOCS DU PROJET  *****/
+
+extern struct DataLayerRam *DRam_Open(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(struct DataLayerRam *, void *), void *, ULONG *);
+extern void DRam_Close(struct DataLayerRam *);
+extern BOOL DRam_IsDiskIn(struct DataLayerRam *);
+extern BOOL DRam_IsProtected(struct DataLayerRam *);
+extern void DRam_Clean(struct DataLayerRam *);
+extern BOOL DRam_IsChanged(struct DataLayerRam *);
+extern void DRam_SetChanged(struct DataLayerRam *, BOOL);
+extern ULONG DRam_Finalize(struct DataLayerRam *);
+extern ULONG DRam_FormatTrack(struct DataLayerRam *, ULONG, ULONG, const UBYTE *);
+extern ULONG DRam_ReadSectors(struct DataLayerRam *, ULONG, ULONG, ULONG, UBYTE *);
+extern ULONG DRam_WriteSectors(struct DataLayerRam *, ULONG, ULONG, ULONG, const UBYTE *);
+extern void DRam_Insert(struct DataLayerRam *);
+extern void DRam_Eject(struct DataLayerRam *);
+extern BOOL DRam_ChangeDisk(struct DataLayerRam *, BOOL);
+extern BOOL DRam_SetProtected(struct DataLayerRam *, BOOL);
+extern ULONG DRam_Load(struct DataLayerRam *);
+extern ULONG DRam_Save(struct DataLayerRam *);
+
+#endif  /* DATALAYERRAM_H */
@@ -0,0 +1,571 @@
+#include "system.h"
+#include "datalayersap.h"
+#include "disklayer.h"
+
+#ifdef SYSTEM_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*
+    17-10-2026 (Seg)    Les octets de format et de protection lus sont conservés à l'écriture;
+                        masquage par mots longs alignés uniquement
+    17-10-2026 (Seg)    Gestion des images disque .sap
+*/
+
+
+/***** Prototypes */
+struct DataLayerSap *DSap_Open(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(struct DataLayerSap *, void *), void *, ULONG *);
+void DSap_Close(struct DataLayerSap *);
+BOOL DSap_IsDiskIn(struct DataLayerSap *);
+BOOL DSap_IsProtected(struct DataLayerSap *);
+void DSap_Clean(struct DataLayerSap *);
+BOOL DSap_IsChanged(struct DataLayerSap *);
+void DSap_SetChanged(struct DataLayerSap *, BOOL);
+ULONG DSap_Finalize(struct DataLayerSap *);
+ULONG DSap_FormatTrack(struct DataLayerSap *, ULONG, ULONG, const UBYTE *);
+ULONG DSap_ReadSectors(struct DataLayerSap *, ULONG, ULONG, ULONG, UBYTE *);
+ULONG DSap_WriteSectors(struct DataLayerSap *, ULONG, ULONG, ULONG, const UBYTE *);
+
+ULONG P_DSap_OpenFile(struct DataLayerSap *, const char *);
+ULONG P_DSap_BuildIndex(struct DataLayerSap *);
+LONG P_DSap_GetOffset(struct DataLayerSap *, ULONG, ULONG, BOOL);
+ULONG P_DSap_DecodeRecord(struct DataLayerSap *, UBYTE *, ULONG, ULONG, UBYTE *);
+void P_DSap_EncodeRecord(struct DataLayerSap *, UBYTE *, ULONG, ULONG, const UBYTE *);
+UWORD P_DSap_GetCrc(const UBYTE *, LONG);
+void P_DSap_Xor(struct DataLayerSap *, UBYTE *, LONG);
+void P_DSap_InitCrcTable(void);
+BOOL P_DSap_ReadFile(struct DataLayerSap *, LONG, UBYTE *, LONG);
+BOOL P_DSap_WriteFile(struct DataLayerSap *, LONG, const UBYTE *, LONG);
+BOOL P_DSap_IsGeoOk(struct DataLayerSap *, ULONG, ULONG, ULONG);
+
+
+/* Table du CRC de Pukall, par quartet */
+static const UWORD DSap_CrcNibbleTable[16]=
+{
+    0x0000,0x1081,0x2102,0x3183,0x4204,0x5285,0x6306,0x7387,
+    0x8408,0x9489,0xa50a,0xb58b,0xc60c,0xd68d,0xe70e,0xf78f
+};
+
+/* Même CRC, par octet (construite à partir de la table par quartet) */
+static UWORD DSap_CrcTable[256];
+static BOOL DSap_IsCrcTableOk=FALSE;
+
+static const char DSap_Signature[]="SYSTEME D'ARCHIVAGE PUKALL";
+
+
+/*****
+    Ouverture d'une image disque .sap.
+    Une image .sap contient une face, sous la forme d'un entête suivi d'un enregistrement
+    par secteur: entête du secteur, données masquées par un XOR et CRC.
+    Un index de la position de chaque secteur dans le fichier est construit à l'ouverture.
+    * Paramètres:
+      FileName: nom du fichier image
+      Flags: non utilisé
+      Unit: non utilisé
+      Side: non utilisé (une image .sap ne contient qu'une face)
+      CountOfTracks: nombre de pistes
+      SectorPerTrack: pour indiquer le nombre de secteurs par piste
+      SectorSize: pour indiquer la taille d'un secteur
+      IntFuncPtr: non utilisé (pas de changement de disque possible)
+      IntData: non utilisé
+      ErrorCode: pointeur vers un ULONG pour retourner un code d'erreur ou DL_SUCCESS
+    * Retourne:
+      - NULL si échec
+      - pointeur vers une structure DataLayerSap si succès
+*****/
+
+struct DataLayerSap *DSap_Open(const char *FileName, ULONG Flags, ULONG Unit, ULONG Side, LONG CountOfTracks, LONG SectorPerTrack, LONG SectorSize, void (*IntFuncPtr)(struct DataLayerSap *, void *), void *IntData, ULONG *ErrorCode)
+{
+    struct DataLayerSap *DLayer=(struct DataLayerSap *)Sys_AllocMem(sizeof(struct DataLayerSap));
+
+    P_DSap_InitCrcTable();
+
+    *ErrorCode=DL_NOT_ENOUGH_MEMORY;
+    if(DLayer!=NULL)
+    {
+#ifdef SYSTEM_UNIX
+        DLayer->FileDesc=-1;
+#endif
+        DLayer->RecordSize=SAP_RECORD_HEADER_SIZE+SectorSize+SAP_RECORD_CRC_SIZE;
+        DLayer->SectorSize=SectorSize;
+        DLayer->SectorsPerTrack=SectorPerTrack;
+        DLayer->CountOfTracks=CountOfTracks;
+        DLayer->IsChanged=FALSE;
+
+        DLayer->OffsetTablePtr=(LONG *)Sys_AllocMem(sizeof(LONG)*CountOfTracks*SectorPerTrack);
+        DLayer->FormatTablePtr=(UBYTE *)Sys_AllocMem(2*CountOfTracks*SectorPerTrack);
+        DLayer->RecordBufferPtr=(UBYTE *)Sys_AllocMem(DLayer->RecordSize*DL_MAX_SECTORS);
+        if(DLayer->OffsetTablePtr!=NULL && DLayer->FormatTablePtr!=NULL && DLayer->RecordBufferPtr!=NULL)
+        {
+            if((*ErrorCode=P_DSap_OpenFile(DLayer,FileName))==DL_SUCCESS)
+            {
+                *ErrorCode=P_DSap_BuildIndex(DLayer);
+            }
+        }
+
+        if(*ErrorCode!=DL_SUCCESS)
+        {
+            DSap_Close(DLayer);
+            DLayer=NULL;
+        }
+    }
+
+    return DLayer;
+}
+
+
+/*****
+    Libération des ressources allouées par DSap_Open()
+*****/
+
+void DSap_Close(struct DataLayerSap *DLayer)
+{
+    if(DLayer!=NULL)
+    {
+#ifdef SYSTEM_AMIGA
+        if(DLayer->FileHandle) Close(DLayer->FileHandle);
+#endif
+#ifdef SYSTEM_UNIX
+        if(DLayer->FileDesc>=0) close(DLayer->FileDesc);
+#endif
+        Sys_FreeMem((void *)DLayer->RecordBufferPtr);
+        Sys_FreeMem((void *)DLayer->FormatTablePtr);
+        Sys_FreeMem((void *)DLayer->OffsetTablePtr);
+        Sys_FreeMem((void *)DLayer);
+    }
+}
+
+
+/*****
+    Pour vérifier si un disque est présent (toujours vrai pour une image)
+*****/
+
+BOOL DSap_IsDiskIn(struct DataLayerSap *DLayer)
+{
+    return TRUE;
+}
+
+
+/*****
+    Pour vérifier si l'image est protégée en écriture
+*****/
+
+BOOL DSap_IsProtected(struct DataLayerSap *DLayer)
+{
+    return DLayer->IsProtected;
+}
+
+
+/*****
+    Nettoyage des caches (rien à faire pour une image)
+*****/
+
+void DSap_Clean(struct DataLayerSap *DLayer)
+{
+}
+
+
+/*****
+    Test si le disque a changé
+*****/
+
+BOOL DSap_IsChanged(struct DataLayerSap *DLayer)
+{
+    return DLayer->IsChanged;
+}
+
+
+/*****
+    Pour changer le flag de changement de disque
+*****/
+
+void DSap_SetChanged(struct DataLayerSap *DLayer, BOOL IsChanged)
+{
+    DLayer->IsChanged=IsChanged;
+}
+
+
+/*****
+    Les secteurs sont écrits directement dans le fichier: rien à terminer ici
+*****/
+
+ULONG DSap_Finalize(struct DataLayerSap *DLayer)
+{
+    return DL_SUCCESS;
+}
+
+
+/*****
+    Formatage d'une piste: les secteurs de la piste sont simplement réécrits
+    * Paramètres:
+      DLayer: structure allouée par DSap_Open()
+      Track: piste à formater
+      Interleave: non utilisé
+      BufferPtr: pointeur vers les données qui vont servir initialiser la piste.
+        Ce buffer doit avoir pour taille le nombre d'octets par secteur multiplié
+        par le nombre de secteurs par piste.
+    * Retourne:
+      Code d'erreur ou DL_SUCCESS
+*****/
+
+ULONG DSap_FormatTrack(struct DataLayerSap *DLayer, ULONG Track, ULONG Interleave, const UBYTE *BufferPtr)
+{
+    return DSap_WriteSectors(DLayer,Track,1,(ULONG)DLayer->SectorsPerTrack,BufferPtr);
+}
+
+
+/*****
+    Lecture de plusieurs secteurs consécutifs d'une piste.
+    Les enregistrements qui se suivent dans le fichier sont lus en une seule fois.
+    * Paramètres:
+      DLayer: structure allouée par DSap_Open()
+      Track: numéro de piste à lire
+      Sector: numéro du premier secteur de la piste à lire
+      Count: nombre de secteurs à lire
+      BufferPtr: récipiant pour recevoir les secteurs lus
+    * Retourne:
+      Code d'erreur ou DL_SUCCESS
+*****/
+
+ULONG DSap_ReadSectors(struct DataLayerSap *DLayer, ULONG Track, ULONG Sector, ULONG Count, UBYTE *BufferPtr)
+{
+    ULONG ErrorCode=DL_SUCCESS;
+    ULONG i=0;
+
+    if(!P_DSap_IsGeoOk(DLayer,Track,Sector,Count)) return DL_SECTOR_GEO;
+
+    while(i<Count && !ErrorCode)
+    {
+        ULONG First=i;
+        LONG Offset=P_DSap_GetOffset(DLayer,Track,Sector+i,FALSE);
+
+        if(Offset<0) return DL_SECTOR_GEO;
+        while(++i<Count && P_DSap_GetOffset(DLayer,Track,Sector+i,FALSE)==Offset+(LONG)(i-First)*DLayer->RecordSize);
+
+        ErrorCode=DL_READ_FILE;
+        if(P_DSap_ReadFile(DLayer,Offset,DLayer->RecordBufferPtr,(LONG)(i-First)*DLayer->RecordSize))
+        {
+            ULONG j;
+
+            ErrorCode=DL_SUCCESS;
+            for(j=First; j<i && !ErrorCode; j++)
+            {
+                ErrorCode=P_DSap_DecodeRecord(DLayer,&DLayer->RecordBufferPtr[(j-First)*DLayer->RecordSize],Track,Sector+j,&BufferPtr[j*DLayer->SectorSize]);
+            }
+        }
+    }
+
+    return ErrorCode;
+}
+
+
+/*****
+    Ecriture de plusieurs secteurs consécutifs d'une piste.
+    Seuls les secteurs demandés sont réécrits dans le fichier. Un secteur absent de
+    l'image est ajouté à la fin du fichier.
+    * Paramètres:
+      DLayer: structure allouée par DSap_Open()
+      Track: numéro de piste à écrire
+      Sector: numéro du premier secteur de la piste à écrire
+      Count: nombre de secteurs à écrire
+      BufferPtr: pointeur vers les données des secteurs à écrire
+    * Retourne:
+      Code d'erreur ou DL_SUCCESS
+*****/
+
+ULONG DSap_WriteSectors(struct DataLayerSap *DLayer, ULONG Track, ULONG Sector, ULONG Count, const UBYTE *BufferPtr)
+{
+    ULONG ErrorCode=DL_SUCCESS;
+    ULONG i=0;
+
+    if(DLayer->IsProtected) return DL_PROTECTED;
+    if(!P_DSap_IsGeoOk(DLayer,Track,Sector,Count)) return DL_SECTOR_GEO;
+
+    while(i<Count && !ErrorCode)
+    {
+        ULONG First=i;
+        LONG Offset=P_DSap_GetOffset(DLayer,Track,Sector+i,TRUE);
+
+        do
+        {
+            P_DSap_EncodeRecord(DLayer,&DLayer->RecordBufferPtr[(i-First)*DLayer->RecordSize],Track,Sector+i,&BufferPtr[i*DLayer->SectorSize]);
+        } while(++i<Count && P_DSap_GetOffset(DLayer,Track,Sector+i,TRUE)==Offset+(LONG)(i-First)*DLayer->RecordSize);
+
+        ErrorCode=DL_WRITE_FILE;
+        if(P_DSap_WriteFile(DLayer,Offset,DLayer->RecordBufferPtr,(LONG)(i-First)*DLayer->RecordSize)) ErrorCode=DL_SUCCESS;
+    }
+
+    return ErrorCode;
+}
+
+
+/*****
+    Ouverture du fichier image.
+    L'image est en lecture seule si le fichier est protégé en écriture.
+*****/
+
+ULONG P_DSap_OpenFile(struct DataLayerSap *DLayer, const char *FileName)
+{
+    ULONG ErrorCode=DL_OPEN_FILE;
+#ifdef SYSTEM_AMIGA
+    struct FileInfoBlock *FibPtr;
+
+    if((FibPtr=(struct FileInfoBlock *)Sys_AllocMem(sizeof(struct FileInfoBlock)))==NULL) return DL_NOT_ENOUGH_MEMORY;
+
+    if((DLayer->FileHandle=Open((STRPTR)FileName,MODE_OLDFILE))!=0)
+    {
+        if(ExamineFH(DLayer->FileHandle,FibPtr))
+        {
+            /* Les bits de protection sont actifs à 0 */
+            DLayer->IsProtected=(FibPtr->fib_Protection&FIBF_WRITE)?TRUE:FALSE;
+            DLayer->FileSize=FibPtr->fib_Size;
+            ErrorCode=DL_SUCCESS;
+        }
+    }
+
+    Sys_FreeMem((void *)FibPtr);
+#endif
+#ifdef SYSTEM_UNIX
+    DLayer->IsProtected=FALSE;
+    if((DLayer->FileDesc=open(FileName,O_RDWR))<0)
+    {
+        DLayer->IsProtected=TRUE;
+        DLayer->FileDesc=open(FileName,O_RDONLY);
+    }
+
+    if(DLayer->FileDesc>=0)
+    {
+        DLayer->FileSize=(LONG)lseek(DLayer->FileDesc,0,SEEK_END);
+        if(DLayer->FileSize>=0) ErrorCode=DL_SUCCESS;
+    }
+#endif
+    return ErrorCode;
+}
+
+
+/*****
+    Vérification de l'entête et construction de l'index des secteurs.
+    Le fichier est parcouru par blocs de DL_MAX_SECTORS enregistrements. Un
+    enregistrement incomplet en fin de fichier est ignoré. Les octets de format et
+    de protection de chaque secteur sont retenus pour P_DSap_EncodeRecord().
+*****/
+
+ULONG P_DSap_BuildIndex(struct DataLayerSap *DLayer)
+{
+    UBYTE *BufferPtr=DLayer->RecordBufferPtr;
+    LONG CountOfSectors=DLayer->CountOfTracks*DLayer->SectorsPerTrack;
+    LONG CountOfRecords,Offset,i;
+
+    for(i=0; i<CountOfSectors; i++) DLayer->OffsetTablePtr[i]=-1;
+
+    /* Entête: octet de format puis signature */
+    if(DLayer->FileSize<SAP_HEADER_SIZE || !P_DSap_ReadFile(DLayer,0,BufferPtr,SAP_HEADER_SIZE)) return DL_READ_FILE;
+    for(i=0; DSap_Signature[i]!=0; i++)
+    {
+        if(BufferPtr[1+i]!=(UBYTE)DSap_Signature[i]) return DL_SECTOR_GEO;
+    }
+
+    CountOfRecords=(DLayer->FileSize-SAP_HEADER_SIZE)/DLayer->RecordSize;
+    DLayer->FileSize=SAP_HEADER_SIZE+CountOfRecords*DLayer->RecordSize;
+
+    for(Offset=SAP_HEADER_SIZE; CountOfRecords>0; )
+    {
+        LONG Count=CountOfRecords<DL_MAX_SECTORS?CountOfRecords:DL_MAX_SECTORS;
+
+        if(!P_DSap_ReadFile(DLayer,Offset,BufferPtr,Count*DLayer->RecordSize)) return DL_READ_FILE;
+        for(i=0; i<Count; i++, Offset+=DLayer->RecordSize)
+        {
+            UBYTE *RecordPtr=&BufferPtr[i*DLayer->RecordSize];
+            LONG Track=(LONG)RecordPtr[2];
+            LONG Sector=(LONG)RecordPtr[3];
+
+            if(Track<DLayer->CountOfTracks && Sector>=1 && Sector<=DLayer->SectorsPerTrack)
+            {
+                LONG Idx=Track*DLayer->SectorsPerTrack+Sector-1;
+
+                DLayer->OffsetTablePtr[Idx]=Offset;
+                DLayer->FormatTablePtr[2*Idx]=RecordPtr[0];
+                DLayer->FormatTablePtr[2*Idx+1]=RecordPtr[1];
+            }
+        }
+        CountOfRecords-=Count;
+    }
+
+    return DL_SUCCESS;
+}
+
+
+/*****
+    Position d'un secteur dans le fichier.
+    Si IsAlloc vaut TRUE, un secteur absent reçoit une place en fin de fichier.
+    Retourne -1 si le secteur est absent.
+*****/
+
+LONG P_DSap_GetOffset(struct DataLayerSap *DLayer, ULONG Track, ULONG Sector, BOOL IsAlloc)
+{
+    LONG *OffsetPtr=&DLayer->OffsetTablePtr[Track*DLayer->SectorsPerTrack+Sector-1];
+
+    if(*OffsetPtr<0 && IsAlloc)
+    {
+        *OffsetPtr=DLayer->FileSize;
+        DLayer->FileSize+=DLayer->RecordSize;
+    }
+
+    return *OffsetPtr;
+}
+
+
+/*****
+    Décodage d'un enregistrement lu dans le fichier.
+    Les données sont démasquées sur place puis recopiées dans BufferPtr.
+    Retourne DL_SECTOR_CRC si le CRC ne correspond pas.
+*****/
+
+ULONG P_DSap_DecodeRecord(struct DataLayerSap *DLayer, UBYTE *RecordPtr, ULONG Track, ULONG Sector, UBYTE *BufferPtr)
+{
+    UBYTE *DataPtr=&RecordPtr[SAP_RECORD_HEADER_SIZE];
+    UWORD Crc;
+
+    if((ULONG)RecordPtr[2]!=Track || (ULONG)RecordPtr[3]!=Sector) return DL_SECTOR_GEO;
+
+    P_DSap_Xor(DLayer,DataPtr,DLayer->SectorSize);
+    Crc=P_DSap_GetCrc(RecordPtr,SAP_RECORD_HEADER_SIZE+DLayer->SectorSize);
+    if(DataPtr[DLayer->SectorSize]!=(UBYTE)(Crc>>8) || DataPtr[DLayer->SectorSize+1]!=(UBYTE)Crc) return DL_SECTOR_CRC;
+
+    Sys_MemCopy(BufferPtr,DataPtr,DLayer->SectorSize);
+
+    return DL_SUCCESS;
+}
+
+
+/*****
+    Construction d'un enregistrement à écrire dans le fichier.
+    Les octets de format et de protection sont ceux lus à l'ouverture (0 pour un
+    secteur ajouté).
+*****/
+
+void P_DSap_EncodeRecord(struct DataLayerSap *DLayer, UBYTE *RecordPtr, ULONG Track, ULONG Sector, const UBYTE *BufferPtr)
+{
+    UBYTE *DataPtr=&RecordPtr[SAP_RECORD_HEADER_SIZE];
+    LONG Idx=(LONG)Track*DLayer->SectorsPerTrack+(LONG)Sector-1;
+    UWORD Crc;
+
+    RecordPtr[0]=DLayer->FormatTablePtr[2*Idx];
+    RecordPtr[1]=DLayer->FormatTablePtr[2*Idx+1];
+    RecordPtr[2]=(UBYTE)Track;
+    RecordPtr[3]=(UBYTE)Sector;
+    Sys_MemCopy(DataPtr,(void *)BufferPtr,DLayer->SectorSize);
+
+    /* Le CRC porte sur les données en clair */
+    Crc=P_DSap_GetCrc(RecordPtr,SAP_RECORD_HEADER_SIZE+DLayer->SectorSize);
+    DataPtr[DLayer->SectorSize]=(UBYTE)(Crc>>8);
+    DataPtr[DLayer->SectorSize+1]=(UBYTE)Crc;
+
+    P_DSap_Xor(DLayer,DataPtr,DLayer->SectorSize);
+}
+
+
+/*****
+    Calcul du CRC de Pukall, un octet par itération
+*****/
+
+UWORD P_DSap_GetCrc(const UBYTE *Ptr, LONG Size)
+{
+    UWORD Crc=0xffff;
+
+    while(--Size>=0) Crc=(Crc>>8)^DSap_CrcTable[(Crc^*(Ptr++))&0xff];
+
+    return Crc;
+}
+
+
+/*****
+    Masquage/démasquage des données d'un secteur, un mot long par itération.
+    Ptr pointe dans RecordBufferPtr, alloué aligné: les données d'un enregistrement ne
+    sont alignées que sur 2 octets, les premiers octets sont donc traités un par un
+    jusqu'au premier mot long aligné.
+*****/
+
+void P_DSap_Xor(struct DataLayerSap *DLayer, UBYTE *Ptr, LONG Size)
+{
+    ULONG *LongPtr;
+    LONG i;
+
+    for(i=(LONG)(Ptr-DLayer->RecordBufferPtr); (i&3)!=0 && Size>0; i++, Size--) *(Ptr++)^=SAP_XOR_BYTE;
+    for(LongPtr=(ULONG *)Ptr, i=Size>>2; i>0; i--) *(LongPtr++)^=SAP_XOR_LONG;
+    for(Ptr=(UBYTE *)LongPtr, i=Size&3; i>0; i--) *(Ptr++)^=SAP_XOR_BYTE;
+}
+
+
+/*****
+    Construction de la table du CRC par octet: chaque entrée correspond à deux
+    passages dans la table par quartet.
+*****/
+
+void P_DSap_InitCrcTable(void)
+{
+    if(!DSap_IsCrcTableOk)
+    {
+        LONG i;
+
+        for(i=0; i<256; i++)
+        {
+            UWORD Crc=(UWORD)(i>>4)^DSap_CrcNibbleTable[i&0xf];
+
+            DSap_CrcTable[i]=(Crc>>4)^DSap_CrcNibbleTable[Crc&0xf];
+        }
+        DSap_IsCrcTableOk=TRUE;
+    }
+}
+
+
+/*****
+    Lecture d'une partie du fichier image
+*****/
+
+BOOL P_DSap_ReadFile(struct DataLayerSap *DLayer, LONG Offset, UBYTE *BufferPtr, LONG Size)
+{
+#ifdef SYSTEM_AMIGA
+    if(Seek(DLayer->FileHandle,Offset,OFFSET_BEGINNING)>=0)
+    {
+        if(Read(DLayer->FileHandle,(APTR)BufferPtr,Size)==Size) return TRUE;
+    }
+#endif
+#ifdef SYSTEM_UNIX
+    if(pread(DLayer->FileDesc,(void *)BufferPtr,(size_t)Size,(off_t)Offset)==(ssize_t)Size) return TRUE;
+#endif
+    return FALSE;
+}
+
+
+/*****
+    Ecriture d'une partie du fichier image
+*****/
+
+BOOL P_DSap_WriteFile(struct DataLayerSap *DLayer, LONG Offset, const UBYTE *BufferPtr, LONG Size)
+{
+#ifdef SYSTEM_AMIGA
+    if(Seek(DLayer->FileHandle,Offset,OFFSET_BEGINNING)>=0)
+    {
+        if(Write(DLayer->FileHandle,(APTR)BufferPtr,Size)==Size) return TRUE;
+    }
+#endif
+#ifdef SYSTEM_UNIX
+    if(pwrite(DLayer->FileDesc,(const void *)BufferPtr,(size_t)Size,(off_t)Offset)==(ssize_t)Size) return TRUE;
+#endif
+    return FALSE;
+}
+
+
+/*****
+    Vérifie que les secteurs demandés sont dans la géométrie de l'image
+*****/
+
+BOOL P_DSap_IsGeoOk(struct DataLayerSap *DLayer, ULONG Track, ULONG Sector, ULONG Count)
+{
+    if((LONG)Track>=DLayer->CountOfTracks || Sector<1) return FALSE;
+    if((LONG)(Sector-1+Count)>DLayer->SectorsPerTrack) return FALSE;
+
+    return TRUE;
+}
@@ -0,0 +1,47 @@
+#ifndef DATALAYERSAP_H
+#define DATALAYERSAP_H
+
+#define SAP_HEADER_SIZE         66      /* Octet de format + signature */
+#define SAP_RECORD_HEADER_SIZE  4       /* Format, protection, piste, secteur */
+#define SAP_RECORD_CRC_SIZE     2
+#define SAP_XOR_BYTE            0xb3
+#define SAP_XOR_LONG            ((ULONG)SAP_XOR_BYTE*0x01010101)
+
+struct DataLayerSap
+{
+#ifdef SYSTEM_AMIGA
+    BPTR FileHandle;
+#endif
+#ifdef SYSTEM_UNIX
+    int FileDesc;
+#endif
+    LONG *OffsetTablePtr;   /* Position dans le fichier de chaque secteur, ou -1 si absent */
+    UBYTE *FormatTablePtr;  /* Octets de format et de protection lus pour chaque secteur */
+    UBYTE *RecordBufferPtr; /* Buffer pour DL_MAX_SECTORS enregistrements */
+    LONG FileSize;
+    LONG RecordSize;
+    LONG SectorSize;
+    LONG SectorsPerTrack;
+    LONG CountOfTracks;
+    BOOL IsProtected;
+    BOOL IsChanged;
+};
+
+
+/***** VARIABLES ET FONCTIONS    *****/
+/***** PUBLIQUES UTILISABLES PAR *****/
+/***** D'AUTRES BLOCS DU PROJET  *****/
+
+extern struct DataLayerSap *DSap_Open(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(struct DataLayerSap *, void *), void *, ULONG *);
+extern void DSap_Close(struct DataLayerSap *);
+extern BOOL DSap_IsDiskIn(struct DataLayerSap *);
+extern BOOL DSap_IsProtected(struct DataLayerSap *);
+extern void DSap_Clean(struct DataLayerSap *);
+extern BOOL DSap_IsChanged(struct DataLayerSap *);
+extern void DSap_SetChanged(struct DataLayerSap *, BOOL);
+extern ULONG DSap_Finalize(struct DataLayerSap *);
+extern ULONG DSap_FormatTrack(struct DataLayerSap *, ULONG, ULONG, const UBYTE *);
+extern ULONG DSap_ReadSectors(struct DataLayerSap *, ULONG, ULONG, ULONG, UBYTE *);
+extern ULONG DSap_WriteSectors(struct DataLayerSap *, ULONG, ULONG, ULONG, const UBYTE *);
+
+#endif  /* DATALAYERSAP_H */
@@ -0,0 +1,375 @@
+#include "system.h"
+#include "datalayersim.h"
+#include "disklayer.h"
+#include "debug.h"
+
+#ifdef SYSTEM_AMIGA
+#include <devices/trackdisk.h>
+#include <devices/todisk.h>
+#else
+#define TO_DFLT_INTERLEAVE 7
+#endif
+
+/*
+    17-10-2026 (Seg)    Ajout de DSim_SetProtected() et DSim_ChangeDisk(), transmis à la source
+                        simulée; DSim_GetStats() peut remettre les statistiques à zéro
+    17-10-2026 (Seg)    Une piste complète est transférée en un seul tour, comme par le device
+    17-10-2026 (Seg)    Ajout de DSim_Sync()
+    17-10-2026 (Seg)    L'arrêt du moteur passe par DSim_MotorOff()
+    17-10-2026 (Seg)    Simulation des temps d'accès d'un lecteur de disquette
+*/
+
+
+/***** Prototypes */
+struct DataLayerSim *DSim_Open(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(void *, void *), void *, ULONG *);
+void DSim_Close(struct DataLayerSim *);
+BOOL DSim_IsDiskIn(struct DataLayerSim *);
+BOOL DSim_IsProtected(struct DataLayerSim *);
+void DSim_Clean(struct DataLayerSim *);
+BOOL DSim_IsChanged(struct DataLayerSim *);
+void DSim_SetChanged(struct DataLayerSim *, BOOL);
+ULONG DSim_Finalize(struct DataLayerSim *);
+void DSim_MotorOff(struct DataLayerSim *);
+ULONG DSim_Sync(struct DataLayerSim *);
+ULONG DSim_FormatTrack(struct DataLayerSim *, ULONG, ULONG, const UBYTE *);
+ULONG DSim_ReadSectors(struct DataLayerSim *, ULONG, ULONG, ULONG, UBYTE *);
+ULONG DSim_WriteSectors(struct DataLayerSim *, ULONG, ULONG, ULONG, const UBYTE *);
+BOOL DSim_SetProtected(struct DataLayerSim *, BOOL);
+BOOL DSim_ChangeDisk(struct DataLayerSim *, BOOL);
+BOOL DSim_GetStats(struct DataLayerSim *, struct DataLayerSimStats *, BOOL);
+void DSim_ResetStats(struct DataLayerSim *);
+
+void P_DSim_Seek(struct DataLayerSim *, ULONG);
+void P_DSim_Transfer(struct DataLayerSim *, ULONG, ULONG, ULONG);
+void P_DSim_WaitSlot(struct DataLayerSim *, LONG);
+void P_DSim_AddTime(struct DataLayerSim *, ULONG);
+
+
+/*****
+    Ouverture d'un lecteur simulé.
+    Les accès sont transmis à la source donnée après le préfixe (@sim:<source>, un disque
+    virtuel en mémoire par défaut), et chaque opération est comptée en temps simulé
+    d'après le modèle d'un lecteur réel: démarrage du moteur, déplacement et stabilisation
+    de la tête, attente du passage des secteurs dans l'ordre de l'entrelacement.
+    * Paramètres:
+      Name: @sim:<source>
+      Les autres paramètres sont transmis à la source simulée (voir DL_Open())
+    * Retourne:
+      - NULL si échec
+      - pointeur vers une structure DataLayerSim si succès
+*****/
+
+struct DataLayerSim *DSim_Open(const char *Name, ULONG Flags, ULONG Unit, ULONG Side, LONG CountOfTracks, LONG SectorPerTrack, LONG SectorSize, void (*IntFuncPtr)(void *, void *), void *IntData, ULONG *ErrorCode)
+{
+    struct DataLayerSim *DLayer=(struct DataLayerSim *)Sys_AllocMem(sizeof(struct DataLayerSim));
+
+    *ErrorCode=DL_NOT_ENOUGH_MEMORY;
+    if(DLayer!=NULL)
+    {
+        const char *SourceName=&Name[Sys_StrLen(SIM_NAME_PREFIX)];
+
+        if(*SourceName==':') SourceName++;
+        if(*SourceName==0) SourceName=SIM_DEFAULT_SOURCE;
+
+        DLayer->SectorsPerTrack=SectorPerTrack;
+        DLayer->CountOfTracks=CountOfTracks;
+
+        if((DLayer->InterleaveTablePtr=(UBYTE *)Sys_AllocMem(CountOfTracks))!=NULL)
+        {
+            ULONG Type=DL_GetTypeFromName(SourceName);
+            LONG i;
+
+            for(i=0; i<CountOfTracks; i++) DLayer->InterleaveTablePtr[i]=TO_DFLT_INTERLEAVE;
+
+            /* On ne simule pas une source déjà simulée */
+            *ErrorCode=DL_UNKNOWN_TYPE;
+            if(Type!=DISKLAYER_TYPE_SIM && (DLayer->FuncsPtr=DL_FuncsTable[Type])!=NULL)
+            {
+                DLayer->DataLayerPtr=DLayer->FuncsPtr->Open(SourceName,Flags,Unit,Side,CountOfTracks,SectorPerTrack,SectorSize,IntFuncPtr,IntData,ErrorCode);
+            }
+        }
+
+        if(DLayer->DataLayerPtr==NULL)
+        {
+            DSim_Close(DLayer);
+            DLayer=NULL;
+        }
+    }
+
+    return DLayer;
+}
+
+
+/*****
+    Libération des ressources allouées par DSim_Open()
+*****/
+
+void DSim_Close(struct DataLayerSim *DLayer)
+{
+    if(DLayer!=NULL)
+    {
+        if(DLayer->DataLayerPtr!=NULL)
+        {
+            Debug(T("DSim: %ld.%06lds, %ld spin-ups, %ld seeks (%ld steps), %ld reads, %ld writes, %ld formats, %ld sectors",
+                DLayer->Stats.Seconds,DLayer->Stats.Micros,DLayer->Stats.CountOfSpinUps,DLayer->Stats.CountOfSeeks,DLayer->Stats.CountOfSteps,
+                DLayer->Stats.CountOfReads,DLayer->Stats.CountOfWrites,DLayer->Stats.CountOfFormats,DLayer->Stats.CountOfSectors));
+            DLayer->FuncsPtr->Close(DLayer->DataLayerPtr);
+        }
+        Sys_FreeMem((void *)DLayer->InterleaveTablePtr);
+        Sys_FreeMem((void *)DLayer);
+    }
+}
+
+
+/*****
+    Pour vérifier si un disque est présent
+*****/
+
+BOOL DSim_IsDiskIn(struct DataLayerSim *DLayer)
+{
+    return DLayer->FuncsPtr->IsDiskIn(DLayer->DataLayerPtr);
+}
+
+
+/*****
+    Pour vérifier si le disque est protégé
+*****/
+
+BOOL DSim_IsProtected(struct DataLayerSim *DLayer)
+{
+    return DLayer->FuncsPtr->IsProtected(DLayer->DataLayerPtr);
+}
+
+
+/*****
+    Nettoyage des caches
+*****/
+
+void DSim_Clean(struct DataLayerSim *DLayer)
+{
+    DLayer->FuncsPtr->Clean(DLayer->DataLayerPtr);
+}
+
+
+/*****
+    Test si le disque a changé
+*****/
+
+BOOL DSim_IsChanged(struct DataLayerSim *DLayer)
+{
+    return DLayer->FuncsPtr->IsChanged(DLayer->DataLayerPtr);
+}
+
+
+/*****
+    Pour changer le flag de changement de disque
+*****/
+
+void DSim_SetChanged(struct DataLayerSim *DLayer, BOOL IsChanged)
+{
+    DLayer->FuncsPtr->SetChanged(DLayer->DataLayerPtr,IsChanged);
+}
+
+
+/*****
+    Fin des opérations
+*****/
+
+ULONG DSim_Finalize(struct DataLayerSim *DLayer)
+{
+    return DLayer->FuncsPtr->Finalize(DLayer->DataLayerPtr);
+}
+
+
+/*****
+    Arrêt du moteur: le prochain accès comptera un démarrage
+*****/
+
+void DSim_MotorOff(struct DataLayerSim *DLayer)
+{
+    DLayer->IsMotorOn=FALSE;
+    if(DLayer->FuncsPtr->MotorOff!=NULL) DLayer->FuncsPtr->MotorOff(DLayer->DataLayerPtr);
+}
+
+
+/*****
+    Attente de la fin des écritures de la source simulée
+*****/
+
+ULONG DSim_Sync(struct DataLayerSim *DLayer)
+{
+    if(DLayer->FuncsPtr->Sync!=NULL) return DLayer->FuncsPtr->Sync(DLayer->DataLayerPtr);
+    return DL_SUCCESS;
+}
+
+
+/*****
+    Protection logicielle du disque, si la source simulée le permet
+*****/
+
+BOOL DSim_SetProtected(struct DataLayerSim *DLayer, BOOL IsProtected)
+{
+    if(DLayer->FuncsPtr->SetProtected!=NULL) return DLayer->FuncsPtr->SetProtected(DLayer->DataLayerPtr,IsProtected);
+    return FALSE;
+}
+
+
+/*****
+    Insertion ou retrait du disque, si la source simulée le permet
+*****/
+
+BOOL DSim_ChangeDisk(struct DataLayerSim *DLayer, BOOL IsDiskIn)
+{
+    if(DLayer->FuncsPtr->ChangeDisk!=NULL) return DLayer->FuncsPtr->ChangeDisk(DLayer->DataLayerPtr,IsDiskIn);
+    return FALSE;
+}
+
+
+/*****
+    Formatage d'une piste: une attente du début de piste, puis un tour complet.
+    L'entrelacement demandé est retenu pour les accès suivants à cette piste.
+*****/
+
+ULONG DSim_FormatTrack(struct DataLayerSim *DLayer, ULONG Track, ULONG Interleave, const UBYTE *BufferPtr)
+{
+    if((LONG)Track<DLayer->CountOfTracks)
+    {
+        P_DSim_Seek(DLayer,Track);
+        P_DSim_WaitSlot(DLayer,0);
+        P_DSim_AddTime(DLayer,SIM_REVOLUTION_TIME);
+        DLayer->InterleaveTablePtr[Track]=(UBYTE)Interleave;
+        DLayer->Stats.CountOfFormats++;
+    }
+
+    return DLayer->FuncsPtr->FormatTrack(DLayer->DataLayerPtr,Track,Interleave,BufferPtr);
+}
+
+
+/*****
+    Lecture de plusieurs secteurs consécutifs d'une piste
+*****/
+
+ULONG DSim_ReadSectors(struct DataLayerSim *DLayer, ULONG Track, ULONG Sector, ULONG Count, UBYTE *BufferPtr)
+{
+    P_DSim_Transfer(DLayer,Track,Sector,Count);
+    DLayer->Stats.CountOfReads++;
+
+    return DLayer->FuncsPtr->ReadSectors(DLayer->DataLayerPtr,Track,Sector,Count,BufferPtr);
+}
+
+
+/*****
+    Ecriture de plusieurs secteurs consécutifs d'une piste
+*****/
+
+ULONG DSim_WriteSectors(struct DataLayerSim *DLayer, ULONG Track, ULONG Sector, ULONG Count, const UBYTE *BufferPtr)
+{
+    P_DSim_Transfer(DLayer,Track,Sector,Count);
+    DLayer->Stats.CountOfWrites++;
+
+    return DLayer->FuncsPtr->WriteSectors(DLayer->DataLayerPtr,Track,Sector,Count,BufferPtr);
+}
+
+
+/*****
+    Lecture des statistiques et du temps simulé depuis l'ouverture ou le dernier
+    DSim_ResetStats(). Le handler les retourne par ACTION_TOFS_GETSIMSTATS (voir
+    DL_GetSimStats()). Si IsReset vaut TRUE, elles sont ensuite remises à zéro.
+    Retourne toujours TRUE.
+*****/
+
+BOOL DSim_GetStats(struct DataLayerSim *DLayer, struct DataLayerSimStats *StatsPtr, BOOL IsReset)
+{
+    *StatsPtr=DLayer->Stats;
+    if(IsReset) DSim_ResetStats(DLayer);
+    return TRUE;
+}
+
+
+/*****
+    Remise à zéro des statistiques et du temps simulé
+*****/
+
+void DSim_ResetStats(struct DataLayerSim *DLayer)
+{
+    struct DataLayerSimStats Empty={0};
+
+    DLayer->Stats=Empty;
+}
+
+
+/*****
+    Déplacement de la tête sur une piste, avec démarrage du moteur si nécessaire
+*****/
+
+void P_DSim_Seek(struct DataLayerSim *DLayer, ULONG Track)
+{
+    if(!DLayer->IsMotorOn)
+    {
+        P_DSim_AddTime(DLayer,SIM_SPINUP_TIME);
+        DLayer->IsMotorOn=TRUE;
+        DLayer->Stats.CountOfSpinUps++;
+    }
+
+    if((LONG)Track!=DLayer->HeadTrack)
+    {
+        LONG Steps=(LONG)Track-DLayer->HeadTrack;
+
+        if(Steps<0) Steps=-Steps;
+        P_DSim_AddTime(DLayer,(ULONG)Steps*SIM_STEP_TIME+SIM_SETTLE_TIME);
+        DLayer->HeadTrack=(LONG)Track;
+        DLayer->Stats.CountOfSeeks++;
+        DLayer->Stats.CountOfSteps+=(ULONG)Steps;
+    }
+}
+
+
+/*****
+    Transfert de secteurs: comme le device, les secteurs sont traités dans
+    l'ordre logique, chacun après l'attente de son passage sous la tête.
+    Une piste complète est lue ou écrite d'un bloc, en un tour quel que soit
+    l'entrelacement.
+*****/
+
+void P_DSim_Transfer(struct DataLayerSim *DLayer, ULONG Track, ULONG Sector, ULONG Count)
+{
+    if((LONG)Track<DLayer->CountOfTracks && Sector>=1 && (LONG)(Sector-1+Count)<=DLayer->SectorsPerTrack)
+    {
+        LONG Interleave=(LONG)DLayer->InterleaveTablePtr[Track];
+        ULONG i;
+
+        P_DSim_Seek(DLayer,Track);
+        if((LONG)Count==DLayer->SectorsPerTrack) P_DSim_AddTime(DLayer,SIM_REVOLUTION_TIME);
+        else for(i=0; i<Count; i++)
+        {
+            P_DSim_WaitSlot(DLayer,DL_GetPhysicalSlot(Interleave,DLayer->SectorsPerTrack,(LONG)(Sector+i)));
+            P_DSim_AddTime(DLayer,SIM_REVOLUTION_TIME/DLayer->SectorsPerTrack);
+        }
+        DLayer->Stats.CountOfSectors+=Count;
+    }
+}
+
+
+/*****
+    Attente du passage du début d'une position physique sous la tête
+*****/
+
+void P_DSim_WaitSlot(struct DataLayerSim *DLayer, LONG Slot)
+{
+    ULONG Target=(ULONG)Slot*(SIM_REVOLUTION_TIME/DLayer->SectorsPerTrack);
+
+    P_DSim_AddTime(DLayer,(Target+SIM_REVOLUTION_TIME-DLayer->Angle)%SIM_REVOLUTION_TIME);
+}
+
+
+/*****
+    Avance de l'horloge virtuelle et de la position du disque
+*****/
+
+void P_DSim_AddTime(struct DataLayerSim *DLayer, ULONG Micros)
+{
+    DLayer->Angle=(DLayer->Angle+Micros)%SIM_REVOLUTION_TIME;
+    DLayer->Stats.Micros+=Micros;
+    DLayer->Stats.Seconds+=DLayer->Stats.Micros/1000000;
+    DLayer->Stats.Micros%=1000000;
+}
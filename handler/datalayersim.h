@@ -0,0 +1,63 @@
+#ifndef DATALAYERSIM_H
+#define DATALAYERSIM_H
+
+#define SIM_NAME_PREFIX         "@sim"  /* Nom de la source: @sim:<source simulée> */
+#define SIM_DEFAULT_SOURCE      "@ram"
+
+/* Modèle de temps d'un lecteur 3"1/2 à 300 tours/minute (en microsecondes) */
+#define SIM_REVOLUTION_TIME     200000
+#define SIM_STEP_TIME           6000    /* Déplacement de la tête d'une piste */
+#define SIM_SETTLE_TIME         15000   /* Stabilisation de la tête après un déplacement */
+#define SIM_SPINUP_TIME         500000  /* Démarrage du moteur */
+
+struct DataLayerSimStats
+{
+    ULONG Seconds;          /* Temps simulé total */
+    ULONG Micros;
+    ULONG CountOfSpinUps;
+    ULONG CountOfSeeks;
+    ULONG CountOfSteps;
+    ULONG CountOfReads;
+    ULONG CountOfWrites;
+    ULONG CountOfFormats;
+    ULONG CountOfSectors;
+};
+
+
+struct DataLayerSim
+{
+    const struct DataLayerFuncs *FuncsPtr;  /* Couche de données simulée */
+    void *DataLayerPtr;
+    UBYTE *InterleaveTablePtr;  /* Entrelacement de chaque piste */
+    LONG SectorsPerTrack;
+    LONG CountOfTracks;
+    LONG HeadTrack;
+    ULONG Angle;                /* Position du disque sous la tête, en microsecondes */
+    BOOL IsMotorOn;
+    struct DataLayerSimStats Stats;
+};
+
+
+/***** VARIABLES ET FONCTIONS    *****/
+/***** PUBLIQUES UTILISABLES PAR *****/
+/***** D'AUTRES BLOCS DU PROJET  *****/
+
+extern struct DataLayerSim *DSim_Open(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(void *, void *), void *, ULONG *);
+extern void DSim_Close(struct DataLayerSim *);
+extern BOOL DSim_IsDiskIn(struct DataLayerSim *);
+extern BOOL DSim_IsProtected(struct DataLayerSim *);
+extern void DSim_Clean(struct DataLayerSim *);
+extern BOOL DSim_IsChanged(struct DataLayerSim *);
+extern void DSim_SetChanged(struct DataLayerSim *, BOOL);
+extern ULONG DSim_Finalize(struct DataLayerSim *);
+extern void DSim_MotorOff(struct DataLayerSim *);
+extern ULONG DSim_Sync(struct DataLayerSim *);
+extern ULONG DSim_FormatTrack(struct DataLayerSim *, ULONG, ULONG, const UBYTE *);
+extern ULONG DSim_ReadSectors(struct DataLayerSim *, ULONG, ULONG, ULONG, UBYTE *);
+extern ULONG DSim_WriteSectors(struct DataLayerSim *, ULONG, ULONG, ULONG, const UBYTE *);
+extern BOOL DSim_SetProtected(struct DataLayerSim *, BOOL);
+extern BOOL DSim_ChangeDisk(struct DataLayerSim *, BOOL);
+extern BOOL DSim_GetStats(struct DataLayerSim *, struct DataLayerSimStats *, BOOL);
+extern void DSim_ResetStats(struct DataLayerSim *);
+
+#endif  /* DATALAYERSIM_H */
@@ -0,0 +1,641 @@
+#include "system.h"
+#include "datalayertds.h"
+#include "disklayer.h"
+
+#ifdef SYSTEM_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*
+    17-10-2026 (Seg)    Après un échec de la réécriture, les secteurs restent lus au bon endroit
+                        et seule la partie manquante est retentée
+    17-10-2026 (Seg)    La réécriture ne porte plus que sur la table de présence et les
+                        secteurs qui suivent le premier secteur ajouté
+    17-10-2026 (Seg)    Gestion des images disque .tds
+*/
+
+
+/***** Prototypes */
+struct DataLayerTds *DTds_Open(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(struct DataLayerTds *, void *), void *, ULONG *);
+void DTds_Close(struct DataLayerTds *);
+BOOL DTds_IsDiskIn(struct DataLayerTds *);
+BOOL DTds_IsProtected(struct DataLayerTds *);
+void DTds_Clean(struct DataLayerTds *);
+BOOL DTds_IsChanged(struct DataLayerTds *);
+void DTds_SetChanged(struct DataLayerTds *, BOOL);
+ULONG DTds_Finalize(struct DataLayerTds *);
+ULONG DTds_FormatTrack(struct DataLayerTds *, ULONG, ULONG, const UBYTE *);
+ULONG DTds_ReadSectors(struct DataLayerTds *, ULONG, ULONG, ULONG, UBYTE *);
+ULONG DTds_WriteSectors(struct DataLayerTds *, ULONG, ULONG, ULONG, const UBYTE *);
+
+ULONG P_DTds_OpenFile(struct DataLayerTds *, const char *, LONG *);
+ULONG P_DTds_BuildIndex(struct DataLayerTds *, LONG);
+LONG P_DTds_SetOffsets(struct DataLayerTds *, const UBYTE *);
+ULONG P_DTds_Rewrite(struct DataLayerTds *);
+ULONG P_DTds_WriteMap(struct DataLayerTds *);
+BOOL P_DTds_KeepTail(struct DataLayerTds *, const UBYTE *, LONG);
+void P_DTds_FreeOverlays(struct DataLayerTds *);
+LONG P_DTds_GetRunLength(struct DataLayerTds *, LONG, LONG);
+BOOL P_DTds_IsBlank(const UBYTE *, LONG);
+BOOL P_DTds_ReadFile(struct DataLayerTds *, LONG, UBYTE *, LONG);
+BOOL P_DTds_WriteFile(struct DataLayerTds *, LONG, const UBYTE *, LONG);
+BOOL P_DTds_IsGeoOk(struct DataLayerTds *, ULONG, ULONG, ULONG);
+
+
+/*****
+    Ouverture d'une image disque .tds.
+    Une image .tds est une copie creuse d'une face: une table de présence (un bit par
+    secteur, dans l'ordre piste/secteur, bit de poids fort en premier), suivie des seuls
+    secteurs présents. La position de chaque secteur est calculée à l'ouverture; un
+    secteur absent est rendu comme un secteur vierge sans accès au fichier.
+    * Paramètres:
+      FileName: nom du fichier image
+      Flags: non utilisé
+      Unit: non utilisé
+      Side: non utilisé (une image .tds ne contient qu'une face)
+      CountOfTracks: nombre de pistes
+      SectorPerTrack: pour indiquer le nombre de secteurs par piste
+      SectorSize: pour indiquer la taille d'un secteur
+      IntFuncPtr: non utilisé (pas de changement de disque possible)
+      IntData: non utilisé
+      ErrorCode: pointeur vers un ULONG pour retourner un code d'erreur ou DL_SUCCESS
+    * Retourne:
+      - NULL si échec
+      - pointeur vers une structure DataLayerTds si succès
+*****/
+
+struct DataLayerTds *DTds_Open(const char *FileName, ULONG Flags, ULONG Unit, ULONG Side, LONG CountOfTracks, LONG SectorPerTrack, LONG SectorSize, void (*IntFuncPtr)(struct DataLayerTds *, void *), void *IntData, ULONG *ErrorCode)
+{
+    struct DataLayerTds *DLayer=(struct DataLayerTds *)Sys_AllocMem(sizeof(struct DataLayerTds));
+
+    *ErrorCode=DL_NOT_ENOUGH_MEMORY;
+    if(DLayer!=NULL)
+    {
+        LONG CountOfSectors=CountOfTracks*SectorPerTrack;
+        LONG FileSize;
+
+#ifdef SYSTEM_UNIX
+        DLayer->FileDesc=-1;
+#endif
+        DLayer->MapSize=(CountOfSectors+7)/8;
+        DLayer->SectorSize=SectorSize;
+        DLayer->SectorsPerTrack=SectorPerTrack;
+        DLayer->CountOfTracks=CountOfTracks;
+        DLayer->IsChanged=FALSE;
+
+        DLayer->OffsetTablePtr=(LONG *)Sys_AllocMem(sizeof(LONG)*CountOfSectors);
+        DLayer->OverlayTablePtr=(UBYTE **)Sys_AllocMem(sizeof(UBYTE *)*CountOfSectors);
+        if(DLayer->OffsetTablePtr!=NULL && DLayer->OverlayTablePtr!=NULL)
+        {
+            if((*ErrorCode=P_DTds_OpenFile(DLayer,FileName,&FileSize))==DL_SUCCESS)
+            {
+                *ErrorCode=P_DTds_BuildIndex(DLayer,FileSize);
+            }
+        }
+
+        if(*ErrorCode!=DL_SUCCESS)
+        {
+            DTds_Close(DLayer);
+            DLayer=NULL;
+        }
+    }
+
+    return DLayer;
+}
+
+
+/*****
+    Libération des ressources allouées par DTds_Open().
+    Les secteurs ajoutés depuis le dernier DTds_Finalize() sont reportés dans le fichier.
+    Une erreur ne peut plus être signalée à ce stade: le handler fait donc un
+    DTds_Finalize() (via ACTION_DIE) avant la fermeture.
+*****/
+
+void DTds_Close(struct DataLayerTds *DLayer)
+{
+    if(DLayer!=NULL)
+    {
+        if(DLayer->CountOfOverlays>0 || DLayer->IsMapPending) DTds_Finalize(DLayer);
+#ifdef SYSTEM_AMIGA
+        if(DLayer->FileHandle) Close(DLayer->FileHandle);
+#endif
+#ifdef SYSTEM_UNIX
+        if(DLayer->FileDesc>=0) close(DLayer->FileDesc);
+#endif
+        if(DLayer->OverlayTablePtr!=NULL) P_DTds_FreeOverlays(DLayer);
+        Sys_FreeMem((void *)DLayer->OverlayTablePtr);
+        Sys_FreeMem((void *)DLayer->OffsetTablePtr);
+        Sys_FreeMem((void *)DLayer);
+    }
+}
+
+
+/*****
+    Pour vérifier si un disque est présent (toujours vrai pour une image)
+*****/
+
+BOOL DTds_IsDiskIn(struct DataLayerTds *DLayer)
+{
+    return TRUE;
+}
+
+
+/*****
+    Pour vérifier si l'image est protégée en écriture
+*****/
+
+BOOL DTds_IsProtected(struct DataLayerTds *DLayer)
+{
+    return DLayer->IsProtected;
+}
+
+
+/*****
+    Nettoyage des caches (rien à faire pour une image)
+*****/
+
+void DTds_Clean(struct DataLayerTds *DLayer)
+{
+}
+
+
+/*****
+    Test si le disque a changé
+*****/
+
+BOOL DTds_IsChanged(struct DataLayerTds *DLayer)
+{
+    return DLayer->IsChanged;
+}
+
+
+/*****
+    Pour changer le flag de changement de disque
+*****/
+
+void DTds_SetChanged(struct DataLayerTds *DLayer, BOOL IsChanged)
+{
+    DLayer->IsChanged=IsChanged;
+}
+
+
+/*****
+    Les secteurs présents sont écrits directement dans le fichier. S'il y a des
+    secteurs ajoutés depuis la dernière réécriture, le fichier est réécrit avec la
+    nouvelle table de présence. En cas d'échec, les secteurs ajoutés restent en mémoire
+    et la réécriture sera retentée au prochain appel (voir P_DTds_Rewrite()).
+*****/
+
+ULONG DTds_Finalize(struct DataLayerTds *DLayer)
+{
+    if(DLayer->CountOfOverlays>0) return P_DTds_Rewrite(DLayer);
+    if(DLayer->IsMapPending) return P_DTds_WriteMap(DLayer);
+
+    return DL_SUCCESS;
+}
+
+
+/*****
+    Formatage d'une piste: les secteurs de la piste sont simplement réécrits
+    * Paramètres:
+      DLayer: structure allouée par DTds_Open()
+      Track: piste à formater
+      Interleave: non utilisé
+      BufferPtr: pointeur vers les données qui vont servir initialiser la piste.
+        Ce buffer doit avoir pour taille le nombre d'octets par secteur multiplié
+        par le nombre de secteurs par piste.
+    * Retourne:
+      Code d'erreur ou DL_SUCCESS
+*****/
+
+ULONG DTds_FormatTrack(struct DataLayerTds *DLayer, ULONG Track, ULONG Interleave, const UBYTE *BufferPtr)
+{
+    return DTds_WriteSectors(DLayer,Track,1,(ULONG)DLayer->SectorsPerTrack,BufferPtr);
+}
+
+
+/*****
+    Lecture de plusieurs secteurs consécutifs d'une piste.
+    Les secteurs présents consécutifs sont lus en une seule fois; les secteurs absents
+    sont remplis sans accès au fichier.
+    * Paramètres:
+      DLayer: structure allouée par DTds_Open()
+      Track: numéro de piste à lire
+      Sector: numéro du premier secteur de la piste à lire
+      Count: nombre de secteurs à lire
+      BufferPtr: récipiant pour recevoir les secteurs lus
+    * Retourne:
+      Code d'erreur ou DL_SUCCESS
+*****/
+
+ULONG DTds_ReadSectors(struct DataLayerTds *DLayer, ULONG Track, ULONG Sector, ULONG Count, UBYTE *BufferPtr)
+{
+    LONG Idx=(LONG)(Track*DLayer->SectorsPerTrack+Sector-1);
+    LONG LastIdx=Idx+(LONG)Count;
+
+    if(!P_DTds_IsGeoOk(DLayer,Track,Sector,Count)) return DL_SECTOR_GEO;
+
+    while(Idx<LastIdx)
+    {
+        LONG Offset=DLayer->OffsetTablePtr[Idx];
+        LONG Length=1;
+
+        if(Offset>=0)
+        {
+            Length=P_DTds_GetRunLength(DLayer,Idx,LastIdx);
+            if(!P_DTds_ReadFile(DLayer,Offset,BufferPtr,Length*DLayer->SectorSize)) return DL_READ_FILE;
+        }
+        else if(DLayer->OverlayTablePtr[Idx]!=NULL) Sys_MemCopy(BufferPtr,DLayer->OverlayTablePtr[Idx],DLayer->SectorSize);
+        else
+        {
+            LONG i;
+
+            for(i=0; i<DLayer->SectorSize; i++) BufferPtr[i]=TDS_BLANK_BYTE;
+        }
+
+        BufferPtr+=Length*DLayer->SectorSize;
+        Idx+=Length;
+    }
+
+    return DL_SUCCESS;
+}
+
+
+/*****
+    Ecriture de plusieurs secteurs consécutifs d'une piste.
+    Les secteurs présents dans le fichier sont réécrits sur place. Les secteurs absents
+    sont gardés en mémoire jusqu'au prochain DTds_Finalize(), sauf s'ils restent vierges.
+    * Paramètres:
+      DLayer: structure allouée par DTds_Open()
+      Track: numéro de piste à écrire
+      Sector: numéro du premier secteur de la piste à écrire
+      Count: nombre de secteurs à écrire
+      BufferPtr: pointeur vers les données des secteurs à écrire
+    * Retourne:
+      Code d'erreur ou DL_SUCCESS
+*****/
+
+ULONG DTds_WriteSectors(struct DataLayerTds *DLayer, ULONG Track, ULONG Sector, ULONG Count, const UBYTE *BufferPtr)
+{
+    LONG Idx=(LONG)(Track*DLayer->SectorsPerTrack+Sector-1);
+    LONG LastIdx=Idx+(LONG)Count;
+
+    if(DLayer->IsProtected) return DL_PROTECTED;
+    if(!P_DTds_IsGeoOk(DLayer,Track,Sector,Count)) return DL_SECTOR_GEO;
+
+    while(Idx<LastIdx)
+    {
+        LONG Offset=DLayer->OffsetTablePtr[Idx];
+        LONG Length=1;
+
+        if(Offset>=0)
+        {
+            Length=P_DTds_GetRunLength(DLayer,Idx,LastIdx);
+            if(!P_DTds_WriteFile(DLayer,Offset,BufferPtr,Length*DLayer->SectorSize)) return DL_WRITE_FILE;
+        }
+        else if(DLayer->OverlayTablePtr[Idx]!=NULL || !P_DTds_IsBlank(BufferPtr,DLayer->SectorSize))
+        {
+            if(DLayer->OverlayTablePtr[Idx]==NULL)
+            {
+                if((DLayer->OverlayTablePtr[Idx]=(UBYTE *)Sys_AllocMem(DLayer->SectorSize))==NULL) return DL_NOT_ENOUGH_MEMORY;
+                if(!DLayer->CountOfOverlays || Idx<DLayer->FirstOverlayIdx) DLayer->FirstOverlayIdx=Idx;
+                DLayer->CountOfOverlays++;
+            }
+            Sys_MemCopy(DLayer->OverlayTablePtr[Idx],(void *)BufferPtr,DLayer->SectorSize);
+        }
+
+        BufferPtr+=Length*DLayer->SectorSize;
+        Idx+=Length;
+    }
+
+    return DL_SUCCESS;
+}
+
+
+/*****
+    Ouverture du fichier image.
+    L'image est en lecture seule si le fichier est protégé en écriture.
+*****/
+
+ULONG P_DTds_OpenFile(struct DataLayerTds *DLayer, const char *FileName, LONG *FileSizePtr)
+{
+    ULONG ErrorCode=DL_OPEN_FILE;
+#ifdef SYSTEM_AMIGA
+    struct FileInfoBlock *FibPtr;
+
+    if((FibPtr=(struct FileInfoBlock *)Sys_AllocMem(sizeof(struct FileInfoBlock)))==NULL) return DL_NOT_ENOUGH_MEMORY;
+
+    if((DLayer->FileHandle=Open((STRPTR)FileName,MODE_OLDFILE))!=0)
+    {
+        if(ExamineFH(DLayer->FileHandle,FibPtr))
+        {
+            /* Les bits de protection sont actifs à 0 */
+            DLayer->IsProtected=(FibPtr->fib_Protection&FIBF_WRITE)?TRUE:FALSE;
+            *FileSizePtr=FibPtr->fib_Size;
+            ErrorCode=DL_SUCCESS;
+        }
+    }
+
+    Sys_FreeMem((void *)FibPtr);
+#endif
+#ifdef SYSTEM_UNIX
+    DLayer->IsProtected=FALSE;
+    if((DLayer->FileDesc=open(FileName,O_RDWR))<0)
+    {
+        DLayer->IsProtected=TRUE;
+        DLayer->FileDesc=open(FileName,O_RDONLY);
+    }
+
+    if(DLayer->FileDesc>=0)
+    {
+        *FileSizePtr=(LONG)lseek(DLayer->FileDesc,0,SEEK_END);
+        if(*FileSizePtr>=0) ErrorCode=DL_SUCCESS;
+    }
+#endif
+    return ErrorCode;
+}
+
+
+/*****
+    Lecture de la table de présence et calcul de la position de chaque secteur
+*****/
+
+ULONG P_DTds_BuildIndex(struct DataLayerTds *DLayer, LONG FileSize)
+{
+    ULONG ErrorCode=DL_NOT_ENOUGH_MEMORY;
+    UBYTE *MapPtr=(UBYTE *)Sys_AllocMem(DLayer->MapSize);
+
+    if(MapPtr!=NULL)
+    {
+        ErrorCode=DL_READ_FILE;
+        if(FileSize>=DLayer->MapSize && P_DTds_ReadFile(DLayer,0,MapPtr,DLayer->MapSize))
+        {
+            /* Les secteurs annoncés doivent tous être dans le fichier */
+            if(P_DTds_SetOffsets(DLayer,MapPtr)<=FileSize) ErrorCode=DL_SUCCESS;
+        }
+        Sys_FreeMem((void *)MapPtr);
+    }
+
+    return ErrorCode;
+}
+
+
+/*****
+    Calcul de la position de chaque secteur d'après la table de présence.
+    Retourne la taille de fichier correspondante.
+*****/
+
+LONG P_DTds_SetOffsets(struct DataLayerTds *DLayer, const UBYTE *MapPtr)
+{
+    LONG CountOfSectors=DLayer->CountOfTracks*DLayer->SectorsPerTrack;
+    LONG Offset=DLayer->MapSize;
+    LONG i;
+
+    for(i=0; i<CountOfSectors; i++)
+    {
+        DLayer->OffsetTablePtr[i]=-1;
+        if(MapPtr[i>>3]&(0x80>>(i&7)))
+        {
+            DLayer->OffsetTablePtr[i]=Offset;
+            Offset+=DLayer->SectorSize;
+        }
+    }
+
+    return Offset;
+}
+
+
+/*****
+    Réécriture du fichier pour y intégrer les secteurs ajoutés.
+    Les secteurs présents avant le premier secteur ajouté ne bougent pas: seuls la table de
+    présence et les secteurs qui suivent sont réécrits. Les secteurs présents de cette
+    partie sont relus en une fois, puis la partie est reconstruite en mémoire.
+    La table de présence n'est écrite qu'après les secteurs: dès que ceux-ci sont écrits,
+    les positions en mémoire suivent la nouvelle disposition, et seule l'écriture de la
+    table reste à retenter en cas d'échec. Si l'écriture des secteurs échoue, la partie du
+    fichier concernée n'est plus fiable: ses secteurs sont gardés en mémoire.
+*****/
+
+ULONG P_DTds_Rewrite(struct DataLayerTds *DLayer)
+{
+    ULONG ErrorCode=DL_NOT_ENOUGH_MEMORY;
+    LONG CountOfSectors=DLayer->CountOfTracks*DLayer->SectorsPerTrack;
+    LONG TailOffset=DLayer->MapSize;
+    LONG CountOfPresents=0;
+    LONG TailSize,i;
+    UBYTE *MapPtr,*OldPtr,*NewPtr;
+
+    for(i=0; i<CountOfSectors; i++)
+    {
+        if(DLayer->OffsetTablePtr[i]>=0)
+        {
+            if(i<DLayer->FirstOverlayIdx) TailOffset+=DLayer->SectorSize;
+            else CountOfPresents++;
+        }
+    }
+    TailSize=(CountOfPresents+DLayer->CountOfOverlays)*DLayer->SectorSize;
+
+    if((MapPtr=(UBYTE *)Sys_AllocMem(DLayer->MapSize))!=NULL)
+    {
+        if((NewPtr=(UBYTE *)Sys_AllocMem(TailSize))!=NULL)
+        {
+            if((OldPtr=(UBYTE *)Sys_AllocMem(CountOfPresents*DLayer->SectorSize+1))!=NULL)
+            {
+                ErrorCode=DL_READ_FILE;
+                if(P_DTds_ReadFile(DLayer,TailOffset,OldPtr,CountOfPresents*DLayer->SectorSize))
+                {
+                    LONG Offset=0;
+
+                    for(i=0; i<CountOfSectors; i++)
+                    {
+                        UBYTE *SrcPtr=NULL;
+
+                        if(DLayer->OffsetTablePtr[i]>=0)
+                        {
+                            MapPtr[i>>3]|=(UBYTE)(0x80>>(i&7));
+                            if(i>=DLayer->FirstOverlayIdx) SrcPtr=&OldPtr[DLayer->OffsetTablePtr[i]-TailOffset];
+                        }
+                        else if(DLayer->OverlayTablePtr[i]!=NULL)
+                        {
+                            MapPtr[i>>3]|=(UBYTE)(0x80>>(i&7));
+                            SrcPtr=DLayer->OverlayTablePtr[i];
+                        }
+
+                        if(SrcPtr!=NULL)
+                        {
+                            Sys_MemCopy(&NewPtr[Offset],SrcPtr,DLayer->SectorSize);
+                            Offset+=DLayer->SectorSize;
+                        }
+                    }
+
+                    if(P_DTds_WriteFile(DLayer,TailOffset,NewPtr,TailSize))
+                    {
+                        P_DTds_SetOffsets(DLayer,MapPtr);
+                        P_DTds_FreeOverlays(DLayer);
+                        DLayer->IsMapPending=TRUE;
+                        ErrorCode=P_DTds_WriteMap(DLayer);
+                    }
+                    else ErrorCode=P_DTds_KeepTail(DLayer,OldPtr,TailOffset)?DL_WRITE_FILE:DL_NOT_ENOUGH_MEMORY;
+                }
+                Sys_FreeMem((void *)OldPtr);
+            }
+            Sys_FreeMem((void *)NewPtr);
+        }
+        Sys_FreeMem((void *)MapPtr);
+    }
+
+    return ErrorCode;
+}
+
+
+/*****
+    Ecriture de la table de présence d'après la position des secteurs dans le fichier
+*****/
+
+ULONG P_DTds_WriteMap(struct DataLayerTds *DLayer)
+{
+    ULONG ErrorCode=DL_NOT_ENOUGH_MEMORY;
+    LONG CountOfSectors=DLayer->CountOfTracks*DLayer->SectorsPerTrack;
+    UBYTE *MapPtr=(UBYTE *)Sys_AllocMem(DLayer->MapSize);
+    LONG i;
+
+    if(MapPtr!=NULL)
+    {
+        for(i=0; i<CountOfSectors; i++) if(DLayer->OffsetTablePtr[i]>=0) MapPtr[i>>3]|=(UBYTE)(0x80>>(i&7));
+
+        ErrorCode=DL_WRITE_FILE;
+        if(P_DTds_WriteFile(DLayer,0,MapPtr,DLayer->MapSize))
+        {
+            DLayer->IsMapPending=FALSE;
+            ErrorCode=DL_SUCCESS;
+        }
+        Sys_FreeMem((void *)MapPtr);
+    }
+
+    return ErrorCode;
+}
+
+
+/*****
+    Suite à l'échec de l'écriture de la fin du fichier, les secteurs présents qui s'y
+    trouvaient sont gardés en mémoire, depuis leur copie relue par P_DTds_Rewrite().
+    Retourne FALSE si un secteur n'a pas pu être gardé faute de mémoire.
+*****/
+
+BOOL P_DTds_KeepTail(struct DataLayerTds *DLayer, const UBYTE *OldPtr, LONG TailOffset)
+{
+    LONG CountOfSectors=DLayer->CountOfTracks*DLayer->SectorsPerTrack;
+    BOOL Result=TRUE;
+    LONG i;
+
+    for(i=DLayer->FirstOverlayIdx; i<CountOfSectors; i++)
+    {
+        if(DLayer->OffsetTablePtr[i]>=0)
+        {
+            if((DLayer->OverlayTablePtr[i]=(UBYTE *)Sys_AllocMem(DLayer->SectorSize))!=NULL)
+            {
+                Sys_MemCopy(DLayer->OverlayTablePtr[i],(void *)&OldPtr[DLayer->OffsetTablePtr[i]-TailOffset],DLayer->SectorSize);
+                DLayer->CountOfOverlays++;
+            } else Result=FALSE;
+            DLayer->OffsetTablePtr[i]=-1;
+        }
+    }
+
+    return Result;
+}
+
+
+/*****
+    Libération des secteurs gardés en mémoire
+*****/
+
+void P_DTds_FreeOverlays(struct DataLayerTds *DLayer)
+{
+    LONG CountOfSectors=DLayer->CountOfTracks*DLayer->SectorsPerTrack;
+    LONG i;
+
+    for(i=0; i<CountOfSectors; i++)
+    {
+        Sys_FreeMem((void *)DLayer->OverlayTablePtr[i]);
+        DLayer->OverlayTablePtr[i]=NULL;
+    }
+    DLayer->CountOfOverlays=0;
+}
+
+
+/*****
+    Nombre de secteurs présents qui se suivent dans le fichier à partir de Idx
+*****/
+
+LONG P_DTds_GetRunLength(struct DataLayerTds *DLayer, LONG Idx, LONG LastIdx)
+{
+    LONG Length=1;
+
+    while(Idx+Length<LastIdx && DLayer->OffsetTablePtr[Idx+Length]==DLayer->OffsetTablePtr[Idx]+Length*DLayer->SectorSize) Length++;
+
+    return Length;
+}
+
+
+/*****
+    Test si un secteur est vierge
+*****/
+
+BOOL P_DTds_IsBlank(const UBYTE *BufferPtr, LONG Size)
+{
+    while(--Size>=0) if(*(BufferPtr++)!=TDS_BLANK_BYTE) return FALSE;
+
+    return TRUE;
+}
+
+
+/*****
+    Lecture d'une partie du fichier image
+*****/
+
+BOOL P_DTds_ReadFile(struct DataLayerTds *DLayer, LONG Offset, UBYTE *BufferPtr, LONG Size)
+{
+#ifdef SYSTEM_AMIGA
+    if(Seek(DLayer->FileHandle,Offset,OFFSET_BEGINNING)>=0)
+    {
+        if(Read(DLayer->FileHandle,(APTR)BufferPtr,Size)==Size) return TRUE;
+    }
+#endif
+#ifdef SYSTEM_UNIX
+    if(pread(DLayer->FileDesc,(void *)BufferPtr,(size_t)Size,(off_t)Offset)==(ssize_t)Size) return TRUE;
+#endif
+    return FALSE;
+}
+
+
+/*****
+    Ecriture d'une partie du fichier image
+*****/
+
+BOOL P_DTds_WriteFile(struct DataLayerTds *DLayer, LONG Offset, const UBYTE *BufferPtr, LONG Size)
+{
+#ifdef SYSTEM_AMIGA
+    if(Seek(DLayer->FileHandle,Offset,OFFSET_BEGINNING)>=0)
+    {
+        if(Write(DLayer->FileHandle,(APTR)BufferPtr,Size)==Size) return TRUE;
+    }
+#endif
+#ifdef SYSTEM_UNIX
+    if(pwrite(DLayer->FileDesc,(const void *)BufferPtr,(size_t)Size,(off_t)Offset)==(ssize_t)Size) return TRUE;
+#endif
+    return FALSE;
+}
+
+
+/*****
+    Vérifie que les secteurs demandés sont dans la géométrie de l'image
+*****/
+
+BOOL P_DTds_IsGeoOk(struct DataLayerTds *DLayer, ULONG Track, ULONG Sector, ULONG Count)
+{
+    if((LONG)Track>=DLayer->CountOfTracks || Sector<1) return FALSE;
+    if((LONG)(Sector-1+Count)>DLayer->SectorsPerTrack) return FALSE;
+
+    return TRUE;
+}
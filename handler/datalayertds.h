@@ -0,0 +1,44 @@
+#ifndef DATALAYERTDS_H
+#define DATALAYERTDS_H
+
+#define TDS_BLANK_BYTE          0xe5    /* Contenu d'un secteur absent de l'image */
+
+struct DataLayerTds
+{
+#ifdef SYSTEM_AMIGA
+    BPTR FileHandle;
+#endif
+#ifdef SYSTEM_UNIX
+    int FileDesc;
+#endif
+    LONG *OffsetTablePtr;   /* Position dans le fichier de chaque secteur, ou -1 si absent */
+    UBYTE **OverlayTablePtr;/* Secteurs absents du fichier mais écrits depuis l'ouverture */
+    LONG CountOfOverlays;
+    LONG FirstOverlayIdx;   /* Plus petit indice des secteurs ajoutés, si CountOfOverlays>0 */
+    BOOL IsMapPending;      /* Table de présence du fichier pas encore à jour */
+    LONG MapSize;           /* Taille de la table de présence en tête du fichier */
+    LONG SectorSize;
+    LONG SectorsPerTrack;
+    LONG CountOfTracks;
+    BOOL IsProtected;
+    BOOL IsChanged;
+};
+
+
+/***** VARIABLES ET FONCTIONS    *****/
+/***** PUBLIQUES UTILISABLES PAR *****/
+/***** D'AUTRES BLOCS DU PROJET  *****/
+
+extern struct DataLayerTds *DTds_Open(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(struct DataLayerTds *, void *), void *, ULONG *);
+extern void DTds_Close(struct DataLayerTds *);
+extern BOOL DTds_IsDiskIn(struct DataLayerTds *);
+extern BOOL DTds_IsProtected(struct DataLayerTds *);
+extern void DTds_Clean(struct DataLayerTds *);
+extern BOOL DTds_IsChanged(struct DataLayerTds *);
+extern void DTds_SetChanged(struct DataLayerTds *, BOOL);
+extern ULONG DTds_Finalize(struct DataLayerTds *);
+extern ULONG DTds_FormatTrack(struct DataLayerTds *, ULONG, ULONG, const UBYTE *);
+extern ULONG DTds_ReadSectors(struct DataLayerTds *, ULONG, ULONG, ULONG, UBYTE *);
+extern ULONG DTds_WriteSectors(struct DataLayerTds *, ULONG, ULONG, ULONG, const UBYTE *);
+
+#endif  /* DATALAYERTDS_H */
@@ -4,7 +4,7 @@
 #include <stdarg.h>
 
 /*
-    01-10-2020 (Seg)    Gestion du debug dans une lib  part
+    01-10-2020 (Seg)    Gestion du debug dans une lib à part
 */
 
 
@@ -70,7 +70,7 @@ LONG T(char *String, ...)
 
 
 /*****
-    Affichage d'une requte
+    Affichage d'une requête
 *****/
 
 LONG Dbg_ShowMessage(char *String)
@@ -1,15 +1,46 @@
 #include "system.h"
 #include "disklayer.h"
 #include "datalayerfloppy.h"
+#include "datalayerfd.h"
+#include "datalayersap.h"
+#include "datalayertds.h"
+#include "datalayerram.h"
+#include "datalayersim.h"
 
 
 /*
+    17-10-2026 (Seg)    DL_SetProtected(), DL_ChangeDisk() et DL_GetSimStats() passent par la
+                        table de fonctions, pour atteindre le disque en mémoire sous @sim
+    17-10-2026 (Seg)    Un accès direct à une piste retire sa lecture anticipée de la file, et une
+                        nouvelle lecture anticipée remplace la plus éloignée si la file est chargée
+    17-10-2026 (Seg)    Une lecture anticipée ne recycle jamais le secteur demandé
+    17-10-2026 (Seg)    Les lectures anticipées hors du disque sont ignorées
+    17-10-2026 (Seg)    Ajout de DL_GetSimStats() pour lire les mesures du lecteur simulé
+    17-10-2026 (Seg)    Ajout de DL_SetProtected() et DL_ChangeDisk() pour le disque virtuel
+    17-10-2026 (Seg)    Les secteurs du cache ne sont marqués écrits qu'après la fin des écritures
+                        en tâche de fond (voir P_DL_Sync())
+    17-10-2026 (Seg)    Ajout de DL_ReadSectorsData() et DL_WriteSectorsData()
+    17-10-2026 (Seg)    Option d'écriture des pistes partiellement modifiées en entier
+    17-10-2026 (Seg)    Ajout de DL_MotorOff(), DL_Finalize() n'arrête plus le moteur
+    17-10-2026 (Seg)    File des requêtes traitée dans l'ordre de l'ascenseur
+    17-10-2026 (Seg)    Ajout de DL_GetPhysicalSlot() et DL_GetRotationalOrder()
+    17-10-2026 (Seg)    Ajout du lecteur simulé (@sim)
+    17-10-2026 (Seg)    Ajout du disque virtuel en mémoire (@ram)
+    17-10-2026 (Seg)    Ajout de la couche de données des images .tds
+    17-10-2026 (Seg)    Ajout de la couche de données des images .sap
+    17-10-2026 (Seg)    Ajout de la couche de données des images .fd
+    17-10-2026 (Seg)    Choix de la couche de données par une table de fonctions
+    17-10-2026 (Seg)    Ajout de DL_ReadSectors() et DL_WriteSectors()
+    17-10-2026 (Seg)    Option de lecture de piste complète sur défaut de cache
+    17-10-2026 (Seg)    Le nombre de buffers est limité à ce que le pool du cache a pu allouer
+    17-10-2026 (Seg)    Les changements de statut des secteurs passent par Sch_SetStatus()
+    17-10-2026 (Seg)    La taille de l'index du SectorCache suit le nombre de buffers
     24-09-2020 (Seg)    Fix
-    23-09-2020 (Seg)    Amlioration de la gestion du cache
+    23-09-2020 (Seg)    Amélioration de la gestion du cache
     10-09-2020 (Seg)    Refonte de la couche disque de la commande todisk pour le handler
-    27-08-2018 (Seg)    Gestion des paramtres gomtriques du file system
-    23-09-2013 (Seg)    Adaptation du code suite  la migration sous Unix
-    16-08-2012 (Seg)    Indique maintenant le nombre d'units et de face par unit gr par le disque
+    27-08-2018 (Seg)    Gestion des paramètres géométriques du file system
+    23-09-2013 (Seg)    Adaptation du code suite à la migration sous Unix
+    16-08-2012 (Seg)    Indique maintenant le nombre d'unités et de face par unité géré par le disque
     22-05-2010 (Seg)    Retouche de la fontion DL_ParseOption() et ajout de DL_FreeOption()
     24-03-2010 (Seg)    Gestion de la detection automatique de la source
     30-12-2008 (Seg)    Gestion du floppy
@@ -18,46 +49,208 @@
 
 
 /***** Prototypes */
-struct DiskLayer *DL_Open(const char *, ULONG, ULONG, ULONG, ULONG, ULONG, LONG, void (*)(struct DiskLayer *, void *), void *, ULONG *);
+struct DiskLayer *DL_Open(const char *, ULONG, ULONG, ULONG, ULONG, ULONG, ULONG, ULONG, LONG, void (*)(struct DiskLayer *, void *), void *, ULONG *);
+ULONG DL_GetTypeFromName(const char *);
 void DL_Close(struct DiskLayer *);
 LONG DL_SetBufferMax(struct DiskLayer *, LONG, LONG);
 BOOL DL_IsDiskIn(struct DiskLayer *);
 BOOL DL_IsProtected(struct DiskLayer *);
+BOOL DL_SetProtected(struct DiskLayer *, BOOL);
+BOOL DL_ChangeDisk(struct DiskLayer *, BOOL);
+BOOL DL_GetSimStats(struct DiskLayer *, struct DataLayerSimStats *, BOOL);
 void DL_Clean(struct DiskLayer *);
 BOOL DL_IsChanged(struct DiskLayer *);
 void DL_SetChanged(struct DiskLayer *, BOOL);
 BOOL DL_Finalize(struct DiskLayer *, BOOL);
+void DL_MotorOff(struct DiskLayer *);
 BOOL DL_FormatTrack(struct DiskLayer *, ULONG, ULONG, const UBYTE *);
 BOOL DL_ReadSector(struct DiskLayer *, ULONG, ULONG, UBYTE *);
 BOOL DL_WriteSector(struct DiskLayer *, ULONG, ULONG, const UBYTE *);
+BOOL DL_ReadSectors(struct DiskLayer *, ULONG, ULONG, ULONG, UBYTE **);
+BOOL DL_WriteSectors(struct DiskLayer *, ULONG, ULONG, ULONG, UBYTE **);
+BOOL DL_ReadSectorsData(struct DiskLayer *, ULONG, ULONG, ULONG, UBYTE *, ULONG);
+BOOL DL_WriteSectorsData(struct DiskLayer *, ULONG, ULONG, ULONG, const UBYTE *, ULONG);
 BOOL DL_GetSector(struct DiskLayer *, ULONG, ULONG, BOOL, struct SectorCacheNode **);
 BOOL DL_WriteBufferCache(struct DiskLayer *);
+void DL_QueueReadAhead(struct DiskLayer *, ULONG, ULONG, ULONG);
 BOOL DL_Obtain(struct DiskLayer *, LONG, LONG, struct SectorCacheNode **);
 ULONG DL_GetError(struct DiskLayer *);
 const char *DL_GetDLTextErr(ULONG);
 BOOL DL_IsDLFatalError(ULONG);
+LONG DL_GetPhysicalSlot(LONG, LONG, LONG);
+void DL_GetRotationalOrder(LONG, LONG, ULONG, ULONG, UBYTE *);
+
+struct DiskLayerRequest *P_DL_GetRequest(struct DiskLayer *, LONG, BOOL);
+void P_DL_DropReadAhead(struct DiskLayer *, LONG);
+BOOL P_DL_RunQueue(struct DiskLayer *, struct SectorCacheNode *);
+LONG P_DL_GetNextRequest(struct DiskLayer *, struct SectorCacheNode *);
+BOOL P_DL_ServeRead(struct DiskLayer *, struct DiskLayerRequest *, struct SectorCacheNode *);
+BOOL P_DL_ServeWrite(struct DiskLayer *, LONG);
+BOOL P_DL_WriteSectors(struct DiskLayer *, ULONG, ULONG, ULONG, UBYTE **);
+BOOL P_DL_Sync(struct DiskLayer *);
+BOOL P_DL_FillTrack(struct DiskLayer *, LONG, struct SectorCacheNode **);
+BOOL P_DL_IsContiguous(struct DiskLayer *, ULONG, UBYTE **);
+BOOL P_DL_IsSuffix(const char *, const char *);
+BOOL P_DL_IsPrefix(const char *, const char *);
+
+
+/***** Tables des fonctions des couches de données */
+const struct DataLayerFuncs DL_FloppyFuncs=
+{
+    (void *(*)(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(void *, void *), void *, ULONG *))DFlp_Open,
+    (void (*)(void *))DFlp_Close,
+    (BOOL (*)(void *))DFlp_IsDiskIn,
+    (BOOL (*)(void *))DFlp_IsProtected,
+    (void (*)(void *))DFlp_Clean,
+    (ULONG (*)(void *))DFlp_Finalize,
+    (ULONG (*)(void *, ULONG, ULONG, const UBYTE *))DFlp_FormatTrack,
+    (ULONG (*)(void *, ULONG, ULONG, ULONG, UBYTE *))DFlp_ReadSectors,
+    (ULONG (*)(void *, ULONG, ULONG, ULONG, const UBYTE *))DFlp_WriteSectors,
+    (BOOL (*)(void *))DFlp_IsChanged,
+    (void (*)(void *, BOOL))DFlp_SetChanged,
+    (void (*)(void *))DFlp_MotorOff,
+    (ULONG (*)(void *))DFlp_Sync,
+    NULL,
+    NULL,
+    NULL
+};
+
+const struct DataLayerFuncs DL_FdFuncs=
+{
+    (void *(*)(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(void *, void *), void *, ULONG *))DFd_Open,
+    (void (*)(void *))DFd_Close,
+    (BOOL (*)(void *))DFd_IsDiskIn,
+    (BOOL (*)(void *))DFd_IsProtected,
+    (void (*)(void *))DFd_Clean,
+    (ULONG (*)(void *))DFd_Finalize,
+    (ULONG (*)(void *, ULONG, ULONG, const UBYTE *))DFd_FormatTrack,
+    (ULONG (*)(void *, ULONG, ULONG, ULONG, UBYTE *))DFd_ReadSectors,
+    (ULONG (*)(void *, ULONG, ULONG, ULONG, const UBYTE *))DFd_WriteSectors,
+    (BOOL (*)(void *))DFd_IsChanged,
+    (void (*)(void *, BOOL))DFd_SetChanged,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL
+};
+
+const struct DataLayerFuncs DL_SapFuncs=
+{
+    (void *(*)(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(void *, void *), void *, ULONG *))DSap_Open,
+    (void (*)(void *))DSap_Close,
+    (BOOL (*)(void *))DSap_IsDiskIn,
+    (BOOL (*)(void *))DSap_IsProtected,
+    (void (*)(void *))DSap_Clean,
+    (ULONG (*)(void *))DSap_Finalize,
+    (ULONG (*)(void *, ULONG, ULONG, const UBYTE *))DSap_FormatTrack,
+    (ULONG (*)(void *, ULONG, ULONG, ULONG, UBYTE *))DSap_ReadSectors,
+    (ULONG (*)(void *, ULONG, ULONG, ULONG, const UBYTE *))DSap_WriteSectors,
+    (BOOL (*)(void *))DSap_IsChanged,
+    (void (*)(void *, BOOL))DSap_SetChanged,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL
+};
+
+const struct DataLayerFuncs DL_TdsFuncs=
+{
+    (void *(*)(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(void *, void *), void *, ULONG *))DTds_Open,
+    (void (*)(void *))DTds_Close,
+    (BOOL (*)(void *))DTds_IsDiskIn,
+    (BOOL (*)(void *))DTds_IsProtected,
+    (void (*)(void *))DTds_Clean,
+    (ULONG (*)(void *))DTds_Finalize,
+    (ULONG (*)(void *, ULONG, ULONG, const UBYTE *))DTds_FormatTrack,
+    (ULONG (*)(void *, ULONG, ULONG, ULONG, UBYTE *))DTds_ReadSectors,
+    (ULONG (*)(void *, ULONG, ULONG, ULONG, const UBYTE *))DTds_WriteSectors,
+    (BOOL (*)(void *))DTds_IsChanged,
+    (void (*)(void *, BOOL))DTds_SetChanged,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL
+};
+
+const struct DataLayerFuncs DL_RamFuncs=
+{
+    (void *(*)(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(void *, void *), void *, ULONG *))DRam_Open,
+    (void (*)(void *))DRam_Close,
+    (BOOL (*)(void *))DRam_IsDiskIn,
+    (BOOL (*)(void *))DRam_IsProtected,
+    (void (*)(void *))DRam_Clean,
+    (ULONG (*)(void *))DRam_Finalize,
+    (ULONG (*)(void *, ULONG, ULONG, const UBYTE *))DRam_FormatTrack,
+    (ULONG (*)(void *, ULONG, ULONG, ULONG, UBYTE *))DRam_ReadSectors,
+    (ULONG (*)(void *, ULONG, ULONG, ULONG, const UBYTE *))DRam_WriteSectors,
+    (BOOL (*)(void *))DRam_IsChanged,
+    (void (*)(void *, BOOL))DRam_SetChanged,
+    NULL,
+    NULL,
+    (BOOL (*)(void *, BOOL))DRam_SetProtected,
+    (BOOL (*)(void *, BOOL))DRam_ChangeDisk,
+    NULL
+};
+
+const struct DataLayerFuncs DL_SimFuncs=
+{
+    (void *(*)(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(void *, void *), void *, ULONG *))DSim_Open,
+    (void (*)(void *))DSim_Close,
+    (BOOL (*)(void *))DSim_IsDiskIn,
+    (BOOL (*)(void *))DSim_IsProtected,
+    (void (*)(void *))DSim_Clean,
+    (ULONG (*)(void *))DSim_Finalize,
+    (ULONG (*)(void *, ULONG, ULONG, const UBYTE *))DSim_FormatTrack,
+    (ULONG (*)(void *, ULONG, ULONG, ULONG, UBYTE *))DSim_ReadSectors,
+    (ULONG (*)(void *, ULONG, ULONG, ULONG, const UBYTE *))DSim_WriteSectors,
+    (BOOL (*)(void *))DSim_IsChanged,
+    (void (*)(void *, BOOL))DSim_SetChanged,
+    (void (*)(void *))DSim_MotorOff,
+    (ULONG (*)(void *))DSim_Sync,
+    (BOOL (*)(void *, BOOL))DSim_SetProtected,
+    (BOOL (*)(void *, BOOL))DSim_ChangeDisk,
+    (BOOL (*)(void *, struct DataLayerSimStats *, BOOL))DSim_GetStats
+};
+
+/* Indexée par DISKLAYER_TYPE_xxx. NULL si le type n'est pas géré. */
+const struct DataLayerFuncs *DL_FuncsTable[]=
+{
+    NULL,               /* DISKLAYER_TYPE_NONE */
+    &DL_FloppyFuncs,    /* DISKLAYER_TYPE_FLOPPY */
+    &DL_TdsFuncs,       /* DISKLAYER_TYPE_TDS */
+    &DL_FdFuncs,        /* DISKLAYER_TYPE_FD */
+    &DL_SapFuncs,       /* DISKLAYER_TYPE_SAP */
+    &DL_RamFuncs,       /* DISKLAYER_TYPE_RAM */
+    &DL_SimFuncs        /* DISKLAYER_TYPE_SIM */
+};
 
 
 /*****
-    Ouverture de la couche disque correspondant  la source ou la
-    destination vise.
-    * Paramtres:
-      Name: nom du device  utiliser
-      Flags: flags  passer au device lors de son ouverture
-      Unit: unit du device  ouvrir
+    Ouverture de la couche disque correspondant à la source ou la
+    destination visée.
+    La couche de données est choisie d'après le nom (voir DL_GetTypeFromName()).
+    * Paramètres:
+      Name: nom du device ou de l'image disque à utiliser
+      Flags: flags à passer au device lors de son ouverture
+      Options: options de la couche disque (DL_OPT_...)
+      Unit: unité du device à ouvrir
       Side: facultatif dans le cas de l'utilisation du device
+      CountOfTracks: nombre de pistes du disque
       CountOfSectorPerTrack: pour indiquer le nombre de secteurs par piste
       SectorSize: pour indiquer la taille d'un secteyur
-      CountOfBufferMax: nombre de buffers maximum  utiliser pour la gestion du cache interne  cette lib
-      IntFuncPtr: pointeur vers une fonction callback pour savoir si un disque vient d'tre insr ou retir
-      IntData: pointeur vers une structure utilisateur  passer lors de l'utilisation du callback
+      CountOfBufferMax: nombre de buffers maximum à utiliser pour la gestion du cache interne à cette lib
+      IntFuncPtr: pointeur vers une fonction callback pour savoir si un disque vient d'être inséré ou retiré
+      IntData: pointeur vers une structure utilisateur à passer lors de l'utilisation du callback
       ErrorCode: pointeur vers un ULONG pour retourner un code d'erreur ou DL_SUCCESS
     * Retourne:
-      - NULL si chec (vrifier ErrorCode)
-      - pointeur vers une structure DataLayerFloppy si succs
+      - NULL si échec (vérifier ErrorCode)
+      - pointeur vers une structure DiskLayer si succès
 *****/
 
-struct DiskLayer *DL_Open(const char *Name, ULONG Flags, ULONG Unit, ULONG Side, ULONG CountOfSectorPerTrack, ULONG SectorSize, LONG CountOfBufferMax, void (*IntFuncPtr)(struct DiskLayer *, void *), void *IntData, ULONG *ErrorCode)
+struct DiskLayer *DL_Open(const char *Name, ULONG Flags, ULONG Options, ULONG Unit, ULONG Side, ULONG CountOfTracks, ULONG CountOfSectorPerTrack, ULONG SectorSize, LONG CountOfBufferMax, void (*IntFuncPtr)(struct DiskLayer *, void *), void *IntData, ULONG *ErrorCode)
 {
     struct DiskLayer *DLayer=(struct DiskLayer *)Sys_AllocMem(sizeof(struct DiskLayer));
 
@@ -65,11 +258,27 @@ struct DiskLayer *DL_Open(const char *Name, ULONG Flags, ULONG Unit, ULONG Side,
     if(DLayer!=NULL)
     {
         Sch_Init(&DLayer->SectorCache,SectorSize);
-        DL_SetBufferMax(DLayer,CountOfBufferMax,0);
 
         DLayer->Unit=Unit;
         DLayer->Side=Side;
-        DLayer->DataLayerPtr=(void *)DFlp_Open(Name,Flags,Unit,Side,CountOfSectorPerTrack,SectorSize,(void (*)(struct DataLayerFloppy *, void *))IntFuncPtr,IntData,ErrorCode);
+        DLayer->Options=Options;
+        DLayer->CountOfTracks=CountOfTracks;
+        DLayer->SectorsPerTrack=CountOfSectorPerTrack;
+        DLayer->SectorSize=SectorSize;
+        DLayer->Direction=1;
+        DLayer->TrackBufferPtr=(UBYTE *)Sys_AllocMem(CountOfSectorPerTrack*SectorSize);
+
+        DLayer->Type=DL_GetTypeFromName(Name);
+        DLayer->FuncsPtr=DL_FuncsTable[DLayer->Type];
+
+        if(DLayer->TrackBufferPtr!=NULL && DL_SetBufferMax(DLayer,CountOfBufferMax,0)>0)
+        {
+            *ErrorCode=DL_UNKNOWN_TYPE;
+            if(DLayer->FuncsPtr!=NULL)
+            {
+                DLayer->DataLayerPtr=DLayer->FuncsPtr->Open(Name,Flags,Unit,Side,CountOfTracks,CountOfSectorPerTrack,SectorSize,(void (*)(void *, void *))IntFuncPtr,IntData,ErrorCode);
+            }
+        }
 
         if(DLayer->DataLayerPtr==NULL)
         {
@@ -82,6 +291,28 @@ struct DiskLayer *DL_Open(const char *Name, ULONG Flags, ULONG Unit, ULONG Side,
 }
 
 
+/*****
+    Détermine le type de couche de données d'après le nom passé à DL_Open():
+    - "xxx.fd": image disque brute
+    - "xxx.sap": image disque au format SAP
+    - "xxx.tds": image disque au format TDS
+    - "@ram" ou "@ram:xxx": disque virtuel en mémoire, avec ou sans image de sauvegarde
+    - "@sim:xxx": lecteur simulé sur la source xxx
+    - sinon il s'agit d'un device (lecteur de disquette)
+*****/
+
+ULONG DL_GetTypeFromName(const char *Name)
+{
+    if(P_DL_IsPrefix(Name,SIM_NAME_PREFIX)) return DISKLAYER_TYPE_SIM;
+    if(P_DL_IsPrefix(Name,RAM_NAME_PREFIX)) return DISKLAYER_TYPE_RAM;
+    if(P_DL_IsSuffix(Name,".fd")) return DISKLAYER_TYPE_FD;
+    if(P_DL_IsSuffix(Name,".sap")) return DISKLAYER_TYPE_SAP;
+    if(P_DL_IsSuffix(Name,".tds")) return DISKLAYER_TYPE_TDS;
+
+    return DISKLAYER_TYPE_FLOPPY;
+}
+
+
 /*****
     Fermeture de la couche disque ouverte par OpenDiskLayer()
 *****/
@@ -90,22 +321,23 @@ void DL_Close(struct DiskLayer *DLayer)
 {
     if(DLayer!=NULL)
     {
-        DFlp_Close((struct DataLayerFloppy *)DLayer->DataLayerPtr);
-        Sch_Flush(&DLayer->SectorCache);
+        if(DLayer->DataLayerPtr!=NULL) DLayer->FuncsPtr->Close(DLayer->DataLayerPtr);
+        Sch_Dispose(&DLayer->SectorCache);
+        Sys_FreeMem((void *)DLayer->TrackBufferPtr);
         Sys_FreeMem((void *)DLayer);
     }
 }
 
 
 /*****
-    Pour dfinir la taille du SectorCache, soit en absolu, soit en incrmental
-    * Paramtres:
-      DLayer: structure alloue par DFlp_Open()
-      CountOfBufferMax: nombre de buffers maximum  utiliser pour la gestion du cache interne
-         cette lib, ou -1
-      AddBuffer: nombre de buffers  ajouter ou retirer, ou 0 pour ne rien changer
+    Pour définir la taille du SectorCache, soit en absolu, soit en incrémental
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      CountOfBufferMax: nombre de buffers maximum à utiliser pour la gestion du cache interne
+        à cette lib, ou -1
+      AddBuffer: nombre de buffers à ajouter ou retirer, ou 0 pour ne rien changer
     * Retourne:
-      Nombre de buffers actuellement autoriss
+      Nombre de buffers actuellement autorisés
 *****/
 
 LONG DL_SetBufferMax(struct DiskLayer *DLayer, LONG CountOfBufferMax, LONG AddBuffer)
@@ -113,48 +345,101 @@ LONG DL_SetBufferMax(struct DiskLayer *DLayer, LONG CountOfBufferMax, LONG AddBu
     if(CountOfBufferMax>=0) DLayer->CountOfBufferMax=CountOfBufferMax;
     DLayer->CountOfBufferMax+=AddBuffer;
     if(DLayer->CountOfBufferMax<1) DLayer->CountOfBufferMax=1;
+
+    /* En cas d'erreur mémoire, on se contente des buffers que le cache a pu allouer */
+    DLayer->CountOfBufferMax=Sch_SetBufferMax(&DLayer->SectorCache,DLayer->CountOfBufferMax);
+
     return DLayer->CountOfBufferMax;
 }
 
 
 /*****
-    Pour vrifier si un disque est prsent
+    Pour vérifier si un disque est présent
 *****/
 
 BOOL DL_IsDiskIn(struct DiskLayer *DLayer)
 {
-    return DFlp_IsDiskIn((struct DataLayerFloppy *)DLayer->DataLayerPtr);
+    return DLayer->FuncsPtr->IsDiskIn(DLayer->DataLayerPtr);
 }
 
 
 /*****
-    Pour vrifier si le disque est protg
+    Pour vérifier si le disque est protégé
 *****/
 
 BOOL DL_IsProtected(struct DiskLayer *DLayer)
 {
-    return DFlp_IsProtected((struct DataLayerFloppy *)DLayer->DataLayerPtr);
+    return DLayer->FuncsPtr->IsProtected(DLayer->DataLayerPtr);
+}
+
+
+/*****
+    Protection logicielle du disque. Seul le disque virtuel en mémoire le permet,
+    éventuellement au travers du lecteur simulé.
+    * Retourne:
+      TRUE si succès
+      FALSE si la source ne le permet pas
+*****/
+
+BOOL DL_SetProtected(struct DiskLayer *DLayer, BOOL IsProtected)
+{
+    if(DLayer->FuncsPtr->SetProtected==NULL) return FALSE;
+    return DLayer->FuncsPtr->SetProtected(DLayer->DataLayerPtr,IsProtected);
+}
+
+
+/*****
+    Insertion ou retrait simulé du disque. Seul le disque virtuel en mémoire le permet,
+    éventuellement au travers du lecteur simulé. Le changement est signalé par le callback passé à DL_Open(), comme pour un lecteur.
+    * Retourne:
+      TRUE si succès
+      FALSE si la source ne le permet pas
+*****/
+
+BOOL DL_ChangeDisk(struct DiskLayer *DLayer, BOOL IsDiskIn)
+{
+    if(DLayer->FuncsPtr->ChangeDisk==NULL) return FALSE;
+    return DLayer->FuncsPtr->ChangeDisk(DLayer->DataLayerPtr,IsDiskIn);
+}
+
+
+/*****
+    Lecture des statistiques et du temps simulé du lecteur simulé (source @sim:xxx)
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      StatsPtr: structure qui reçoit les statistiques
+      IsReset: TRUE pour remettre les statistiques à zéro après la lecture
+    * Retourne:
+      TRUE si succès
+      FALSE si la source n'est pas simulée
+*****/
+
+BOOL DL_GetSimStats(struct DiskLayer *DLayer, struct DataLayerSimStats *StatsPtr, BOOL IsReset)
+{
+    if(DLayer->FuncsPtr->GetSimStats==NULL) return FALSE;
+    return DLayer->FuncsPtr->GetSimStats(DLayer->DataLayerPtr,StatsPtr,IsReset);
 }
 
 
 /*****
-    Nettoyage des caches (suite  une insertion de disquette par exemple)
+    Nettoyage des caches (suite à une insertion de disquette par exemple)
 *****/
 
 void DL_Clean(struct DiskLayer *DLayer)
 {
-    DFlp_Clean((struct DataLayerFloppy *)DLayer->DataLayerPtr);
+    DLayer->FuncsPtr->Clean(DLayer->DataLayerPtr);
     Sch_Flush(&DLayer->SectorCache);
+    DLayer->CountOfRequests=0;
 }
 
 
 /*****
-    Test si le disque a chang
+    Test si le disque a changé
 *****/
 
 BOOL DL_IsChanged(struct DiskLayer *DLayer)
 {
-    return ((struct DataLayerFloppy *)DLayer->DataLayerPtr)->IsChanged;
+    return DLayer->FuncsPtr->IsChanged(DLayer->DataLayerPtr);
 }
 
 
@@ -164,29 +449,30 @@ BOOL DL_IsChanged(struct DiskLayer *DLayer)
 
 void DL_SetChanged(struct DiskLayer *DLayer, BOOL IsChanged)
 {
-    ((struct DataLayerFloppy *)DLayer->DataLayerPtr)->IsChanged=IsChanged;
+    DLayer->FuncsPtr->SetChanged(DLayer->DataLayerPtr,IsChanged);
 }
 
 
 /*****
-    Termine les oprations en cache
-    * Paramtres:
-      DLayer: structure alloue par DFlp_Open()
-      IsFreeCache: TRUE si on veut librer le cache interne  cette lib
+    Termine les opérations en cache.
+    Le moteur reste allumé: il est arrêté par DL_MotorOff().
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      IsFreeCache: TRUE si on veut libérer le cache interne à cette lib
     * Retourne:
-      TRUE si succs
-      FALSE si chec (vrifier DLayer->Error pour avoir le dtail)
+      TRUE si succès
+      FALSE si échec (vérifier DLayer->Error pour avoir le détail)
 *****/
 
 BOOL DL_Finalize(struct DiskLayer *DLayer, BOOL IsFreeCache)
 {
-    /* On vide tout le cache et on crit les secteurs qui sont modifis */
+    /* On vide tout le cache et on écrit les secteurs qui sont modifiés */
     if(DL_WriteBufferCache(DLayer))
     {
         if(IsFreeCache) Sch_Flush(&DLayer->SectorCache);
 
-        /* On demande  la couche disque de vider aussi son cache */
-        DLayer->Error=DFlp_Finalize((struct DataLayerFloppy *)DLayer->DataLayerPtr);
+        /* On demande à la couche disque de vider aussi son cache */
+        DLayer->Error=DLayer->FuncsPtr->Finalize(DLayer->DataLayerPtr);
 
         if(!DLayer->Error) return TRUE;
     }
@@ -195,23 +481,35 @@ BOOL DL_Finalize(struct DiskLayer *DLayer, BOOL IsFreeCache)
 }
 
 
+/*****
+    Arrêt du moteur du lecteur, si la source en a un
+*****/
+
+void DL_MotorOff(struct DiskLayer *DLayer)
+{
+    if(DLayer->FuncsPtr->MotorOff!=NULL) DLayer->FuncsPtr->MotorOff(DLayer->DataLayerPtr);
+}
+
+
 /*****
     Formatage d'une piste
-    * Paramtres:
-      DLayer: structure alloue par DFlp_Open()
-      Track: piste  formater
-      Interleave: numro d'entrelacement des secteurs de la piste (passer 7 comme valeur par dfaut)
-      BufferPtr: pointeur vers les donnes qui vont servir initialiser la piste.
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      Track: piste à formater
+      Interleave: numéro d'entrelacement des secteurs de la piste (passer 7 comme valeur par défaut)
+      BufferPtr: pointeur vers les données qui vont servir initialiser la piste.
         Ce buffer doit avoir pour taille le nombre d'octets par secteur (soit 256 en principe),
-        multipli par le nombre de secteurs par piste (soit 16 en principe).
+        multiplié par le nombre de secteurs par piste (soit 16 en principe).
     * Retourne:
-      TRUE si succs
-      FALSE si chec (vrifier DLayer->Error pour avoir le dtail)
+      TRUE si succès
+      FALSE si échec (vérifier DLayer->Error pour avoir le détail)
 *****/
 
 BOOL DL_FormatTrack(struct DiskLayer *DLayer, ULONG Track, ULONG Interleave, const UBYTE *BufferPtr)
 {
-    DLayer->Error=DFlp_FormatTrack((struct DataLayerFloppy *)DLayer->DataLayerPtr,Track,Interleave,BufferPtr);
+    P_DL_DropReadAhead(DLayer,(LONG)Track);
+    DLayer->HeadTrack=(LONG)Track;
+    DLayer->Error=DLayer->FuncsPtr->FormatTrack(DLayer->DataLayerPtr,Track,Interleave,BufferPtr);
     if(DLayer->Error) return FALSE;
     return TRUE;
 }
@@ -219,26 +517,45 @@ BOOL DL_FormatTrack(struct DiskLayer *DLayer, ULONG Track, ULONG Interleave, con
 
 /*****
     Lecture d'un secteur de donnees
-    * Paramtres:
-      DLayer: structure alloue par DFlp_Open()
-      Track: numro de piste  lire
-      Sector: numro du secteur de la piste  lire
-      IsPreload: TRUE pour demander  charger le secteur si jamais le cache vient d'tre cr
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      Track: numéro de piste à lire
+      Sector: numéro du secteur de la piste à lire
+      IsPreload: TRUE pour demander à charger le secteur si jamais le cache vient d'être créé
       SectorCacheNodePtr: pointeur de pointeur pour obtenir le noeud du cache correspondant
     * Retourne:
-      TRUE si succs
-      FALSE si chec (vrifier DLayer->Error pour avoir le dtail)
+      TRUE si succès
+      FALSE si échec (vérifier DLayer->Error pour avoir le détail)
 *****/
 
 BOOL DL_GetSector(struct DiskLayer *DLayer, ULONG Track, ULONG Sector, BOOL IsPreload, struct SectorCacheNode **SectorCacheNodePtr)
 {
     BOOL Result=DL_Obtain(DLayer,Track,Sector,SectorCacheNodePtr);
 
-    if(Result && IsPreload && (*SectorCacheNodePtr)->Status==SCN_NEW)
+    if(Result && (*SectorCacheNodePtr)->Status==SCN_NEW)
     {
-        /* Si le cache vient d'tre allou, on l'initialise en lisant le secteur demand */
-        Result=DL_ReadSector(DLayer,Track,Sector,(*SectorCacheNodePtr)->BufferPtr);
-        if(Result) (*SectorCacheNodePtr)->Status=SCN_INITIALIZED;
+        if(IsPreload)
+        {
+            /* Si le cache vient d'être alloué, on l'initialise en lisant le secteur demandé par
+               la file des requêtes, avec toute la piste en lecture anticipée si l'option est
+               active. Les requêtes en attente sur le chemin de la tête sont traitées au passage. */
+            struct DiskLayerRequest *ReqPtr=P_DL_GetRequest(DLayer,(LONG)Track,FALSE);
+
+            if(ReqPtr!=NULL)
+            {
+                ReqPtr->Flags|=DL_REQ_READ;
+                if(DLayer->Options&DL_OPT_TRACKREAD) DL_QueueReadAhead(DLayer,Track,1,DLayer->SectorsPerTrack);
+                Result=P_DL_RunQueue(DLayer,*SectorCacheNodePtr);
+            }
+            else Result=DL_ReadSector(DLayer,Track,Sector,(*SectorCacheNodePtr)->BufferPtr);
+            if(Result) Sch_SetStatus(&DLayer->SectorCache,*SectorCacheNodePtr,SCN_INITIALIZED);
+        }
+        else
+        {
+            /* Le buffer recyclé n'est pas effacé par le cache: on le fait ici */
+            LONG i;
+            for(i=0; i<DLayer->SectorCache.SectorSize; i++) (*SectorCacheNodePtr)->BufferPtr[i]=0;
+        }
     }
 
     return Result;
@@ -247,19 +564,21 @@ BOOL DL_GetSector(struct DiskLayer *DLayer, ULONG Track, ULONG Sector, BOOL IsPr
 
 /*****
     Lecture directe d'un secteur
-    * Paramtres:
-      DLayer: structure alloue par DFlp_Open()
-      Track: numro de piste  lire
-      Sector: numro du secteur de la piste  lire
-      BufferPtr: rcipiant pour recevoir le secteur lu
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      Track: numéro de piste à lire
+      Sector: numéro du secteur de la piste à lire
+      BufferPtr: récipiant pour recevoir le secteur lu
     * Retourne:
-      TRUE si succs
-      FALSE si chec (vrifier DLayer->Error pour avoir le dtail)
+      TRUE si succès
+      FALSE si échec (vérifier DLayer->Error pour avoir le détail)
 *****/
 
 BOOL DL_ReadSector(struct DiskLayer *DLayer, ULONG Track, ULONG Sector, UBYTE *BufferPtr)
 {
-    DLayer->Error=DFlp_ReadSector((struct DataLayerFloppy *)DLayer->DataLayerPtr,Track,Sector,BufferPtr);
+    P_DL_DropReadAhead(DLayer,(LONG)Track);
+    DLayer->HeadTrack=(LONG)Track;
+    DLayer->Error=DLayer->FuncsPtr->ReadSectors(DLayer->DataLayerPtr,Track,Sector,1,BufferPtr);
     if(DLayer->Error) return FALSE;
     return TRUE;
 }
@@ -267,37 +586,205 @@ BOOL DL_ReadSector(struct DiskLayer *DLayer, ULONG Track, ULONG Sector, UBYTE *B
 
 /*****
     Ecriture directe d'un secteur
-    * Paramtres:
-      DLayer: structure alloue par DFlp_Open()
-      Track: numro de piste  crire
-      Sector: numro du secteur de la piste  crire
-      BufferPtr: pointeur vers les donnes du secteur  crire
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      Track: numéro de piste à écrire
+      Sector: numéro du secteur de la piste à écrire
+      BufferPtr: pointeur vers les données du secteur à écrire
     * Retourne:
-      TRUE si succs
-      FALSE si chec (vrifier DLayer->Error pour avoir le dtail)
+      TRUE si succès
+      FALSE si échec (vérifier DLayer->Error pour avoir le détail)
 *****/
 
 BOOL DL_WriteSector(struct DiskLayer *DLayer, ULONG Track, ULONG Sector, const UBYTE *BufferPtr)
 {
-    DLayer->Error=DFlp_WriteSector((struct DataLayerFloppy *)DLayer->DataLayerPtr,Track,Sector,BufferPtr);
+    P_DL_DropReadAhead(DLayer,(LONG)Track);
+    DLayer->HeadTrack=(LONG)Track;
+    DLayer->Error=DLayer->FuncsPtr->WriteSectors(DLayer->DataLayerPtr,Track,Sector,1,BufferPtr);
+    if(DLayer->Error) return FALSE;
+    return P_DL_Sync(DLayer);
+}
+
+
+/*****
+    Lecture de plusieurs secteurs consécutifs d'une piste.
+    Si les buffers se suivent en mémoire, la lecture se fait directement en une seule requête.
+    Sinon, les secteurs sont lus en une seule requête dans un buffer intermédiaire, puis
+    recopiés dans chacun des buffers.
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      Track: numéro de piste à lire
+      Sector: numéro du premier secteur de la piste à lire
+      Count: nombre de secteurs à lire
+      BufferVec: tableau de Count pointeurs vers les récipiants des secteurs lus
+    * Retourne:
+      TRUE si succès
+      FALSE si échec (vérifier DLayer->Error pour avoir le détail)
+*****/
+
+BOOL DL_ReadSectors(struct DiskLayer *DLayer, ULONG Track, ULONG Sector, ULONG Count, UBYTE **BufferVec)
+{
+    ULONG i;
+
+    P_DL_DropReadAhead(DLayer,(LONG)Track);
+    DLayer->HeadTrack=(LONG)Track;
+    if(P_DL_IsContiguous(DLayer,Count,BufferVec))
+    {
+        DLayer->Error=DLayer->FuncsPtr->ReadSectors(DLayer->DataLayerPtr,Track,Sector,Count,BufferVec[0]);
+    }
+    else
+    {
+        DLayer->Error=DLayer->FuncsPtr->ReadSectors(DLayer->DataLayerPtr,Track,Sector,Count,DLayer->TrackBufferPtr);
+        if(!DLayer->Error)
+        {
+            for(i=0; i<Count; i++) Sys_MemCopy(BufferVec[i],&DLayer->TrackBufferPtr[i*DLayer->SectorSize],DLayer->SectorSize);
+        }
+    }
+
+    if(DLayer->Error) return FALSE;
+    return TRUE;
+}
+
+
+/*****
+    Ecriture de plusieurs secteurs consécutifs d'une piste.
+    Si les buffers se suivent en mémoire, l'écriture se fait directement en une seule requête.
+    Sinon, les secteurs sont d'abord regroupés dans un buffer intermédiaire.
+    L'écriture est terminée au retour de la fonction, même si la source écrit en tâche de fond.
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      Track: numéro de piste à écrire
+      Sector: numéro du premier secteur de la piste à écrire
+      Count: nombre de secteurs à écrire
+      BufferVec: tableau de Count pointeurs vers les données des secteurs à écrire
+    * Retourne:
+      TRUE si succès
+      FALSE si échec (vérifier DLayer->Error pour avoir le détail)
+*****/
+
+BOOL DL_WriteSectors(struct DiskLayer *DLayer, ULONG Track, ULONG Sector, ULONG Count, UBYTE **BufferVec)
+{
+    if(!P_DL_WriteSectors(DLayer,Track,Sector,Count,BufferVec)) return FALSE;
+    return P_DL_Sync(DLayer);
+}
+
+
+/*****
+    Lecture de plusieurs secteurs consécutifs d'une piste, sans passer par le cache.
+    Seuls les DataSize premiers octets de chaque secteur sont recopiés, bout à bout, dans BufferPtr.
+    Si DataSize correspond à la taille d'un secteur, la lecture se fait directement dans BufferPtr.
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      Track: numéro de piste à lire
+      Sector: numéro du premier secteur de la piste à lire
+      Count: nombre de secteurs à lire
+      BufferPtr: récipiant de Count*DataSize octets
+      DataSize: nombre d'octets utiles par secteur
+    * Retourne:
+      TRUE si succès
+      FALSE si échec (vérifier DLayer->Error pour avoir le détail)
+*****/
+
+BOOL DL_ReadSectorsData(struct DiskLayer *DLayer, ULONG Track, ULONG Sector, ULONG Count, UBYTE *BufferPtr, ULONG DataSize)
+{
+    ULONG i;
+
+    P_DL_DropReadAhead(DLayer,(LONG)Track);
+    DLayer->HeadTrack=(LONG)Track;
+    if(DataSize>=DLayer->SectorSize)
+    {
+        DLayer->Error=DLayer->FuncsPtr->ReadSectors(DLayer->DataLayerPtr,Track,Sector,Count,BufferPtr);
+    }
+    else
+    {
+        DLayer->Error=DLayer->FuncsPtr->ReadSectors(DLayer->DataLayerPtr,Track,Sector,Count,DLayer->TrackBufferPtr);
+        if(!DLayer->Error)
+        {
+            for(i=0; i<Count; i++) Sys_MemCopy(&BufferPtr[i*DataSize],&DLayer->TrackBufferPtr[i*DLayer->SectorSize],(LONG)DataSize);
+        }
+    }
+
     if(DLayer->Error) return FALSE;
     return TRUE;
 }
 
 
 /*****
-    Ecriture des donnes contenues dans le cache
+    Ecriture de plusieurs secteurs consécutifs d'une piste, sans passer par le cache.
+    Chaque secteur reçoit DataSize octets pris bout à bout dans BufferPtr, complétés par des zéros.
+    Si DataSize correspond à la taille d'un secteur, l'écriture se fait directement depuis BufferPtr.
+    Note: les secteurs concernés ne doivent pas être présents dans le cache.
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      Track: numéro de piste à écrire
+      Sector: numéro du premier secteur de la piste à écrire
+      Count: nombre de secteurs à écrire
+      BufferPtr: données à écrire, Count*DataSize octets
+      DataSize: nombre d'octets utiles par secteur
+    * Retourne:
+      TRUE si succès
+      FALSE si échec (vérifier DLayer->Error pour avoir le détail)
+*****/
+
+BOOL DL_WriteSectorsData(struct DiskLayer *DLayer, ULONG Track, ULONG Sector, ULONG Count, const UBYTE *BufferPtr, ULONG DataSize)
+{
+    ULONG i,j;
+
+    P_DL_DropReadAhead(DLayer,(LONG)Track);
+    DLayer->HeadTrack=(LONG)Track;
+    if(DataSize<DLayer->SectorSize)
+    {
+        UBYTE *Ptr=DLayer->TrackBufferPtr;
+
+        for(i=0; i<Count; i++)
+        {
+            Sys_MemCopy(Ptr,(void *)&BufferPtr[i*DataSize],(LONG)DataSize);
+            for(j=DataSize; j<DLayer->SectorSize; j++) Ptr[j]=0;
+            Ptr+=DLayer->SectorSize;
+        }
+        BufferPtr=DLayer->TrackBufferPtr;
+    }
+
+    DLayer->Error=DLayer->FuncsPtr->WriteSectors(DLayer->DataLayerPtr,Track,Sector,Count,BufferPtr);
+    if(DLayer->Error) return FALSE;
+    return P_DL_Sync(DLayer);
+}
+
+
+/*****
+    Ecriture des données contenues dans le cache.
+    Chaque piste qui a des secteurs modifiés reçoit une requête d'écriture, puis la file
+    est traitée dans l'ordre de l'ascenseur à partir de la position de la tête.
+    Les secteurs ne sont marqués comme écrits qu'une fois toutes les écritures terminées
+    sans erreur: en cas d'échec, ils restent modifiés dans le cache.
 *****/
 
 BOOL DL_WriteBufferCache(struct DiskLayer *DLayer)
 {
     BOOL Result=TRUE;
-    struct SectorCacheNode *NodePtr;
+    struct SectorCacheNode *NodePtr=DLayer->SectorCache.FirstUpdatedNodePtr;
+
+    /* La liste des secteurs modifiés est triée par piste */
+    while(Result && NodePtr!=NULL)
+    {
+        struct DiskLayerRequest *ReqPtr=P_DL_GetRequest(DLayer,NodePtr->Track,FALSE);
+
+        /* Si la file est pleine, on traite d'abord les pistes déjà ajoutées. Les secteurs
+           restent dans la liste des secteurs modifiés, donc NodePtr reste valide. */
+        if(ReqPtr==NULL) Result=P_DL_RunQueue(DLayer,NULL);
+        else
+        {
+            ReqPtr->Flags|=DL_REQ_WRITE;
+            while(NodePtr!=NULL && NodePtr->Track==ReqPtr->Track) NodePtr=NodePtr->NextPtr;
+        }
+    }
 
-    while(Result && (NodePtr=Sch_GetMinSectorCacheNode(&DLayer->SectorCache,TRUE))!=NULL)
+    if(Result) Result=P_DL_RunQueue(DLayer,NULL);
+    if(Result) Result=P_DL_Sync(DLayer);
+
+    while(Result && DLayer->SectorCache.FirstUpdatedNodePtr!=NULL)
     {
-        BOOL Result2=DL_WriteSector(DLayer,NodePtr->Track,NodePtr->Sector,NodePtr->BufferPtr);
-        if(Result2) NodePtr->Status=SCN_INITIALIZED; else Result=Result2;
+        Sch_SetStatus(&DLayer->SectorCache,DLayer->SectorCache.FirstUpdatedNodePtr,SCN_INITIALIZED);
     }
 
     return Result;
@@ -305,23 +792,51 @@ BOOL DL_WriteBufferCache(struct DiskLayer *DLayer)
 
 
 /*****
-    Permet de trouver un secteur dans le cache, ou,  dfaut, de librer une nouvelle
+    Ajout d'une lecture anticipée dans la file des requêtes.
+    Les secteurs sont lus lors du prochain passage de la tête sur leur piste, s'ils ne sont
+    pas en cache à ce moment-là, et abandonnés si on accède directement à la piste entre-temps.
+    La demande est ignorée si la piste est hors du disque (voir P_DL_GetRequest() pour le cas
+    d'une file chargée).
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      Track: numéro de piste
+      Sector: numéro du premier secteur à lire
+      Count: nombre de secteurs à lire
+*****/
+
+void DL_QueueReadAhead(struct DiskLayer *DLayer, ULONG Track, ULONG Sector, ULONG Count)
+{
+    struct DiskLayerRequest *ReqPtr=NULL;
+
+    if(Track<DLayer->CountOfTracks) ReqPtr=P_DL_GetRequest(DLayer,(LONG)Track,TRUE);
+    if(ReqPtr!=NULL)
+    {
+        for(; Count>0 && Sector>=1 && Sector<=DLayer->SectorsPerTrack; Count--, Sector++)
+        {
+            ReqPtr->AheadMask|=1UL<<(Sector-1);
+        }
+    }
+}
+
+
+/*****
+    Permet de trouver un secteur dans le cache, ou, à défaut, de libérer une nouvelle
     place dans le cache.
-    Note: Cette fonction tente de rcuprer un secteur du cache, ou d'en allouer un nouveau,
-    soit en librant un vieux cache, soit en allouant de la mmoire, seulement s'il est
+    Note: Cette fonction tente de récupérer un secteur du cache, ou d'en allouer un nouveau,
+    soit en libérant un vieux cache, soit en allouant de la mémoire, seulement s'il est
     possible de le faire.
-    Cette fonction ne lit pas de secteur sur le disque. Ceci doit tre fait par les fonctions
+    Cette fonction ne lit pas de secteur sur le disque. Ceci doit être fait par les fonctions
     DL_GetSector() ou DL_ReadSector().
-    Cette fonction est susceptible de lancer des oprations d'criture pour librer de
+    Cette fonction est susceptible de lancer des opérations d'écriture pour libérer de
     l'espace dans le cache.
-    * Paramtres:
-      DLayer: structure alloue par DFlp_Open()
-      Track: numro de piste  lire
-      Sector: numro du secteur de la piste  lire
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      Track: numéro de piste à lire
+      Sector: numéro du secteur de la piste à lire
       SectorCacheNodePtr: pointeur de pointeur pour obtenir le noeud du cache correspondant
     * Retourne:
-      TRUE si succs
-      FALSE si chec (vrifier DLayer->Error pour avoir le dtail)
+      TRUE si succès
+      FALSE si échec (vérifier DLayer->Error pour avoir le détail)
 *****/
 
 BOOL DL_Obtain(struct DiskLayer *DLayer, LONG Track, LONG Sector, struct SectorCacheNode **SectorCacheNodePtr)
@@ -331,11 +846,11 @@ BOOL DL_Obtain(struct DiskLayer *DLayer, LONG Track, LONG Sector, struct SectorC
 
     DLayer->Error=DL_SUCCESS;
 
-    /* On cherche si le secteur existe dans le cache, sinon on le cre si le cache n'est pas plein */
+    /* On cherche si le secteur existe dans le cache, sinon on le crée si le cache n'est pas plein */
     *SectorCacheNodePtr=Sch_Obtain(&DLayer->SectorCache,Track,Sector,IsCreateIfNotExists);
     if(*SectorCacheNodePtr==NULL)
     {
-        /* Si on tait en mode auto-cration et que le rsultat est nul, alors on retourne une erreur */
+        /* Si on était en mode auto-création et que le résultat est nul, alors on retourne une erreur */
         if(IsCreateIfNotExists)
         {
             DLayer->Error=DL_NOT_ENOUGH_MEMORY;
@@ -343,16 +858,21 @@ BOOL DL_Obtain(struct DiskLayer *DLayer, LONG Track, LONG Sector, struct SectorC
         }
         else
         {
-            /* Tente de librer un ancien cache de secteur non mis  jour */
+            /* Tente de libérer un ancien cache de secteur non mis à jour */
             *SectorCacheNodePtr=Sch_ObtainOlder(&DLayer->SectorCache,Track,Sector);
             if(*SectorCacheNodePtr==NULL)
             {
-                /* Comme il n'y a plus de place, on libre les secteurs qui sont en mode update */
+                /* Comme il n'y a plus de place, on libère les secteurs qui sont en mode update */
                 Result=DL_WriteBufferCache(DLayer);
                 if(Result)
                 {
-                    /* On retente de librer un ancien cache de secteur non mis  jour */
+                    /* On retente de libérer un ancien cache de secteur non mis à jour */
                     *SectorCacheNodePtr=Sch_ObtainOlder(&DLayer->SectorCache,Track,Sector);
+                    if(*SectorCacheNodePtr==NULL)
+                    {
+                        DLayer->Error=DL_NOT_ENOUGH_MEMORY;
+                        Result=FALSE;
+                    }
                 }
             }
         }
@@ -363,16 +883,16 @@ BOOL DL_Obtain(struct DiskLayer *DLayer, LONG Track, LONG Sector, struct SectorC
 
 
 /*****
-    Pour librer un secteur qui serait modifi dans le cache.
-    Le cache est alors invalid, et le secteur est crit sur le disque, si jamais
-    il s'agit d'un secteur modifi seulement.
-    * Paramtres:
-      DLayer: structure alloue par DFlp_Open()
-      Track: numro de piste  librer
-      Sector: numro du secteur de la piste  librer
+    Pour libérer un secteur qui serait modifié dans le cache.
+    Le cache est alors invalidé, et le secteur est écrit sur le disque, si jamais
+    il s'agit d'un secteur modifié seulement.
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      Track: numéro de piste à libérer
+      Sector: numéro du secteur de la piste à libérer
     * Retourne:
-      TRUE si succs
-      FALSE si chec (vrifier DLayer->Error pour avoir le dtail)
+      TRUE si succès
+      FALSE si échec (vérifier DLayer->Error pour avoir le détail)
 *****/
 
 BOOL DL_Release(struct DiskLayer *DLayer, LONG Track, LONG Sector)
@@ -383,7 +903,7 @@ BOOL DL_Release(struct DiskLayer *DLayer, LONG Track, LONG Sector)
     if(NodePtr!=NULL)
     {
         if(NodePtr->Status==SCN_UPDATED) Result=DL_WriteSector(DLayer,Track,Sector,NodePtr->BufferPtr);
-        NodePtr->Status=SCN_NEW;
+        Sch_SetStatus(&DLayer->SectorCache,NodePtr,SCN_NEW);
     }
 
     return Result;
@@ -486,3 +1006,479 @@ BOOL DL_IsDLFatalError(ULONG ErrorCode)
 
     return FALSE;
 }
+
+
+/*****
+    Position physique d'un secteur sur la piste, pour un entrelacement donné.
+    Le secteur 1 est en position 0, chaque secteur suivant est placé Interleave
+    positions plus loin, ou à la première position libre qui suit.
+    * Paramètres:
+      Interleave: entrelacement de la piste
+      SectorsPerTrack: nombre de secteurs par piste (DL_MAX_SECTORS au plus)
+      Sector: numéro du secteur (à partir de 1)
+    * Retourne:
+      Position du secteur, de 0 à SectorsPerTrack-1
+*****/
+
+LONG DL_GetPhysicalSlot(LONG Interleave, LONG SectorsPerTrack, LONG Sector)
+{
+    ULONG UsedMask=0;
+    LONG Slot=0,i;
+
+    if(Interleave<1) Interleave=1;
+    for(i=1; ; i++)
+    {
+        while(UsedMask&(1UL<<Slot)) Slot=(Slot+1)%SectorsPerTrack;
+        if(i>=Sector) break;
+        UsedMask|=1UL<<Slot;
+        Slot=(Slot+Interleave)%SectorsPerTrack;
+    }
+
+    return Slot;
+}
+
+
+/*****
+    Ordre de passage sous la tête d'une suite de secteurs consécutifs d'une piste.
+    L'ordre commence au premier secteur demandé et suit la rotation du disque.
+    * Paramètres:
+      Interleave: entrelacement de la piste
+      SectorsPerTrack: nombre de secteurs par piste
+      Sector: numéro du premier secteur
+      Count: nombre de secteurs
+      OrderPtr: tableau de Count octets qui reçoit les indices (de 0 à Count-1) des
+        secteurs dans l'ordre de passage
+*****/
+
+void DL_GetRotationalOrder(LONG Interleave, LONG SectorsPerTrack, ULONG Sector, ULONG Count, UBYTE *OrderPtr)
+{
+    UBYTE Distance[DL_MAX_SECTORS];
+    LONG FirstSlot=DL_GetPhysicalSlot(Interleave,SectorsPerTrack,(LONG)Sector);
+    ULONG i,j;
+
+    /* Tri par insertion sur la distance en rotation depuis le premier secteur */
+    for(i=0; i<Count; i++)
+    {
+        UBYTE Dist=(UBYTE)((DL_GetPhysicalSlot(Interleave,SectorsPerTrack,(LONG)(Sector+i))-FirstSlot+SectorsPerTrack)%SectorsPerTrack);
+
+        for(j=i; j>0 && Distance[j-1]>Dist; j--)
+        {
+            Distance[j]=Distance[j-1];
+            OrderPtr[j]=OrderPtr[j-1];
+        }
+        Distance[j]=Dist;
+        OrderPtr[j]=(UBYTE)i;
+    }
+}
+
+
+
+/*****
+    Recherche de la requête d'une piste dans la file, ou ajout d'une nouvelle requête.
+    Les lectures anticipées ne peuvent occuper que la moitié de la file, pour qu'il reste
+    toujours de la place pour une lecture demandée et pour les écritures. Au-delà, une
+    nouvelle lecture anticipée prend la place de la lecture anticipée la plus éloignée de
+    la tête, qui a le moins de chances d'être servie.
+    * Retourne:
+      - NULL si la file est pleine
+      - pointeur vers la requête de la piste
+*****/
+
+struct DiskLayerRequest *P_DL_GetRequest(struct DiskLayer *DLayer, LONG Track, BOOL IsReadAhead)
+{
+    struct DiskLayerRequest *ReqPtr;
+    LONG i;
+
+    for(i=0; i<DLayer->CountOfRequests; i++) if(DLayer->Queue[i].Track==Track) return &DLayer->Queue[i];
+
+    if(DLayer->CountOfRequests>=(IsReadAhead?DL_MAX_QUEUE/2:DL_MAX_QUEUE))
+    {
+        LONG BestDist=-1;
+
+        if(!IsReadAhead) return NULL;
+
+        ReqPtr=NULL;
+        for(i=0; i<DLayer->CountOfRequests; i++)
+        {
+            LONG Dist=DLayer->Queue[i].Track-DLayer->HeadTrack;
+
+            if(Dist<0) Dist=-Dist;
+            if(!DLayer->Queue[i].Flags && Dist>BestDist)
+            {
+                ReqPtr=&DLayer->Queue[i];
+                BestDist=Dist;
+            }
+        }
+        if(ReqPtr==NULL) return NULL;
+    }
+    else ReqPtr=&DLayer->Queue[DLayer->CountOfRequests++];
+
+    ReqPtr->Track=Track;
+    ReqPtr->Flags=0;
+    ReqPtr->AheadMask=0;
+
+    return ReqPtr;
+}
+
+
+/*****
+    Retrait de la lecture anticipée d'une piste, suite à un accès direct à cette piste.
+    La requête quitte la file s'il ne lui reste rien d'autre à faire.
+*****/
+
+void P_DL_DropReadAhead(struct DiskLayer *DLayer, LONG Track)
+{
+    LONG i;
+
+    for(i=0; i<DLayer->CountOfRequests; i++)
+    {
+        if(DLayer->Queue[i].Track==Track)
+        {
+            DLayer->Queue[i].AheadMask=0;
+            if(!DLayer->Queue[i].Flags) DLayer->Queue[i]=DLayer->Queue[--DLayer->CountOfRequests];
+            break;
+        }
+    }
+}
+
+
+/*****
+    Traitement des requêtes de la file dans l'ordre de l'ascenseur: la tête continue dans
+    son sens tant qu'il reste des requêtes devant elle, puis repart dans l'autre sens.
+    Toutes les opérations en attente sur une piste sont faites lors du même passage.
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      NodePtr: noeud du cache d'un secteur dont la lecture est demandée, ou NULL pour traiter
+        toutes les écritures en attente. Dans le premier cas, seules les requêtes situées
+        entre la tête et la piste du secteur sont traitées, les autres restent dans la file.
+    * Retourne:
+      TRUE si succès
+      FALSE si échec (vérifier DLayer->Error pour avoir le détail)
+*****/
+
+BOOL P_DL_RunQueue(struct DiskLayer *DLayer, struct SectorCacheNode *NodePtr)
+{
+    BOOL Result=TRUE;
+    LONG Idx;
+
+    if(NodePtr!=NULL) DLayer->Direction=NodePtr->Track<DLayer->HeadTrack?-1:1;
+
+    while(Result && (Idx=P_DL_GetNextRequest(DLayer,NodePtr))>=0)
+    {
+        struct DiskLayerRequest Req=DLayer->Queue[Idx];
+
+        /* La requête est retirée de la file avant d'être traitée */
+        DLayer->Queue[Idx]=DLayer->Queue[--DLayer->CountOfRequests];
+        DLayer->HeadTrack=Req.Track;
+
+        if(Req.Flags&DL_REQ_WRITE) Result=P_DL_ServeWrite(DLayer,Req.Track);
+        if(Result) Result=P_DL_ServeRead(DLayer,&Req,NodePtr);
+
+        if(NodePtr!=NULL && Req.Track==NodePtr->Track) break;
+    }
+
+    return Result;
+}
+
+
+/*****
+    Choix de la prochaine requête à traiter: la plus proche devant la tête.
+    Pour une lecture demandée, on ne considère que les requêtes sur le chemin de la tête
+    jusqu'à la piste du secteur. Sinon, on ne considère que les requêtes d'écriture.
+    * Retourne:
+      -1 s'il n'y a plus de requête à traiter
+      l'indice de la requête dans la file
+*****/
+
+LONG P_DL_GetNextRequest(struct DiskLayer *DLayer, struct SectorCacheNode *NodePtr)
+{
+    LONG Idx=-1,BestDist=0,Pass,i;
+
+    for(Pass=0; Pass<2 && Idx<0; Pass++)
+    {
+        for(i=0; i<DLayer->CountOfRequests; i++)
+        {
+            struct DiskLayerRequest *ReqPtr=&DLayer->Queue[i];
+            LONG Dist=(ReqPtr->Track-DLayer->HeadTrack)*DLayer->Direction;
+
+            if(NodePtr!=NULL)
+            {
+                if(Dist>(NodePtr->Track-DLayer->HeadTrack)*DLayer->Direction) continue;
+            }
+            else if(!(ReqPtr->Flags&DL_REQ_WRITE)) continue;
+
+            if(Dist>=0 && (Idx<0 || Dist<BestDist))
+            {
+                Idx=i;
+                BestDist=Dist;
+            }
+        }
+
+        /* Plus rien devant la tête: on change de sens */
+        if(Idx<0 && NodePtr==NULL) DLayer->Direction=-DLayer->Direction;
+    }
+
+    return Idx;
+}
+
+
+/*****
+    Lecture des secteurs d'une requête en une seule opération, du premier au dernier secteur
+    à lire de la piste. On lit le secteur demandé (NodePtr, s'il est sur cette piste) et les
+    secteurs à lire par anticipation qui ne sont pas en cache.
+    Les secteurs lus par anticipation ne sont ajoutés que s'il reste de la place dans le cache,
+    ou s'il est possible de recycler un secteur non modifié autre que celui demandé, que ce
+    dernier soit sur cette piste ou non. Aucune écriture n'est donc provoquée par cette fonction.
+    * Retourne:
+      TRUE si succès (l'échec d'une lecture anticipée est ignoré)
+      FALSE si échec de la lecture du secteur demandé (vérifier DLayer->Error)
+*****/
+
+BOOL P_DL_ServeRead(struct DiskLayer *DLayer, struct DiskLayerRequest *ReqPtr, struct SectorCacheNode *NodePtr)
+{
+    struct SectorCache *SectorCachePtr=&DLayer->SectorCache;
+    struct SectorCacheNode *ReadNodePtr=NULL;
+    ULONG Mask=ReqPtr->AheadMask;
+    ULONG Sector,First=0,Last=0;
+
+    /* ReadNodePtr est le secteur demandé s'il est lu par cette requête. NodePtr reste le
+       secteur demandé dans tous les cas, pour ne pas le recycler. */
+    if(NodePtr!=NULL && NodePtr->Track==ReqPtr->Track && (ReqPtr->Flags&DL_REQ_READ))
+    {
+        ReadNodePtr=NodePtr;
+        Mask|=1UL<<(NodePtr->Sector-1);
+    }
+
+    for(Sector=1; Sector<=DLayer->SectorsPerTrack; Sector++)
+    {
+        if(Mask&(1UL<<(Sector-1)))
+        {
+            struct SectorCacheNode *CurNodePtr=Sch_Find(SectorCachePtr,ReqPtr->Track,Sector);
+
+            /* Déjà en cache, éventuellement modifié */
+            if(CurNodePtr!=NULL && CurNodePtr!=ReadNodePtr) Mask&=~(1UL<<(Sector-1));
+            else
+            {
+                if(!First) First=Sector;
+                Last=Sector;
+            }
+        }
+    }
+
+    if(!First) return TRUE;
+
+    DLayer->Error=DLayer->FuncsPtr->ReadSectors(DLayer->DataLayerPtr,ReqPtr->Track,First,Last-First+1,DLayer->TrackBufferPtr);
+    if(DLayer->Error)
+    {
+        /* En cas d'échec de la lecture groupée (secteur défectueux par exemple), on abandonne
+           la lecture anticipée et on se rabat sur la lecture du seul secteur demandé */
+        if(ReadNodePtr==NULL) DLayer->Error=DL_SUCCESS;
+        else if(First!=Last) DLayer->Error=DLayer->FuncsPtr->ReadSectors(DLayer->DataLayerPtr,ReqPtr->Track,ReadNodePtr->Sector,1,ReadNodePtr->BufferPtr);
+
+        return DLayer->Error?FALSE:TRUE;
+    }
+
+    for(Sector=First; Sector<=Last; Sector++)
+    {
+        if(Mask&(1UL<<(Sector-1)))
+        {
+            struct SectorCacheNode *CurNodePtr=Sch_Find(SectorCachePtr,ReqPtr->Track,Sector);
+
+            if(CurNodePtr==NULL)
+            {
+                if(Sch_GetCount(SectorCachePtr)<(ULONG)DLayer->CountOfBufferMax) CurNodePtr=Sch_Obtain(SectorCachePtr,ReqPtr->Track,Sector,TRUE);
+                else if(NodePtr==NULL || SectorCachePtr->LastNodePtr!=NodePtr) CurNodePtr=Sch_ObtainOlder(SectorCachePtr,ReqPtr->Track,Sector);
+            }
+
+            if(CurNodePtr!=NULL)
+            {
+                Sys_MemCopy(CurNodePtr->BufferPtr,&DLayer->TrackBufferPtr[(Sector-First)*DLayer->SectorSize],DLayer->SectorSize);
+                if(CurNodePtr!=ReadNodePtr) Sch_SetStatus(SectorCachePtr,CurNodePtr,SCN_INITIALIZED);
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+
+/*****
+    Ecriture des secteurs modifiés d'une piste.
+    Les secteurs modifiés qui se suivent sont écrits en une seule requête: une piste
+    entièrement modifiée est donc écrite en une seule opération.
+    Avec l'option DL_OPT_RMW, une piste qui demanderait plusieurs requêtes est écrite en
+    entier en une seule opération, après lecture des secteurs non modifiés (voir
+    P_DL_FillTrack()).
+    Les écritures peuvent se terminer en tâche de fond: les secteurs restent donc modifiés
+    dans le cache, c'est DL_WriteBufferCache() qui les marque comme écrits.
+*****/
+
+BOOL P_DL_ServeWrite(struct DiskLayer *DLayer, LONG Track)
+{
+    BOOL Result=TRUE;
+    struct SectorCacheNode *NodeVec[DL_MAX_SECTORS];
+    UBYTE *BufferVec[DL_MAX_SECTORS];
+    ULONG Sector,Count=0,CountOfRuns=0;
+
+    for(Sector=1; Sector<=DLayer->SectorsPerTrack; Sector++)
+    {
+        NodeVec[Sector-1]=Sch_Find(&DLayer->SectorCache,Track,Sector);
+        if(NodeVec[Sector-1]!=NULL && NodeVec[Sector-1]->Status==SCN_UPDATED)
+        {
+            if(Sector==1 || NodeVec[Sector-2]==NULL || NodeVec[Sector-2]->Status!=SCN_UPDATED) CountOfRuns++;
+        }
+    }
+
+    if(CountOfRuns>1 && (DLayer->Options&DL_OPT_RMW) && P_DL_FillTrack(DLayer,Track,NodeVec))
+    {
+        DLayer->Error=DLayer->FuncsPtr->WriteSectors(DLayer->DataLayerPtr,Track,1,DLayer->SectorsPerTrack,DLayer->TrackBufferPtr);
+        if(DLayer->Error) return FALSE;
+        return TRUE;
+    }
+
+    for(Sector=1; Result && Sector<=DLayer->SectorsPerTrack+1; Sector++)
+    {
+        struct SectorCacheNode *NodePtr=Sector<=DLayer->SectorsPerTrack?NodeVec[Sector-1]:NULL;
+
+        if(NodePtr!=NULL && NodePtr->Status==SCN_UPDATED)
+        {
+            BufferVec[Count++]=NodePtr->BufferPtr;
+        }
+        else if(Count>0)
+        {
+            Result=P_DL_WriteSectors(DLayer,Track,Sector-Count,Count,BufferVec);
+            Count=0;
+        }
+    }
+
+    return Result;
+}
+
+
+/*****
+    Ecriture de plusieurs secteurs consécutifs d'une piste, sans attendre la fin de
+    l'écriture si la source écrit en tâche de fond (voir DL_WriteSectors()).
+*****/
+
+BOOL P_DL_WriteSectors(struct DiskLayer *DLayer, ULONG Track, ULONG Sector, ULONG Count, UBYTE **BufferVec)
+{
+    ULONG i;
+    UBYTE *BufferPtr=BufferVec[0];
+
+    DLayer->HeadTrack=(LONG)Track;
+    if(!P_DL_IsContiguous(DLayer,Count,BufferVec))
+    {
+        BufferPtr=DLayer->TrackBufferPtr;
+        for(i=0; i<Count; i++) Sys_MemCopy(&BufferPtr[i*DLayer->SectorSize],BufferVec[i],DLayer->SectorSize);
+    }
+
+    DLayer->Error=DLayer->FuncsPtr->WriteSectors(DLayer->DataLayerPtr,Track,Sector,Count,BufferPtr);
+    if(DLayer->Error) return FALSE;
+    return TRUE;
+}
+
+
+/*****
+    Attente de la fin des écritures lancées en tâche de fond par la couche de données.
+    * Retourne:
+      TRUE si toutes les écritures ont réussi
+      FALSE si échec (vérifier DLayer->Error pour avoir le détail)
+*****/
+
+BOOL P_DL_Sync(struct DiskLayer *DLayer)
+{
+    if(DLayer->FuncsPtr->Sync!=NULL)
+    {
+        DLayer->Error=DLayer->FuncsPtr->Sync(DLayer->DataLayerPtr);
+        if(DLayer->Error) return FALSE;
+    }
+
+    return TRUE;
+}
+
+
+/*****
+    Préparation de l'écriture d'une piste complète dans TrackBufferPtr: les secteurs
+    modifiés viennent du cache, les autres sont relus sur le disque. Si tous les secteurs
+    sont en cache, la lecture est évitée.
+    * Paramètres:
+      DLayer: structure allouée par DL_Open()
+      Track: numéro de piste
+      NodeVec: noeuds du cache de chaque secteur de la piste, ou NULL
+    * Retourne:
+      TRUE si succès
+      FALSE si la piste n'a pas pu être lue (il faut alors écrire les secteurs séparément)
+*****/
+
+BOOL P_DL_FillTrack(struct DiskLayer *DLayer, LONG Track, struct SectorCacheNode **NodeVec)
+{
+    ULONG Sector;
+    BOOL IsReadNeeded=FALSE;
+
+    for(Sector=1; Sector<=DLayer->SectorsPerTrack; Sector++)
+    {
+        if(NodeVec[Sector-1]==NULL || NodeVec[Sector-1]->Status==SCN_NEW) IsReadNeeded=TRUE;
+    }
+
+    if(IsReadNeeded && DLayer->FuncsPtr->ReadSectors(DLayer->DataLayerPtr,Track,1,DLayer->SectorsPerTrack,DLayer->TrackBufferPtr)!=DL_SUCCESS) return FALSE;
+
+    for(Sector=1; Sector<=DLayer->SectorsPerTrack; Sector++)
+    {
+        struct SectorCacheNode *NodePtr=NodeVec[Sector-1];
+
+        if(NodePtr!=NULL && (NodePtr->Status==SCN_UPDATED || (!IsReadNeeded && NodePtr->Status==SCN_INITIALIZED)))
+        {
+            Sys_MemCopy(&DLayer->TrackBufferPtr[(Sector-1)*DLayer->SectorSize],NodePtr->BufferPtr,DLayer->SectorSize);
+        }
+    }
+
+    return TRUE;
+}
+
+
+/*****
+    Test si les buffers d'un vecteur se suivent en mémoire
+*****/
+
+BOOL P_DL_IsContiguous(struct DiskLayer *DLayer, ULONG Count, UBYTE **BufferVec)
+{
+    ULONG i;
+
+    for(i=1; i<Count; i++) if(BufferVec[i]!=&BufferVec[i-1][DLayer->SectorSize]) return FALSE;
+
+    return TRUE;
+}
+
+
+/*****
+    Test si une chaîne se termine par un suffixe (sans tenir compte de la casse)
+*****/
+
+BOOL P_DL_IsSuffix(const char *Name, const char *Suffix)
+{
+    LONG NameLen=Sys_StrLen(Name),SuffixLen=Sys_StrLen(Suffix);
+
+    if(NameLen>=SuffixLen && Sys_StrCmpNoCase(&Name[NameLen-SuffixLen],Suffix)==0) return TRUE;
+
+    return FALSE;
+}
+
+
+/*****
+    Test si une chaîne est un préfixe suivi de la fin de chaîne ou de ':'
+    (sans tenir compte de la casse)
+*****/
+
+BOOL P_DL_IsPrefix(const char *Name, const char *Prefix)
+{
+    while(*Prefix!=0)
+    {
+        if(Sys_CharToLower(*Name)!=Sys_CharToLower(*Prefix)) return FALSE;
+        Name++;
+        Prefix++;
+    }
+
+    if(*Name==0 || *Name==':') return TRUE;
+
+    return FALSE;
+}
@@ -8,6 +8,19 @@
 #define DISKLAYER_TYPE_TDS          2
 #define DISKLAYER_TYPE_FD           3
 #define DISKLAYER_TYPE_SAP          4
+#define DISKLAYER_TYPE_RAM          5
+#define DISKLAYER_TYPE_SIM          6
+
+#define DL_MAX_SECTORS              32      /* Nombre maximum de secteurs par piste */
+#define DL_MAX_QUEUE                32      /* Nombre maximum de pistes dans la file des requêtes */
+
+/* Options de la couche disque */
+#define DL_OPT_TRACKREAD            0x01    /* Lecture d'une piste complète sur défaut de cache */
+#define DL_OPT_RMW                  0x02    /* Ecriture des pistes partiellement modifiées en entier */
+
+/* Opérations en attente sur une piste de la file des requêtes */
+#define DL_REQ_READ                 0x01    /* Lecture d'un secteur demandé */
+#define DL_REQ_WRITE                0x02    /* Ecriture des secteurs modifiés du cache */
 
 #define DL_SUCCESS                  0
 #define DL_NOT_ENOUGH_MEMORY        1
@@ -24,14 +37,57 @@
 #define DL_UNKNOWN_TYPE             12
 
 
+struct DataLayerSimStats;   /* Voir datalayersim.h */
+
+/* Fonctions d'une couche de données (lecteur de disquette, image disque...) */
+struct DataLayerFuncs
+{
+    void *(*Open)(const char *, ULONG, ULONG, ULONG, LONG, LONG, LONG, void (*)(void *, void *), void *, ULONG *);
+    void (*Close)(void *);
+    BOOL (*IsDiskIn)(void *);
+    BOOL (*IsProtected)(void *);
+    void (*Clean)(void *);
+    ULONG (*Finalize)(void *);
+    ULONG (*FormatTrack)(void *, ULONG, ULONG, const UBYTE *);
+    ULONG (*ReadSectors)(void *, ULONG, ULONG, ULONG, UBYTE *);
+    ULONG (*WriteSectors)(void *, ULONG, ULONG, ULONG, const UBYTE *);
+    BOOL (*IsChanged)(void *);
+    void (*SetChanged)(void *, BOOL);
+    void (*MotorOff)(void *);       /* NULL si la source n'a pas de moteur */
+    ULONG (*Sync)(void *);          /* NULL si les écritures de la source sont synchrones */
+    BOOL (*SetProtected)(void *, BOOL);     /* NULL si la protection ne se change pas par logiciel */
+    BOOL (*ChangeDisk)(void *, BOOL);       /* NULL si le disque ne se change pas par logiciel */
+    BOOL (*GetSimStats)(void *, struct DataLayerSimStats *, BOOL); /* NULL si la source n'est pas simulée */
+};
+
+
+struct DiskLayerRequest
+{
+    LONG Track;
+    ULONG Flags;            /* DL_REQ_... */
+    ULONG AheadMask;        /* Secteurs à lire par anticipation (bit 0 = secteur 1) */
+};
+
+
 struct DiskLayer
 {
     struct SectorCache SectorCache;
+    ULONG Type;
+    const struct DataLayerFuncs *FuncsPtr;
     ULONG Unit;
     ULONG Side;
+    ULONG Options;
+    ULONG CountOfTracks;
+    ULONG SectorsPerTrack;
+    ULONG SectorSize;
+    UBYTE *TrackBufferPtr;
     LONG CountOfBufferMax;
     void *DataLayerPtr;
     ULONG Error;
+    LONG HeadTrack;         /* Dernière piste accédée */
+    LONG Direction;         /* Sens de parcours de la file: 1 ou -1 */
+    LONG CountOfRequests;
+    struct DiskLayerRequest Queue[DL_MAX_QUEUE];
 };
 
 
@@ -39,23 +95,37 @@ struct DiskLayer
 /***** PUBLIQUES UTILISABLES PAR *****/
 /***** D'AUTRES BLOCS DU PROJET  *****/
 
-extern struct DiskLayer *DL_Open(const char *, ULONG, ULONG, ULONG, ULONG, ULONG, LONG, void (*)(struct DiskLayer *, void *), void *, ULONG *);
+extern const struct DataLayerFuncs *DL_FuncsTable[];
+
+extern struct DiskLayer *DL_Open(const char *, ULONG, ULONG, ULONG, ULONG, ULONG, ULONG, ULONG, LONG, void (*)(struct DiskLayer *, void *), void *, ULONG *);
+extern ULONG DL_GetTypeFromName(const char *);
 extern void DL_Close(struct DiskLayer *);
 extern LONG DL_SetBufferMax(struct DiskLayer *, LONG, LONG);
 extern BOOL DL_IsDiskIn(struct DiskLayer *);
 extern BOOL DL_IsProtected(struct DiskLayer *);
+extern BOOL DL_SetProtected(struct DiskLayer *, BOOL);
+extern BOOL DL_ChangeDisk(struct DiskLayer *, BOOL);
+extern BOOL DL_GetSimStats(struct DiskLayer *, struct DataLayerSimStats *, BOOL);
 extern void DL_Clean(struct DiskLayer *);
 extern BOOL DL_IsChanged(struct DiskLayer *);
 extern void DL_SetChanged(struct DiskLayer *, BOOL);
 extern BOOL DL_Finalize(struct DiskLayer *, BOOL);
+extern void DL_MotorOff(struct DiskLayer *);
 extern BOOL DL_FormatTrack(struct DiskLayer *, ULONG, ULONG, const UBYTE *);
 extern BOOL DL_ReadSector(struct DiskLayer *, ULONG, ULONG, UBYTE *);
 extern BOOL DL_WriteSector(struct DiskLayer *, ULONG, ULONG, const UBYTE *);
+extern BOOL DL_ReadSectors(struct DiskLayer *, ULONG, ULONG, ULONG, UBYTE **);
+extern BOOL DL_WriteSectors(struct DiskLayer *, ULONG, ULONG, ULONG, UBYTE **);
+extern BOOL DL_ReadSectorsData(struct DiskLayer *, ULONG, ULONG, ULONG, UBYTE *, ULONG);
+extern BOOL DL_WriteSectorsData(struct DiskLayer *, ULONG, ULONG, ULONG, const UBYTE *, ULONG);
 extern BOOL DL_GetSector(struct DiskLayer *, ULONG, ULONG, BOOL, struct SectorCacheNode **);
 extern BOOL DL_WriteBufferCache(struct DiskLayer *);
+extern void DL_QueueReadAhead(struct DiskLayer *, ULONG, ULONG, ULONG);
 extern ULONG DL_GetError(struct DiskLayer *);
 extern const char *DL_GetDLTextErr(ULONG);
 extern BOOL DL_IsDLFatalError(ULONG);
+extern LONG DL_GetPhysicalSlot(LONG, LONG, LONG);
+extern void DL_GetRotationalOrder(LONG, LONG, ULONG, ULONG, UBYTE *);
 
 
 #endif  /* DISKLAYER_H */
\ No newline at end of file
@@ -6,22 +6,33 @@
 
 
 /*
-    23-04-2021 (Seg)    Gestion du mode tendu via un flag
-    23-09-2020 (Seg)    Modifs suite amlioration de la gestion du cache
+    17-10-2026 (Seg)    Un transfert direct en écriture qui échoue rétablit la fin du fichier
+    17-10-2026 (Seg)    Comptage et bitmap des clusters libres tenus à jour à chaque modification de la FAT
+    17-10-2026 (Seg)    Compteur de génération du répertoire
+    17-10-2026 (Seg)    Table des entrées décodées du répertoire pour FS_ExamineNextFileObject()
+    17-10-2026 (Seg)    Mémorisation des noms absents pour FS_FindFile()
+    17-10-2026 (Seg)    Index des noms de fichiers pour FS_FindFile()
+    17-10-2026 (Seg)    Copies par blocs et transfert direct des secteurs complets hors cache
+    17-10-2026 (Seg)    Taille du fichier conservée dans le handle
+    17-10-2026 (Seg)    Liste des clusters du fichier dans le handle pour localiser un offset en temps constant
+    17-10-2026 (Seg)    Lecture anticipée du bloc suivant lors de la lecture d'un fichier
+    17-10-2026 (Seg)    Lecture/écriture de la piste système par requêtes multi-secteurs
+    23-04-2021 (Seg)    Gestion du mode étendu via un flag
+    23-09-2020 (Seg)    Modifs suite amélioration de la gestion du cache
     10-09-2020 (Seg)    Refonte totale
     28-08-2018 (Seg)    Fix sur FS_FindFile()
     27-08-2018 (Seg)    Remaniement suite gestion des noms avec accents
-    13-08-2018 (Seg)    Gestion des paramtres gomtriques du disque et gestion des infos .CHG
+    13-08-2018 (Seg)    Gestion des paramètres géométriques du disque et gestion des infos .CHG
     01-10-2016 (Seg)    Ajout de FS_GetVolumeDate()
     13-09-2016 (Seg)    Ajout de FS_FlushFileInfo() et modification de FS_CloseFile(),
                         FS_SetComment(), FS_SetDate(), FS_RenameFile(), FS_DeleteFile()
                         et FS_DeleteFileFromIdx()
     12-09-2016 (Seg)    Ajout de FS_DeleteFileFromIdx()
-    31-08-2016 (Seg)    Amlioration de FS_InitFileSystem()
-    23-08-2016 (Seg)    Ajout option IsSetDate lors de la cration d'un nouveau fichier
+    31-08-2016 (Seg)    Amélioration de FS_InitFileSystem()
+    23-08-2016 (Seg)    Ajout option IsSetDate lors de la création d'un nouveau fichier
     22-08-2016 (Seg)    Ajout de la fonction FS_RenameFile()
-    23-09-2013 (Seg)    Adaptation du code suite  la migration sous Unix
-    06-10-2012 (Seg)    Fix problme de gestion de date (sur les annes)
+    23-09-2013 (Seg)    Adaptation du code suite à la migration sous Unix
+    06-10-2012 (Seg)    Fix problème de gestion de date (sur les années)
     23-03-2010 (Seg)    Gestion du case sensitive dans le scrutage de fichier
     22-03-2010 (Seg)    Gestion des fonctions de scrutage de fichiers
     24-02-2010 (Seg)    Ajout de la fonction FS_GetSize()
@@ -69,17 +80,35 @@ struct FSHandle *P_FS_SubOpenFile(struct FileSystem *, LONG, LONG, const char *,
 LONG P_FS_CreateNewFile(struct FSHandle *, const char *, const LONG *, BOOL);
 void P_FS_SetMetaData(struct FileSystem *, LONG, LONG, LONG, LONG, LONG, LONG, LONG, LONG, LONG);
 LONG P_FS_GetTypeFromFileInfo(UBYTE *);
+LONG P_FS_LocateFileChunk(struct FSHandle *, LONG, BOOL, LONG *, LONG *, LONG *, LONG *);
 LONG P_FS_ObtainFileChunk(struct FSHandle *, LONG, BOOL, LONG *, LONG *, struct SectorCacheNode **);
 void P_FS_ReleaseFileChunk(struct FSHandle *, struct SectorCacheNode *, LONG);
+void P_FS_ExtendEndOfFile(struct FSHandle *, LONG);
+LONG P_FS_TransferSectors(struct FSHandle *, UBYTE *, LONG, BOOL);
 void P_FS_Terminate(struct FileSystem *, LONG, LONG, LONG, LONG);
 void P_FS_SetFileInfoFlags(struct FileSystem *, LONG);
 LONG P_FS_AllocNewCluster(struct FileSystem *, LONG, LONG);
 LONG P_FS_GetGeoDetailFromOffset(struct FSHandle *, LONG, BOOL, LONG *, LONG *, LONG *, LONG *);
 void P_FS_FreeClusters(struct FileSystem *, LONG);
+void P_FS_SetFAT(struct FileSystem *, LONG, UBYTE);
+void P_FS_BuildFreeMap(struct FileSystem *);
+LONG P_FS_FindFreeCluster(struct FileSystem *, LONG);
 LONG P_FS_CalcFileSize(struct FileSystem *, LONG, LONG, LONG *);
 UBYTE *P_FS_GetFileInfo(struct FileSystem *, LONG);
 LONG P_FS_GetFirstCluster(struct FileSystem *, LONG);
 LONG P_FS_GetLastSectorLen(struct FileSystem *, LONG);
+void P_FS_UpdateClusterList(struct FSHandle *);
+LONG P_FS_GetTailOffset(struct FSHandle *);
+void P_FS_AppendToClusterLists(struct FileSystem *, LONG, LONG, LONG);
+void P_FS_BuildNameIndex(struct FileSystem *);
+void P_FS_AddName(struct FileSystem *, LONG);
+void P_FS_RemoveName(struct FileSystem *, LONG);
+LONG P_FS_FindName(struct FileSystem *, const char *, const LONG *, BOOL);
+ULONG P_FS_GetNameKey(const char *, BOOL);
+BOOL P_FS_IsMissingName(struct FileSystem *, const char *, BOOL);
+void P_FS_AddMissingName(struct FileSystem *, const char *, BOOL);
+struct FileObject *P_FS_GetFileObject(struct FileSystem *, LONG);
+void P_FS_DecodeFileObject(struct FileSystem *, LONG, struct FileObject *);
 
 struct FSHandle *P_FS_AddNewHandle(struct FileSystem *);
 void P_FS_RemoveHandle(struct FileSystem *, struct FSHandle *);
@@ -91,7 +120,9 @@ void P_FS_RemoveHandle(struct FileSystem *, struct FSHandle *);
 
 struct FileSystem *FS_AllocFileSystem(LONG MaxTracks, LONG SectorSize, LONG SectorsPerTrack, BOOL IsExtended)
 {
-    struct FileSystem *FS=(struct FileSystem *)Sys_AllocMem(sizeof(struct FileSystem)+SectorSize*SectorsPerTrack);
+    LONG MaxFiles=SectorSize/SIZEOF_FILEINFO*(SectorsPerTrack-2);
+    LONG FreeMapLen=(MaxTracks*2+31)/32; /* Un bit par cluster, à raison de 2 clusters par piste */
+    struct FileSystem *FS=(struct FileSystem *)Sys_AllocMem(sizeof(struct FileSystem)+MaxFiles*(sizeof(struct FSName)+sizeof(struct FSObject))+FreeMapLen*sizeof(ULONG)+SectorSize*SectorsPerTrack);
 
     if(FS!=NULL)
     {
@@ -110,7 +141,10 @@ struct FileSystem *FS_AllocFileSystem(LONG MaxTracks, LONG SectorSize, LONG Sect
         FS->MaxBlocks=FS->MaxTracks*FS->BlocksPerTrack;
         FS->ClusterSys=FS->TrackSys*FS->BlocksPerTrack;
 
-        FS->Sys=&((UBYTE *)FS)[sizeof(struct FileSystem)];
+        FS->Names=(struct FSName *)&((UBYTE *)FS)[sizeof(struct FileSystem)];
+        FS->Objects=(struct FSObject *)&FS->Names[MaxFiles];
+        FS->FreeMap=(ULONG *)&FS->Objects[MaxFiles];
+        FS->Sys=(UBYTE *)&FS->FreeMap[FreeMapLen];
         FS->Label=FS->Sys;
         FS->FAT=&FS->Sys[(FS->SectorFAT-1)*SectorSize];
         FS->Dir=&FS->FAT[SectorSize];
@@ -121,7 +155,7 @@ struct FileSystem *FS_AllocFileSystem(LONG MaxTracks, LONG SectorSize, LONG Sect
 
 
 /*****
-    Libre les ressources alloues par FS_AllocFileSystem()
+    Libère les ressources allouées par FS_AllocFileSystem()
 *****/
 
 void FS_FreeFileSystem(struct FileSystem *FS)
@@ -131,9 +165,9 @@ void FS_FreeFileSystem(struct FileSystem *FS)
 
 
 /*****
-    Initialisation de la structure FileSystem alloue par FS_AllocFileSystem()
+    Initialisation de la structure FileSystem allouée par FS_AllocFileSystem()
     Retour:
-    - FS_SUCCESS si tout s'est bien pass et que la disquette est DOS
+    - FS_SUCCESS si tout s'est bien passé et que la disquette est DOS
     - FS_NOT_DOS_DISK si la disquette n'est pas DOS
     - FS_DISKLAYER_ERROR en cas d'erreur I/O
 *****/
@@ -142,19 +176,16 @@ LONG FS_InitFileSystem(struct FileSystem *FS, struct DiskLayer *DiskLayerPtr)
 {
     LONG Result=FS_SUCCESS,i;
     UBYTE *Ptr=FS->Sys;
+    UBYTE *BufferVec[DL_MAX_SECTORS];
 
     FS->DiskLayerPtr=DiskLayerPtr;
+    FS->FATGeneration++;
 
-    /* Lecture de la piste systme */
-    for(i=1; i<=FS->SectorsPerTrack && Result>=0; i++)
-    {
-        if(!DL_ReadSector(FS->DiskLayerPtr,FS->TrackSys,i,&Ptr[(i-1)*FS->SectorSize]))
-        {
-            Result=FS_DISKLAYER_ERROR;
-        }
-    }
+    /* Lecture de la piste système en une seule requête */
+    for(i=0; i<FS->SectorsPerTrack; i++) BufferVec[i]=&Ptr[i*FS->SectorSize];
+    if(!DL_ReadSectors(FS->DiskLayerPtr,FS->TrackSys,1,FS->SectorsPerTrack,BufferVec)) Result=FS_DISKLAYER_ERROR;
 
-    /* On contrle s'il s'agit bien d'un disque DOS */
+    /* On contrôle s'il s'agit bien d'un disque DOS */
     if(Result>=0)
     {
         Ptr=FS->FAT;
@@ -165,33 +196,53 @@ LONG FS_InitFileSystem(struct FileSystem *FS, struct DiskLayer *DiskLayerPtr)
         }
     }
 
+    /* Construction de l'index des noms et de la table des clusters libres */
+    P_FS_BuildNameIndex(FS);
+    P_FS_BuildFreeMap(FS);
+
+    /* Décodage des entrées du répertoire pour les scans à venir */
+    if(Result>=0)
+    {
+        for(i=0; i<FS->MaxFiles; i++)
+        {
+            if(FS->Names[i].Name[0]!=0) P_FS_GetFileObject(FS,i);
+        }
+    }
+
     return Result;
 }
 
 
 /*****
-    Met  jour la FAT et les FileInfo des fichiers modifis
+    Met à jour la FAT et les FileInfo des fichiers modifiés
 *****/
 
 LONG FS_FlushFileInfo(struct FileSystem *FS)
 {
     LONG Result=FS_SUCCESS;
-    LONG Sector;
+    LONG Sector,Count;
+    ULONG Flags=FS->FileInfoFlags;
+    UBYTE *BufferVec[DL_MAX_SECTORS];
 
-    /* Etape 1: Mise  jour de la FAT */
-    if(FS->IsFATUpdated)
-    {
-        if(!DL_WriteSector(FS->DiskLayerPtr,FS->TrackSys,FS->SectorFAT,FS->FAT)) Result=FS_DISKLAYER_ERROR;
-        else FS->IsFATUpdated=FALSE;
-    }
+    /* On regroupe la FAT et les secteurs d'infos des fichiers à mettre à jour */
+    if(FS->IsFATUpdated) Flags|=1<<(FS->SectorFAT-1);
 
-    /* Etape 2: Mise  jour des infos des fichiers */
-    for(Sector=0; Sector<32 && Result>=0; Sector++)
+    /* Les secteurs qui se suivent sont écrits en une seule requête */
+    for(Sector=0; Sector<FS->SectorsPerTrack && Result>=0; Sector+=Count)
     {
-        if(FS->FileInfoFlags&(1<<Sector))
+        Count=0;
+        while(Sector+Count<FS->SectorsPerTrack && (Flags&(1<<(Sector+Count))))
+        {
+            BufferVec[Count]=&FS->Label[(Sector+Count)*FS->SectorSize];
+            Count++;
+        }
+
+        if(Count==0) Count=1;
+        else if(!DL_WriteSectors(FS->DiskLayerPtr,FS->TrackSys,Sector+1,Count,BufferVec)) Result=FS_DISKLAYER_ERROR;
+        else
         {
-            if(!DL_WriteSector(FS->DiskLayerPtr,FS->TrackSys,Sector+1,&FS->Label[Sector*FS->SectorSize])) Result=FS_DISKLAYER_ERROR;
-            else FS->FileInfoFlags&=~(1<<Sector);
+            if(Sector<FS->SectorFAT && Sector+Count>=FS->SectorFAT) FS->IsFATUpdated=FALSE;
+            FS->FileInfoFlags&=~(((1<<Count)-1)<<Sector);
         }
     }
 
@@ -200,10 +251,10 @@ LONG FS_FlushFileInfo(struct FileSystem *FS)
 
 
 /*****
-    Initialisation du file system (quivalent d'un format quick)
-    Note: La disquette doit avoir t formate en low level
+    Initialisation du file system (équivalent d'un format quick)
+    Note: La disquette doit avoir été formatée en low level
     Retour:
-    - FS_SUCCESS si tout s'est bien pass
+    - FS_SUCCESS si tout s'est bien passé
     - FS_DISKLAYER_ERROR en cas d'erreur I/O
 *****/
 
@@ -219,7 +270,7 @@ LONG FS_Format(struct FileSystem *FS, const char *VolumeName)
 
     if(FS->IsExtended)
     {
-        /* Nouveau: on installe la date et l'heure courante, dans le mme format que pour les fichiers */
+        /* Nouveau: on installe la date et l'heure courante, dans le même format que pour les fichiers */
         Sys_GetTime(&Year,&Month,&Day,&Hour,&Min,&Sec);
         Ptr[FV_DAY]=(UBYTE)Day;
         Ptr[FV_MONTH]=(UBYTE)Month;
@@ -231,13 +282,18 @@ LONG FS_Format(struct FileSystem *FS, const char *VolumeName)
 
     /* Initialisation de la FAT */
     Ptr=FS->FAT;
+    FS->FATGeneration++;
     for(i=FS->MaxBlocks+1; i<FS->SectorSize; i++) Ptr[i]=0;
     Ptr[FS->ClusterSys+1]=CLST_RESERVED;
     Ptr[FS->ClusterSys+2]=CLST_RESERVED;
+    P_FS_BuildNameIndex(FS);
+    P_FS_BuildFreeMap(FS);
 
-    for(i=1; i<=FS->SectorsPerTrack && Result>=0; i++)
     {
-        if(!DL_WriteSector(FS->DiskLayerPtr,FS->TrackSys,i,&FS->Label[(i-1)*FS->SectorSize])) Result=FS_DISKLAYER_ERROR;
+        UBYTE *BufferVec[DL_MAX_SECTORS];
+
+        for(i=0; i<FS->SectorsPerTrack; i++) BufferVec[i]=&FS->Label[i*FS->SectorSize];
+        if(!DL_WriteSectors(FS->DiskLayerPtr,FS->TrackSys,1,FS->SectorsPerTrack,BufferVec)) Result=FS_DISKLAYER_ERROR;
     }
 
     return Result;
@@ -245,7 +301,7 @@ LONG FS_Format(struct FileSystem *FS, const char *VolumeName)
 
 
 /*****
-    Initialisation d'une structure FileObject en vue de scanner un rpertoire
+    Initialisation d'une structure FileObject en vue de scanner un répertoire
 *****/
 
 void FS_ExamineFileObject(struct FileSystem *FS, struct FileObject *FO)
@@ -256,10 +312,10 @@ void FS_ExamineFileObject(struct FileSystem *FS, struct FileObject *FO)
 
 
 /*****
-    Scanne le rpertoire
+    Scanne le répertoire
     Retour:
-    - TRUE s'il y a une nouvelle entre
-    - FALSE si on est en fin de rpertoire
+    - TRUE s'il y a une nouvelle entrée
+    - FALSE si on est en fin de répertoire
 *****/
 
 BOOL FS_ExamineNextFileObject(struct FileObject *FO)
@@ -272,28 +328,8 @@ BOOL FS_ExamineNextFileObject(struct FileObject *FO)
 
         if(FileInfo[FIO_NAME]!=FST_ERASED && FileInfo[FIO_NAME]!=FST_NONE)
         {
-            LONG Cluster=(LONG)FileInfo[FIO_FIRST_CLUSTER];
-            LONG EndSize=(((LONG)FileInfo[FIO_LAST_SEC_LEN])<<8)+(LONG)FileInfo[FIO_LAST_SEC_LEN+1];
-            LONG Year=(LONG)FileInfo[FIO_YEAR];
-            char Suffix[SIZEOF_TOSUFFIX+sizeof(char)];
-
-            Utl_FixedStringToCString(&FileInfo[FIO_SUFFIX],SIZEOF_TOSUFFIX,Suffix);
-
-            Cnv_ConvertThomsonNameToHostName(FileInfo,FO->Name,TRUE);
-            Cnv_ConvertThomsonCommentToHostComment(&FileInfo[FIO_COMMENT],FO->Comment,TRUE);
-            FO->Day=(LONG)FileInfo[FIO_DAY];
-            FO->Month=(LONG)FileInfo[FIO_MONTH];
-            FO->Year=Year+(Year<80?2000:1900);
-            FO->Hour=FS->IsExtended?(LONG)FileInfo[FIO_HOUR]:0;
-            FO->Min=FS->IsExtended?(LONG)FileInfo[FIO_MIN]:0;
-            FO->Sec=FS->IsExtended?(LONG)FileInfo[FIO_SEC]:0;
-            FO->Type=P_FS_GetTypeFromFileInfo(FileInfo);
-            FO->ExtraData=Sys_StrCmp(Suffix,"CHG")==0?((LONG)FileInfo[FIO_CHG1]<<8)+(LONG)FileInfo[FIO_CHG2]:-1;
-            FO->Size=P_FS_CalcFileSize(FS,Cluster,EndSize,&FO->CountOfBlocks);
-
-            FO->IsDateOk=FO->Day>=1 && FO->Day<=31 && FO->Month>=1 && FO->Month<=12?TRUE:FALSE;
-            FO->IsTimeOk=FO->IsDateOk && (FO->Hour!=0 || FO->Min!=0 || FO->Sec!=0)?TRUE:FALSE;
-
+            /* Simple copie de l'entrée décodée */
+            *FO=*P_FS_GetFileObject(FS,FO->FileInfoIdx);
             return TRUE;
         }
     }
@@ -303,7 +339,7 @@ BOOL FS_ExamineNextFileObject(struct FileObject *FO)
 
 
 /*****
-    Ouverture d'un fichier sur le file system  partir de son index dans le rpertoire
+    Ouverture d'un fichier sur le file system à partir de son index dans le répertoire
 *****/
 
 struct FSHandle *FS_OpenFileFromIdx(struct FileSystem *FS, LONG Mode, LONG Idx, BOOL IsSetDate, LONG *ErrorCode)
@@ -325,11 +361,11 @@ struct FSHandle *FS_OpenFile(struct FileSystem *FS, LONG Mode, const char *Name,
 
 
 /*****
-    Fermeture des ressources alloues par FS_OpenFile()
+    Fermeture des ressources allouées par FS_OpenFile()
 
-    Note: Cette fonction ne met pas  jour la FAT et le descripteur du fichier.
-    Il faut utiliser FS_FlushFileInfo() pour mettre  jour ces derniers, une fois
-    que toutes les oprations d'criture sont termines.
+    Note: Cette fonction ne met pas à jour la FAT et le descripteur du fichier.
+    Il faut utiliser FS_FlushFileInfo() pour mettre à jour ces derniers, une fois
+    que toutes les opérations d'écriture sont terminées.
 *****/
 
 LONG FS_CloseFile(struct FSHandle *h)
@@ -365,22 +401,31 @@ LONG FS_ReadFile(struct FSHandle *h, UBYTE *Buffer, LONG Len)
         LONG Pos=0,End=0;
         struct SectorCacheNode *SectorCacheNodePtr=NULL;
 
-        /* Rcupration du secteur correspondant  l'offset en cours */
-        Result=P_FS_ObtainFileChunk(h,h->Offset,FALSE,&Pos,&End,&SectorCacheNodePtr);
-        if(Pos>=End) break;
-        /* Note: si Pos<End alors Result est forcment success.
-           Si Pos>=End, alors soit on est en fin de fichier, soit Result est en chec.
-        */
-
-        /* Lecture du contenu du secteur */
-        while(Pos<End && RestLen>0)
+        /* Les secteurs complets qui ne sont pas en cache sont lus directement dans le buffer */
+        Result=P_FS_TransferSectors(h,Buffer,RestLen,FALSE);
+        if(Result>0)
         {
-            *(Buffer++)=SectorCacheNodePtr->BufferPtr[Pos++];
-            h->Offset++;
-            RestLen--;
+            Buffer+=Result;
+            RestLen-=Result;
+        }
+        else
+        {
+            /* Récupération du secteur correspondant à l'offset en cours */
+            if(Result>=0) Result=P_FS_ObtainFileChunk(h,h->Offset,FALSE,&Pos,&End,&SectorCacheNodePtr);
+            if(Pos>=End) break;
+            /* Note: si Pos<End alors Result est forcément success.
+               Si Pos>=End, alors soit on est en fin de fichier, soit Result est en échec.
+            */
+
+            /* Lecture du contenu du secteur */
+            if(End-Pos>RestLen) End=Pos+RestLen;
+            Sys_MemCopy(Buffer,&SectorCacheNodePtr->BufferPtr[Pos],End-Pos);
+            Buffer+=End-Pos;
+            h->Offset+=End-Pos;
+            RestLen-=End-Pos;
+
+            P_FS_ReleaseFileChunk(h,SectorCacheNodePtr,-1);
         }
-
-        P_FS_ReleaseFileChunk(h,SectorCacheNodePtr,-1);
     }
 
     if(Result>=0) Result=Len-RestLen;
@@ -390,9 +435,9 @@ LONG FS_ReadFile(struct FSHandle *h, UBYTE *Buffer, LONG Len)
 
 
 /*****
-    Routine d'criture du fichier
+    Routine d'écriture du fichier
     Retourne:
-    - Le nombre d'octets crits
+    - Le nombre d'octets écrits
     - 0 si la disquette est pleine
     - FS_DISKLAYER_ERROR en cas d'erreur I/O
 *****/
@@ -408,19 +453,29 @@ LONG FS_WriteFile(struct FSHandle *h, UBYTE *Buffer, LONG Len)
         struct SectorCacheNode *SectorCacheNodePtr;
         LONG PreviousSize=FS_GetSize(h);
 
-        /* Rcupration du secteur correspondant  l'offset en cours */
-        Result=P_FS_ObtainFileChunk(h,h->Offset,TRUE,&Pos,&End,&SectorCacheNodePtr);
+        /* Les secteurs complets qui ne sont pas en cache sont écrits directement depuis le buffer */
+        Result=P_FS_TransferSectors(h,Buffer,RestLen,TRUE);
         if(Result<0) break;
-
-        /* Ecrasement du secteur */
-        while(Pos<End && RestLen>0)
+        if(Result>0)
         {
-            SectorCacheNodePtr->BufferPtr[Pos++]=*(Buffer++);
-            h->Offset++;
-            RestLen--;
+            Buffer+=Result;
+            RestLen-=Result;
+        }
+        else
+        {
+            /* Récupération du secteur correspondant à l'offset en cours */
+            Result=P_FS_ObtainFileChunk(h,h->Offset,TRUE,&Pos,&End,&SectorCacheNodePtr);
+            if(Result<0) break;
+
+            /* Ecrasement du secteur */
+            if(End-Pos>RestLen) End=Pos+RestLen;
+            Sys_MemCopy(&SectorCacheNodePtr->BufferPtr[Pos],Buffer,End-Pos);
+            Buffer+=End-Pos;
+            h->Offset+=End-Pos;
+            RestLen-=End-Pos;
+
+            P_FS_ReleaseFileChunk(h,SectorCacheNodePtr,PreviousSize);
         }
-
-        P_FS_ReleaseFileChunk(h,SectorCacheNodePtr,PreviousSize);
     }
 
     if(Result>=0) Result=Len-RestLen;
@@ -452,11 +507,14 @@ LONG FS_Seek(struct FSHandle *h, LONG Pos)
 
 LONG FS_GetSize(struct FSHandle *h)
 {
-    LONG Cluster=P_FS_GetFirstCluster(h->FS,h->FileInfoIdx);
-    LONG EndSize=P_FS_GetLastSectorLen(h->FS,h->FileInfoIdx);
-    LONG Count;
+    /* La taille n'est recalculée que si elle a été invalidée par P_FS_Terminate() */
+    if(h->Size<0)
+    {
+        h->Size=0;
+        if(P_FS_GetFirstCluster(h->FS,h->FileInfoIdx)<=CLST_TERM) h->Size=P_FS_GetTailOffset(h)+P_FS_GetLastSectorLen(h->FS,h->FileInfoIdx);
+    }
 
-    return P_FS_CalcFileSize(h->FS,Cluster,EndSize,&Count);
+    return h->Size;
 }
 
 
@@ -464,7 +522,7 @@ LONG FS_GetSize(struct FSHandle *h)
 /*****
     Permet de retailler un fichier
     Retour:
-    - >=0 si tout s'est bien pass
+    - >=0 si tout s'est bien passé
     - FS_DISK_FULL s'il n'y a pas assez de place sur le disque
 *****/
 
@@ -480,8 +538,9 @@ LONG FS_SetSize(struct FSHandle *h, LONG NewSize)
         /* On supprime les clusters inutiles, s'ils existent */
         P_FS_FreeClusters(FS,Cluster);
 
-        /* On redfinit les infos de fin de fichier */
+        /* On redéfinit les infos de fin de fichier */
         P_FS_Terminate(FS,h->FileInfoIdx,Cluster,IdxSector,Pos);
+        h->Size=Result;
 
         if(NewSize<h->Offset) h->Offset=NewSize;
     }
@@ -493,13 +552,13 @@ LONG FS_SetSize(struct FSHandle *h, LONG NewSize)
 /*****
     Renomme un fichier
     Retour:
-    - >=0 si tout s'est bien pass
+    - >=0 si tout s'est bien passé
     - FS_FILE_NOT_FOUND si le fichier source n'existe pas
-    - FS_RENAME_CONFLICT si le nouveau nom existe dj
+    - FS_RENAME_CONFLICT si le nouveau nom existe déjà
 
-    Note: Cette fonction ne met pas  jour le descripteur du fichier.
-    Il faut utiliser FS_FlushFileInfo() pour mettre  jour ce dernier, une fois
-    que toutes les oprations d'criture sont termines.
+    Note: Cette fonction ne met pas à jour le descripteur du fichier.
+    Il faut utiliser FS_FlushFileInfo() pour mettre à jour ce dernier, une fois
+    que toutes les opérations d'écriture sont terminées.
 *****/
 
 LONG FS_RenameFile(struct FileSystem *FS, const char *NameOld, const LONG *Type, BOOL IsSensitive, const char *NameNew)
@@ -508,13 +567,15 @@ LONG FS_RenameFile(struct FileSystem *FS, const char *NameOld, const LONG *Type,
 
     if(Result>=0)
     {
-        /* On regarde si le nouveau nom existe dj */
+        /* On regarde si le nouveau nom existe déjà */
         if(FS_FindFile(FS,NameNew,Type,IsSensitive)<0)
         {
             UBYTE *FileInfo=P_FS_GetFileInfo(FS,Result);
 
             /* Remplacement du nom original */
+            P_FS_RemoveName(FS,Result);
             Cnv_ConvertHostNameToThomsonName(NameNew,&FileInfo[FIO_NAME]);
+            P_FS_AddName(FS,Result);
 
             /* On flag pour sauvegarder plus tard les modifications */
             P_FS_SetFileInfoFlags(FS,Result);
@@ -526,14 +587,14 @@ LONG FS_RenameFile(struct FileSystem *FS, const char *NameOld, const LONG *Type,
 
 
 /*****
-    Efface un fichier dans le rpertoire du file system
+    Efface un fichier dans le répertoire du file system
     Retour:
-    - >=0 si tout s'est bien pass,
+    - >=0 si tout s'est bien passé,
     - FS_FILE_NOT_FOUND si le fichier n'existe pas
 
-    Note: Cette fonction ne met pas  jour la FAT et le descripteur du fichier.
-    Il faut utiliser FS_FlushFileInfo() pour mettre  jour ces derniers, une fois
-    que toutes les oprations d'criture sont termines.
+    Note: Cette fonction ne met pas à jour la FAT et le descripteur du fichier.
+    Il faut utiliser FS_FlushFileInfo() pour mettre à jour ces derniers, une fois
+    que toutes les opérations d'écriture sont terminées.
 *****/
 
 LONG FS_DeleteFile(struct FileSystem *FS, const char *Name, const LONG *Type, BOOL IsSensitive)
@@ -550,13 +611,13 @@ LONG FS_DeleteFile(struct FileSystem *FS, const char *Name, const LONG *Type, BO
 
 
 /*****
-    Efface un fichier dans le rpertoire du file system,  partir de son index dans le rpertoire
+    Efface un fichier dans le répertoire du file system, à partir de son index dans le répertoire
     Retour:
-    - FS_SUCCESS si tout s'est bien pass,
+    - FS_SUCCESS si tout s'est bien passé,
 
-    Note: Cette fonction ne met pas  jour la FAT et le descripteur du fichier.
-    Il faut utiliser FS_FlushFileInfo() pour mettre  jour ces derniers, une fois
-    que toutes les oprations d'criture sont termines.
+    Note: Cette fonction ne met pas à jour la FAT et le descripteur du fichier.
+    Il faut utiliser FS_FlushFileInfo() pour mettre à jour ces derniers, une fois
+    que toutes les opérations d'écriture sont terminées.
 *****/
 
 LONG FS_DeleteFileFromIdx(struct FileSystem *FS, LONG Idx)
@@ -565,7 +626,8 @@ LONG FS_DeleteFileFromIdx(struct FileSystem *FS, LONG Idx)
     UBYTE *FileInfo=P_FS_GetFileInfo(FS,Idx);
     LONG Cluster=P_FS_GetFirstCluster(FS,Idx);
 
-    /* Effacement du fichier dans le rpertoire */
+    /* Effacement du fichier dans le répertoire */
+    P_FS_RemoveName(FS,Idx);
     FileInfo[FIO_NAME]=FST_ERASED;
 
     /* Effacement du fichier dans la FAT */
@@ -581,12 +643,12 @@ LONG FS_DeleteFileFromIdx(struct FileSystem *FS, LONG Idx)
 /*****
     Ecriture du commentaire d'un fichier
     Retour:
-    - >=0 si tout s'est bien pass,
+    - >=0 si tout s'est bien passé,
     - FS_FILE_NOT_FOUND si le fichier n'existe pas
 
-    Note: Cette fonction ne met pas  jour le descripteur du fichier.
-    Il faut utiliser FS_FlushFileInfo() pour mettre  jour ce dernier, une fois
-    que toutes les oprations d'criture sont termines.
+    Note: Cette fonction ne met pas à jour le descripteur du fichier.
+    Il faut utiliser FS_FlushFileInfo() pour mettre à jour ce dernier, une fois
+    que toutes les opérations d'écriture sont terminées.
 *****/
 
 LONG FS_SetComment(struct FileSystem *FS, const char *Name, const LONG *Type, BOOL IsSensitive, const char *Comment)
@@ -613,12 +675,12 @@ LONG FS_SetComment(struct FileSystem *FS, const char *Name, const LONG *Type, BO
 /*****
     Ecriture de la date d'un fichier
     Retour:
-    - >=0 si tout s'est bien pass,
+    - >=0 si tout s'est bien passé,
     - FS_FILE_NOT_FOUND si le fichier n'existe pas
 
-    Note: Cette fonction ne met pas  jour le descripteur du fichier.
-    Il faut utiliser FS_FlushFileInfo() pour mettre  jour ce dernier, une fois
-    que toutes les oprations d'criture sont termines.
+    Note: Cette fonction ne met pas à jour le descripteur du fichier.
+    Il faut utiliser FS_FlushFileInfo() pour mettre à jour ce dernier, une fois
+    que toutes les opérations d'écriture sont terminées.
 *****/
 
 LONG FS_SetDate(struct FileSystem *FS, const char *Name, const LONG *Type, BOOL IsSensitive, LONG Year, LONG Month, LONG Day, LONG Hour, LONG Min, LONG Sec)
@@ -638,64 +700,31 @@ LONG FS_SetDate(struct FileSystem *FS, const char *Name, const LONG *Type, BOOL
     Recherche un nom de fichier dans la table des noms de fichier
     Retour:
     - l'offset sur les informations du fichier dans le buffer "Dir",
-      ainsi que le numro de la piste et le numro du secteur qui contient
+      ainsi que le numéro de la piste et le numéro du secteur qui contient
       les informations sur le fichier.
     - FS_FILE_NOT_FOUND si le fichier n'existe pas
 *****/
 
 LONG FS_FindFile(struct FileSystem *FS, const char *Name, const LONG *Type, BOOL IsSensitive)
 {
-    char CurrentName[SIZEOF_CONV_HOSTNAME+sizeof(char)],FinalName[SIZEOF_CONV_HOSTNAME+sizeof(char)];
-    LONG FileInfoIdx=FS_FILE_NOT_FOUND,Idx;
-    LONG FIIdxS=FS_FILE_NOT_FOUND;
-    LONG FIIdxI=FS_FILE_NOT_FOUND;
-    BOOL FoundS=FALSE,FoundI=FALSE;
+    char FinalName[SIZEOF_CONV_HOSTNAME+sizeof(char)];
+    LONG FileInfoIdx;
 
-    /* On rduit le nom pass en paramtre, au format Thomson, c'est--dire
-        12 caractres (avec le point de sparation nom/suffixe).
-       De cette manire, en mode cration, on vite la cration de doublons de
-       fichiers aprs rduction du nom.
+    /* On réduit le nom passé en paramètre, au format Thomson, c'est-à-dire
+       à 12 caractères (avec le point de séparation nom/suffixe).
+       De cette manière, en mode création, on évite la création de doublons de
+       fichiers après réduction du nom.
     */
-    Cnv_SplitHostName(Name,FinalName);
-    for(Idx=0; Idx<FS->MaxFiles; Idx++)
-    {
-        UBYTE *FileInfo=P_FS_GetFileInfo(FS,Idx);
-        UBYTE FileStatus=FileInfo[FIO_NAME];
+    /* Les noms déjà cherchés en vain sont rejetés tant qu'aucun nom n'a été ajouté au répertoire */
+    if(Type==NULL && P_FS_IsMissingName(FS,Name,IsSensitive)) return FS_FILE_NOT_FOUND;
 
-        if(FileStatus!=FST_NONE && FileStatus!=FST_ERASED)
-        {
-            LONG Type2=P_FS_GetTypeFromFileInfo(FileInfo);
-
-            Cnv_ConvertThomsonNameToHostName(FileInfo,CurrentName,TRUE);
-            if(Utl_CompareHostName(CurrentName,&Type2,FinalName,Type,FALSE)==0 && !FoundS)
-            {
-                if(Type!=NULL)
-                {
-                    ULONG CurrentType=P_FS_GetTypeFromFileInfo(FileInfo);
-                    if(CurrentType==*Type) {FIIdxS=Idx; FoundS=TRUE;}
-                } else if(FIIdxS<0) FIIdxS=Idx;
-            }
-
-            if(Utl_CompareHostName(CurrentName,NULL,FinalName,NULL,TRUE)==0 && !FoundI)
-            {
-                if(Type!=NULL)
-                {
-                    ULONG CurrentType=P_FS_GetTypeFromFileInfo(FileInfo);
-                    if(CurrentType==*Type) {FIIdxI=Idx; FoundI=TRUE;}
-                } else if(FIIdxI<0) FIIdxI=Idx;
-            }
-        }
-    }
+    Cnv_SplitHostName(Name,FinalName);
 
-    if(FIIdxS>=0)
-    {
-        if(Type==NULL || (Type!=NULL && FoundS)) FileInfoIdx=FIIdxS;
-    }
+    /* Recherche dans l'index des noms, avec les mêmes comparaisons que Utl_CompareHostName() */
+    FileInfoIdx=P_FS_FindName(FS,FinalName,Type,FALSE);
+    if(FileInfoIdx<0 && !IsSensitive) FileInfoIdx=P_FS_FindName(FS,FinalName,Type,TRUE);
 
-    if(FIIdxI>=0 && FileInfoIdx<0 && !IsSensitive)
-    {
-        if(Type==NULL || (Type!=NULL && FoundI)) FileInfoIdx=FIIdxI;
-    }
+    if(FileInfoIdx<0 && Type==NULL) P_FS_AddMissingName(FS,Name,IsSensitive);
 
     return FileInfoIdx;
 }
@@ -713,8 +742,8 @@ LONG FS_GetTypeFromHandle(struct FSHandle *h)
 
 
 /*****
-    Permet d'extraire les informations de nom et de type  partir de
-    l'index du fichier dans le rpertoire.
+    Permet d'extraire les informations de nom et de type à partir de
+    l'index du fichier dans le répertoire.
 *****/
 
 void FS_GetNameTypeFromIndex(struct FileSystem *FS, LONG Index, char *Name, LONG *Type)
@@ -725,7 +754,7 @@ void FS_GetNameTypeFromIndex(struct FileSystem *FS, LONG Index, char *Name, LONG
     {
         UBYTE *FileInfo=P_FS_GetFileInfo(FS,Index);
 
-        Cnv_ConvertThomsonNameToHostName(FileInfo,Name,TRUE);
+        Sys_StrCopy(Name,FS->Names[Index].Name,sizeof(FS->Names[Index].Name));
         *Type=P_FS_GetTypeFromFileInfo(FileInfo);
     }
 }
@@ -749,6 +778,7 @@ LONG FS_SetVolumeName(struct FileSystem *FS, const char *VolumeName)
 {
     LONG Result=FS_SUCCESS;
 
+    FS->CountOfMissingNames=0;
     Cnv_ConvertHostLabelToThomsonLabel(VolumeName,&FS->Label[FV_NAME]);
     if(!DL_WriteSector(FS->DiskLayerPtr,FS->TrackSys,1,FS->Label)) Result=FS_DISKLAYER_ERROR;
 
@@ -792,28 +822,21 @@ BOOL FS_GetVolumeDate(struct FileSystem *FS, LONG *Year, LONG *Month, LONG *Day,
 
 LONG FS_GetFreeSpace(struct FileSystem *FS)
 {
-    LONG i,Count=0;
-
-    for(i=1;i<=FS->MaxBlocks;i++) if(FS->FAT[i]==CLST_FREE) Count++;
-
-    return FS->BlocksPerTrack*Count;
+    return FS->BlocksPerTrack*FS->CountOfFreeClusters;
 }
 
 
 /*****
     Calcule le nombre de blocs disponibles et le nombre de blocs
-    utiliss sur la disquette
+    utilisés sur la disquette
     Note: Pas d'erreur I/O possible
 *****/
 
 LONG FS_GetBlockSpace(struct FileSystem *FS, LONG *CountUsedSpace)
 {
-    LONG i,Count=0;
-
-    for(i=1;i<=FS->MaxBlocks;i++) if(FS->FAT[i]==CLST_FREE) Count++;
-    if(CountUsedSpace!=NULL) *CountUsedSpace=FS->MaxBlocks-Count;
+    if(CountUsedSpace!=NULL) *CountUsedSpace=FS->MaxBlocks-FS->CountOfFreeClusters;
 
-    return Count;
+    return FS->CountOfFreeClusters;
 }
 
 
@@ -881,6 +904,8 @@ struct FSHandle *P_FS_SubOpenFile(struct FileSystem *FS, LONG Mode, LONG Idx, co
         h->Mode=Mode;
         h->FileInfoIdx=Idx;
         h->Offset=0;
+        h->Size=-1;
+        h->CountOfClusters=0;
 
         switch(Mode)
         {
@@ -915,7 +940,7 @@ struct FSHandle *P_FS_SubOpenFile(struct FileSystem *FS, LONG Mode, LONG Idx, co
 
 
 /*****
-    Cration d'un nouveau fichier
+    Création d'un nouveau fichier
 *****/
 
 LONG P_FS_CreateNewFile(struct FSHandle *h, const char *Name, const LONG *Type, BOOL IsSetDate)
@@ -952,12 +977,13 @@ LONG P_FS_CreateNewFile(struct FSHandle *h, const char *Name, const LONG *Type,
             Cnv_ConvertHostNameToThomsonName(Name,&FileInfo[FIO_NAME]);
             Cnv_ConvertHostCommentToThomsonComment("",&FileInfo[FIO_COMMENT],NULL,NULL);
             FileInfo[FIO_FIRST_CLUSTER]=Cluster;
+            P_FS_AddName(FS,FileInfoIdx);
 
             /* Date/Heure et Type */
             if(IsSetDate) Sys_GetTime(&Year,&Month,&Day,&Hour,&Min,&Sec);
             P_FS_SetMetaData(FS,FileInfoIdx,Year,Month,Day,Hour,Min,Sec,*Type,-1);
 
-            /* On flag pour les mises  jour faites sur le nom, sachant que AllocNewCluster et SetMetaData l'ont dj flagu... */
+            /* On flag pour les mises à jour faites sur le nom, sachant que AllocNewCluster et SetMetaData l'ont déjà flagué... */
             P_FS_SetFileInfoFlags(FS,FileInfoIdx);
         }
     }
@@ -967,7 +993,7 @@ LONG P_FS_CreateNewFile(struct FSHandle *h, const char *Name, const LONG *Type,
 
 
 /*****
-    Permet de modifier les donnes annexes du fichier (type, date et extradata)
+    Permet de modifier les données annexes du fichier (type, date et extradata)
 *****/
 
 void P_FS_SetMetaData(struct FileSystem *FS, LONG FileInfoIdx, LONG Year, LONG Month, LONG Day, LONG Hour, LONG Min, LONG Sec, LONG Type, LONG ExtraData)
@@ -1001,7 +1027,7 @@ void P_FS_SetMetaData(struct FileSystem *FS, LONG FileInfoIdx, LONG Year, LONG M
         IsChanged=TRUE;
     }
 
-    /* Gestion des donnes annexes */
+    /* Gestion des données annexes */
     if(ExtraData>=0)
     {
         FileInfo[FIO_CHG1]=(UBYTE)(ExtraData>>8);
@@ -1015,7 +1041,7 @@ void P_FS_SetMetaData(struct FileSystem *FS, LONG FileInfoIdx, LONG Year, LONG M
 
 
 /*****
-    Extraction du type d'un fichier  partir de sa structure FileInfo
+    Extraction du type d'un fichier à partir de sa structure FileInfo
 *****/
 
 LONG P_FS_GetTypeFromFileInfo(UBYTE *FileInfo)
@@ -1025,31 +1051,29 @@ LONG P_FS_GetTypeFromFileInfo(UBYTE *FileInfo)
 
 
 /*****
-    Retourne le morceau du fichier cibl par l'offset
-    * Paramtres:
+    Localise le secteur du fichier ciblé par l'offset
+    * Paramètres:
       h: handle
-      Offset: l'offset cibl
-      IsWrite: pour indiquer si on va crire ou lire dans le chunk. En mode criture, la fonction agrandit le fichier.
-      Pos: pour retourner la position de l'offset dans le chunk
-      End: pour indiquer la fin du chunk
-      SectorCacheNodePtr: retourne le pointeur sur le chunk
+      Offset: l'offset ciblé
+      IsWrite: pour indiquer si on va écrire ou lire dans le secteur. En mode écriture, la fonction agrandit le fichier.
+      Cluster: retourne le cluster du secteur
+      IdxSector: retourne l'index du secteur dans le cluster
+      Pos: pour retourner la position de l'offset dans le secteur
+      End: pour indiquer la fin des données du secteur
     * Retourne:
-      >=0 succs. Sinon, code d'erreur
+      >=0 succès. Sinon, code d'erreur
 *****/
-LONG P_FS_ObtainFileChunk(struct FSHandle *h, LONG Offset, BOOL IsWrite, LONG *Pos, LONG *End, struct SectorCacheNode **SectorCacheNodePtr)
+
+LONG P_FS_LocateFileChunk(struct FSHandle *h, LONG Offset, BOOL IsWrite, LONG *Cluster, LONG *IdxSector, LONG *Pos, LONG *End)
 {
     LONG Result;
-    LONG Cluster;
-    LONG IdxSector;
     struct FileSystem *FS=h->FS;
 
-    *SectorCacheNodePtr=NULL;
-
-    /* On rcupre les infos sur la position de l'offset */
-    Result=P_FS_GetGeoDetailFromOffset(h,Offset,FALSE,&Cluster,&IdxSector,Pos,End);
+    /* On récupère les infos sur la position de l'offset */
+    Result=P_FS_GetGeoDetailFromOffset(h,Offset,FALSE,Cluster,IdxSector,Pos,End);
     if(Result>=0 && IsWrite)
     {
-        /* En mode criture, on utilise tout le secteur en cours */
+        /* En mode écriture, on utilise tout le secteur en cours */
         *End=FS->FSSectorSize;
 
         /* On teste s'il ne reste plus de place sur le secteur en cours */
@@ -1058,23 +1082,51 @@ LONG P_FS_ObtainFileChunk(struct FSHandle *h, LONG Offset, BOOL IsWrite, LONG *P
             *Pos=0;
 
             /* S'il ne reste plus de place, on teste s'il reste un secteur dispo sur le bloc en cours */
-            if(IdxSector+1<FS->SectorsPerBlock)
+            if(*IdxSector+1<FS->SectorsPerBlock)
             {
-                IdxSector++;
-                P_FS_Terminate(FS,h->FileInfoIdx,Cluster,IdxSector,0);
+                (*IdxSector)++;
+                P_FS_Terminate(FS,h->FileInfoIdx,*Cluster,*IdxSector,0);
             }
             else
             {
-                /* Si le bloc en cours est compltement plein, on tente d'agrandir le fichier */
-                IdxSector=0;
-                Cluster=P_FS_AllocNewCluster(FS,h->FileInfoIdx,Cluster);
-                if(Cluster<0) Result=Cluster; /* = code d'erreur d'AllocNewCluster */
+                /* Si le bloc en cours est complètement plein, on tente d'agrandir le fichier */
+                *IdxSector=0;
+                *Cluster=P_FS_AllocNewCluster(FS,h->FileInfoIdx,*Cluster);
+                if(*Cluster<0) Result=*Cluster; /* = code d'erreur d'AllocNewCluster */
             }
         }
     }
 
+    return Result;
+}
+
+
+/*****
+    Retourne le morceau du fichier ciblé par l'offset
+    * Paramètres:
+      h: handle
+      Offset: l'offset ciblé
+      IsWrite: pour indiquer si on va écrire ou lire dans le chunk. En mode écriture, la fonction agrandit le fichier.
+      Pos: pour retourner la position de l'offset dans le chunk
+      End: pour indiquer la fin du chunk
+      SectorCacheNodePtr: retourne le pointeur sur le chunk
+    * Retourne:
+      >=0 succès. Sinon, code d'erreur
+*****/
+LONG P_FS_ObtainFileChunk(struct FSHandle *h, LONG Offset, BOOL IsWrite, LONG *Pos, LONG *End, struct SectorCacheNode **SectorCacheNodePtr)
+{
+    LONG Result;
+    LONG Cluster;
+    LONG IdxSector;
+    struct FileSystem *FS=h->FS;
+
+    *SectorCacheNodePtr=NULL;
+
+    /* On récupère les infos sur la position de l'offset */
+    Result=P_FS_LocateFileChunk(h,Offset,IsWrite,&Cluster,&IdxSector,Pos,End);
+
     /* Si pas d'erreur (ex: disque plein) ou que l'on n'est pas en fin de fichier (en mode
-       ReadOnly), alors on rcupre les donnes du secteur.
+       ReadOnly), alors on récupère les données du secteur.
     */
     if(Result>=0 && *Pos<*End)
     {
@@ -1082,9 +1134,15 @@ LONG P_FS_ObtainFileChunk(struct FSHandle *h, LONG Offset, BOOL IsWrite, LONG *P
         LONG Sector=((Cluster&1)*FS->SectorsPerBlock)+IdxSector+1;
         struct DiskLayer *DLayer=FS->DiskLayerPtr;
 
-        /* On tente de rcuprer le cache du secteur */
-        BOOL IsSuccess=DL_GetSector(DLayer,Track,Sector,TRUE,SectorCacheNodePtr);
-        if(!IsSuccess) Result=DLayer->Error?FS_DISKLAYER_ERROR:FS_NOT_ENOUGH_MEMORY;
+        /* En lecture, on demande dès le début d'un bloc la lecture anticipée du bloc suivant */
+        if(!IsWrite && IdxSector==0)
+        {
+            LONG NextCluster=(LONG)FS->FAT[Cluster+1];
+            if(NextCluster<=CLST_TERM) DL_QueueReadAhead(DLayer,NextCluster>>1,((NextCluster&1)*FS->SectorsPerBlock)+1,FS->SectorsPerBlock);
+        }
+
+        /* On tente de récupérer le cache du secteur */
+        if(!DL_GetSector(DLayer,Track,Sector,TRUE,SectorCacheNodePtr)) Result=DLayer->Error?FS_DISKLAYER_ERROR:FS_NOT_ENOUGH_MEMORY;
     }
 
     return Result;
@@ -1092,37 +1150,143 @@ LONG P_FS_ObtainFileChunk(struct FSHandle *h, LONG Offset, BOOL IsWrite, LONG *P
 
 
 /*****
-    Permet de fermer le chunk prcdemment ouvert par P_FS_ObtainFileChunk().
-    Cette fonction permet de redfinir la fin du fichier si celui-ci a grossi.
-    * Paramtres:
+    Permet de fermer le chunk précédemment ouvert par P_FS_ObtainFileChunk().
+    Cette fonction permet de redéfinir la fin du fichier si celui-ci a grossi.
+    * Paramètres:
       h: handle du fichier
-      SectorCacheNodePtr: pointeur prcdemment fourni par P_FS_ObtainFileChunk()
-      PreviousSize: -1 si on tait en lecture seule, sinon transmettre la nouvelle taille du fichier
+      SectorCacheNodePtr: pointeur précédemment fourni par P_FS_ObtainFileChunk()
+      PreviousSize: -1 si on était en lecture seule, sinon transmettre la nouvelle taille du fichier
 *****/
 
 void P_FS_ReleaseFileChunk(struct FSHandle *h, struct SectorCacheNode *SectorCacheNodePtr, LONG PreviousSize)
+{
+    P_FS_ExtendEndOfFile(h,PreviousSize);
+    Sch_Release(&h->FS->DiskLayerPtr->SectorCache,SectorCacheNodePtr,PreviousSize<0?FALSE:TRUE);
+}
+
+
+/*****
+    Redéfinit la fin du fichier si l'offset du handle a dépassé la taille précédente.
+    * Paramètres:
+      h: handle du fichier
+      PreviousSize: -1 si on était en lecture seule, sinon la taille du fichier avant l'écriture
+*****/
+
+void P_FS_ExtendEndOfFile(struct FSHandle *h, LONG PreviousSize)
 {
     if(PreviousSize>=0 && h->Offset>PreviousSize)
     {
-        LONG Count;
-        LONG Cluster=P_FS_GetFirstCluster(h->FS,h->FileInfoIdx);
-        LONG EndLen=h->Offset-P_FS_CalcFileSize(h->FS,Cluster,0,&Count);
+        LONG EndLen=h->Offset-P_FS_GetTailOffset(h);
         P_FS_Terminate(h->FS,h->FileInfoIdx,-1,-1,EndLen);
+        h->Size=h->Offset;
+    }
+}
+
+
+/*****
+    Transfert direct entre le buffer de l'appelant et le disque, sans passer par le cache.
+    Seuls les secteurs complets, consécutifs sur une même piste et absents du cache sont
+    regroupés en une seule requête. Le transfert direct n'est tenté que si la demande
+    couvre au moins un bloc, pour laisser les petites lectures profiter de la lecture
+    anticipée du cache.
+    En cas d'échec d'une écriture, le fichier retrouve sa taille d'avant l'appel.
+    * Paramètres:
+      h: handle du fichier
+      Buffer: buffer de l'appelant
+      Len: nombre d'octets restant à transférer
+      IsWrite: TRUE pour écrire, FALSE pour lire
+    * Retourne:
+      >0: le nombre d'octets transférés
+      0: pas de transfert direct possible à l'offset en cours
+      <0: code d'erreur
+*****/
+
+LONG P_FS_TransferSectors(struct FSHandle *h, UBYTE *Buffer, LONG Len, BOOL IsWrite)
+{
+    LONG Result=0;
+    struct FileSystem *FS=h->FS;
+    struct DiskLayer *DLayer=FS->DiskLayerPtr;
+    LONG Offset=h->Offset;
+    LONG Track=-1,FirstSector=0,Count=0;
+    LONG OldSize=-1,TailCluster=-1,TailFAT=0,LastSectorLen=0;
+    BOOL IsNext=Len>=FS->SectorsPerBlock*FS->FSSectorSize?TRUE:FALSE;
+
+    /* En écriture, le regroupement agrandit le fichier au fur et à mesure: on mémorise la fin
+       du fichier pour pouvoir la rétablir si l'écriture échoue */
+    if(IsWrite && IsNext)
+    {
+        OldSize=FS_GetSize(h);
+        P_FS_UpdateClusterList(h);
+        TailCluster=(LONG)h->ClusterList[h->CountOfClusters-1];
+        if(TailCluster<=CLST_TERM) TailFAT=(LONG)FS->FAT[TailCluster+1];
+        LastSectorLen=P_FS_GetLastSectorLen(FS,h->FileInfoIdx);
     }
 
-    Sch_Release(SectorCacheNodePtr,PreviousSize<0?FALSE:TRUE);
+    /* On regroupe les secteurs tant qu'ils se suivent sur la piste */
+    while(IsNext && Len-Count*FS->FSSectorSize>=FS->FSSectorSize)
+    {
+        LONG Cluster,IdxSector,Pos,End;
+        LONG PreviousSize=IsWrite?FS_GetSize(h):-1;
+
+        IsNext=FALSE;
+        if(P_FS_LocateFileChunk(h,h->Offset,IsWrite,&Cluster,&IdxSector,&Pos,&End)>=0 && Pos==0 && End>=FS->FSSectorSize)
+        {
+            LONG Sector=((Cluster&1)*FS->SectorsPerBlock)+IdxSector+1;
+
+            if((Count==0 || (Cluster>>1==Track && Sector==FirstSector+Count))
+               && Sch_Find(&DLayer->SectorCache,Cluster>>1,Sector)==NULL)
+            {
+                if(Count==0)
+                {
+                    Track=Cluster>>1;
+                    FirstSector=Sector;
+                }
+                Count++;
+                h->Offset+=FS->FSSectorSize;
+                P_FS_ExtendEndOfFile(h,PreviousSize);
+                IsNext=TRUE;
+            }
+        }
+    }
+
+    /* Transfert de tous les secteurs en une seule requête */
+    if(Count>0)
+    {
+        BOOL IsSuccess;
+
+        if(IsWrite) IsSuccess=DL_WriteSectorsData(DLayer,Track,FirstSector,Count,Buffer,FS->FSSectorSize);
+        else IsSuccess=DL_ReadSectorsData(DLayer,Track,FirstSector,Count,Buffer,FS->FSSectorSize);
+
+        Result=Count*FS->FSSectorSize;
+        if(!IsSuccess)
+        {
+            h->Offset=Offset;
+            Result=FS_DISKLAYER_ERROR;
+
+            /* Les clusters ajoutés sont libérés, et la fin du fichier est rétablie */
+            if(IsWrite && TailCluster<=CLST_TERM && FS_GetSize(h)>OldSize)
+            {
+                if(FS->FAT[TailCluster+1]<=CLST_TERM) P_FS_FreeClusters(FS,(LONG)FS->FAT[TailCluster+1]);
+                P_FS_SetFAT(FS,TailCluster,(UBYTE)TailFAT);
+                FS->IsFATUpdated=TRUE;
+                P_FS_Terminate(FS,h->FileInfoIdx,-1,-1,LastSectorLen);
+            }
+        }
+    }
+
+    return Result;
 }
 
 
 /*****
-    Pour redfinir la fin d'un fichier
+    Pour redéfinir la fin d'un fichier
 *****/
 
 void P_FS_Terminate(struct FileSystem *FS, LONG FileInfoIdx, LONG Cluster, LONG IdxSector, LONG EndLen)
 {
     if(Cluster>=0 && IdxSector>=0)
     {
-        FS->FAT[Cluster+1]=CLST_TERM+IdxSector+1;
+        P_FS_SetFAT(FS,Cluster,(UBYTE)(CLST_TERM+IdxSector+1));
         FS->IsFATUpdated=TRUE;
     }
 
@@ -1133,24 +1297,35 @@ void P_FS_Terminate(struct FileSystem *FS, LONG FileInfoIdx, LONG Cluster, LONG
         FileInfo[FIO_LAST_SEC_LEN+1]=(UBYTE)EndLen;
         P_FS_SetFileInfoFlags(FS,FileInfoIdx);
     }
+
+    /* La taille mémorisée dans les handles ouverts sur le fichier n'est plus à jour */
+    if(FileInfoIdx>=0)
+    {
+        struct FSHandle *h;
+        for(h=FS->FirstHandlePtr; h!=NULL; h=h->NextHandlePtr) if(h->FileInfoIdx==FileInfoIdx) h->Size=-1;
+        FS->Objects[FileInfoIdx].IsUpToDate=FALSE;
+        FS->DirGeneration++;
+    }
 }
 
 
 /*****
-    Pour flaguer comme quoi des infos de fichier ont t mises  jour
+    Pour flaguer comme quoi des infos de fichier ont été mises à jour
 *****/
 
 void P_FS_SetFileInfoFlags(struct FileSystem *FS, LONG FileInfoIdx)
 {
     FS->FileInfoFlags|=1<<(FileInfoIdx/FS->FilesPerSector+2);
+    FS->Objects[FileInfoIdx].IsUpToDate=FALSE;
+    FS->DirGeneration++;
 }
 
 /*****
-    Permet d'allouer un nouveau cluster  la suite de celui pass en paramtre.
-    * Paramtres:
+    Permet d'allouer un nouveau cluster à la suite de celui passé en paramètre.
+    * Paramètres:
       FS: Poiteur sur la structure FileSystem
       FileInfoIdx: Index sur le File Info ou -1
-      Cluster: Cluster prcdent, ou -1 si on cre un nouveau fichier
+      Cluster: Cluster précédent, ou -1 si on crée un nouveau fichier
     * Retourne:
       >=0: nouveau cluster
       <0: code d'erreur
@@ -1158,33 +1333,20 @@ void P_FS_SetFileInfoFlags(struct FileSystem *FS, LONG FileInfoIdx)
 
 LONG P_FS_AllocNewCluster(struct FileSystem *FS, LONG FileInfoIdx, LONG Cluster)
 {
-    LONG NewCluster=FS_DISK_FULL;
-    LONG i;
+    LONG NewCluster;
 
-    /* Si aucun cluster est pass en paramtre, on recherche aprs la zone directory */
+    /* Si aucun cluster est passé en paramètre, on recherche après la zone directory */
     if(Cluster<0) Cluster=FS->ClusterSys;
 
-    /* On recherche un cluster libre aprs le cluster pass en paramtre */
-    for(i=Cluster; i<FS->MaxBlocks && NewCluster<0; i++)
-    {
-        LONG CurCluster=(LONG)FS->FAT[i+1];
-        if(CurCluster==CLST_FREE) NewCluster=i;
-    }
-
-    /* Si on ne trouve pas de cluster libre, on recherche avant... */
-    for(i=Cluster; i>=0 && NewCluster<0; i--)
-    {
-        LONG CurCluster=(LONG)FS->FAT[i+1];
-        if(CurCluster==CLST_FREE) NewCluster=i;
-    }
-
+    NewCluster=P_FS_FindFreeCluster(FS,Cluster);
     if(NewCluster>=0)
     {
         /* Initialisation de la FAT pour le nouveau cluster */
         if(FS->FAT[Cluster+1]!=CLST_RESERVED)
         {
-            FS->FAT[Cluster+1]=(UBYTE)NewCluster;
+            P_FS_SetFAT(FS,Cluster,(UBYTE)NewCluster);
             FS->IsFATUpdated=TRUE;
+            P_FS_AppendToClusterLists(FS,FileInfoIdx,Cluster,NewCluster);
         }
 
         P_FS_Terminate(FS,FileInfoIdx,NewCluster,0,0);
@@ -1195,16 +1357,16 @@ LONG P_FS_AllocNewCluster(struct FileSystem *FS, LONG FileInfoIdx, LONG Cluster)
 
 
 /*****
-    Fonction pour retourner les informations gomtriques qui correspondent  l'offset demand.
-    Si IsGrowEnabled gal true, et que l'Offset est suprieur  la taille du fichier, la fonction auto agrandit le fichier.
-    * Paramtres:
+    Fonction pour retourner les informations géométriques qui correspondent à l'offset demandé.
+    Si IsGrowEnabled égal true, et que l'Offset est supérieur à la taille du fichier, la fonction auto agrandit le fichier.
+    * Paramètres:
       h: handle du fichier
-      Offset: offset demand
+      Offset: offset demandé
       IsGrowEnabled: TRUE pour auto agrandir le fichier si besoin, sinon FALSE
-      Cluster: retourne le cluster correspondant  l'offset
+      Cluster: retourne le cluster correspondant à l'offset
       IdxSector: retourne l'index du secteur du cluster
       Pos: retourne la position de l'offset dans le secteur
-      End: retourne la taille du secteur pour crire ou lire
+      End: retourne la taille du secteur pour écrire ou lire
     * Retourne:
       - si >=0, retourne l'offset final possible
       - si <0, retourne un code d'erreur
@@ -1215,37 +1377,35 @@ LONG P_FS_GetGeoDetailFromOffset(struct FSHandle *h, LONG Offset, BOOL IsGrowEna
     LONG Result=0;
     struct FileSystem *FS=h->FS;
     LONG BlockSize=FS->SectorsPerBlock*FS->FSSectorSize;
+    LONG IdxBlock=Offset/BlockSize;
     LONG NextCluster;
 
-    *Cluster=P_FS_GetFirstCluster(FS,h->FileInfoIdx);
     *IdxSector=0;
     *Pos=0;
     *End=0;
 
-    /* On se positionne sur le cluster relatif  l'offset */
-    NextCluster=(LONG)FS->FAT[*Cluster+1];
-    while(Result>=0 && Result+BlockSize<=Offset)
+    /* On se positionne directement sur le cluster relatif à l'offset grâce à la liste des clusters */
+    P_FS_UpdateClusterList(h);
+    while(IsGrowEnabled && h->CountOfClusters<=IdxBlock && Result>=0)
     {
-        if(NextCluster>CLST_TERM && IsGrowEnabled) NextCluster=P_FS_AllocNewCluster(FS,h->FileInfoIdx,*Cluster);
-        if(NextCluster<0) Result=NextCluster; /* = code d'erreur d'AllocNewCluster */
-        else if(NextCluster<=CLST_TERM)
-        {
-            Result+=BlockSize;
-            *Cluster=NextCluster;
-            NextCluster=(LONG)FS->FAT[*Cluster+1];
-        } else break;
+        /* P_FS_AllocNewCluster() complète la liste des clusters du handle */
+        Result=P_FS_AllocNewCluster(FS,h->FileInfoIdx,(LONG)h->ClusterList[h->CountOfClusters-1]);
+        P_FS_UpdateClusterList(h);
     }
 
-    /* Si pas d'erreur, on recherche le secteur relatif  l'offset */
+    if(IdxBlock>=h->CountOfClusters) IdxBlock=h->CountOfClusters-1;
+    *Cluster=(LONG)h->ClusterList[IdxBlock];
+    NextCluster=(LONG)FS->FAT[*Cluster+1];
+
+    /* Si pas d'erreur, on recherche le secteur relatif à l'offset */
     if(Result>=0)
     {
         LONG SectorCount=NextCluster<=CLST_TERM?FS->SectorsPerBlock:NextCluster-CLST_TERM;
 
-        while(Result+FS->FSSectorSize<=Offset && (*IdxSector+1)<SectorCount)
-        {
-            Result+=FS->FSSectorSize;
-            (*IdxSector)++;
-        }
+        Result=IdxBlock*BlockSize;
+        *IdxSector=(Offset-Result)/FS->FSSectorSize;
+        if(*IdxSector>=SectorCount) *IdxSector=SectorCount-1;
+        Result+=*IdxSector*FS->FSSectorSize;
 
         /* On calcule la taille du secteur */
         *End=NextCluster>CLST_TERM && (*IdxSector+1)>=SectorCount?P_FS_GetLastSectorLen(FS,h->FileInfoIdx):FS->FSSectorSize;
@@ -1260,7 +1420,7 @@ LONG P_FS_GetGeoDetailFromOffset(struct FSHandle *h, LONG Offset, BOOL IsGrowEna
 }
 
 /*****
-    Libre la chane de clusters  partir du cluster pass en paramtre
+    Libère la chaîne de clusters à partir du cluster passé en paramètre
 *****/
 
 void P_FS_FreeClusters(struct FileSystem *FS, LONG Cluster)
@@ -1270,22 +1430,115 @@ void P_FS_FreeClusters(struct FileSystem *FS, LONG Cluster)
     for(i=0; i<FS->MaxBlocks && Cluster<=CLST_TERM; i++)
     {
         LONG NextCluster=(LONG)FS->FAT[Cluster+1];
-        FS->FAT[Cluster+1]=CLST_FREE;
+        P_FS_SetFAT(FS,Cluster,CLST_FREE);
         Cluster=NextCluster;
         FS->IsFATUpdated=TRUE;
     }
+
+    /* Les listes de clusters des handles ouverts ne sont plus à jour */
+    FS->FATGeneration++;
+}
+
+
+/*****
+    Modifie l'entrée de la FAT d'un cluster, en tenant à jour le nombre et
+    la bitmap des clusters libres
+*****/
+
+void P_FS_SetFAT(struct FileSystem *FS, LONG Cluster, UBYTE Value)
+{
+    if(Cluster<FS->MaxBlocks)
+    {
+        ULONG Mask=(ULONG)1<<(Cluster&31);
+        BOOL IsFree=FS->FAT[Cluster+1]==CLST_FREE?TRUE:FALSE;
+
+        if(IsFree && Value!=CLST_FREE)
+        {
+            FS->FreeMap[Cluster>>5]&=~Mask;
+            FS->CountOfFreeClusters--;
+        }
+        else if(!IsFree && Value==CLST_FREE)
+        {
+            FS->FreeMap[Cluster>>5]|=Mask;
+            FS->CountOfFreeClusters++;
+        }
+    }
+
+    FS->FAT[Cluster+1]=Value;
+}
+
+
+/*****
+    Construction du nombre et de la bitmap des clusters libres à partir de la FAT
+*****/
+
+void P_FS_BuildFreeMap(struct FileSystem *FS)
+{
+    LONG i;
+
+    FS->CountOfFreeClusters=0;
+    for(i=0; i<(FS->MaxBlocks+31)/32; i++) FS->FreeMap[i]=0;
+
+    for(i=0; i<FS->MaxBlocks; i++)
+    {
+        if(FS->FAT[i+1]==CLST_FREE)
+        {
+            FS->FreeMap[i>>5]|=(ULONG)1<<(i&31);
+            FS->CountOfFreeClusters++;
+        }
+    }
+}
+
+
+/*****
+    Recherche d'un cluster libre dans la bitmap: d'abord à partir du cluster
+    passé en paramètre, puis avant celui-ci, pour garder les fichiers groupés.
+    * Retourne:
+      >=0: cluster libre
+      FS_DISK_FULL: plus de cluster libre
+*****/
+
+LONG P_FS_FindFreeCluster(struct FileSystem *FS, LONG Cluster)
+{
+    LONG Idx;
+    ULONG Bits;
+
+    if(FS->CountOfFreeClusters<=0) return FS_DISK_FULL;
+    if(Cluster>=FS->MaxBlocks) Cluster=FS->MaxBlocks-1;
+
+    /* On recherche un cluster libre après le cluster passé en paramètre */
+    Idx=Cluster>>5;
+    Bits=FS->FreeMap[Idx]&(~(ULONG)0<<(Cluster&31));
+    while(Bits==0 && ++Idx<(FS->MaxBlocks+31)/32) Bits=FS->FreeMap[Idx];
+    if(Bits!=0)
+    {
+        for(Cluster=Idx<<5; !(Bits&1); Bits>>=1) Cluster++;
+        return Cluster;
+    }
+
+    /* Si on ne trouve pas de cluster libre, on recherche avant... */
+    Idx=Cluster>>5;
+    Bits=FS->FreeMap[Idx]&((((ULONG)2)<<(Cluster&31))-1);
+    while(Bits==0 && --Idx>=0) Bits=FS->FreeMap[Idx];
+    if(Bits!=0)
+    {
+        for(Cluster=(Idx<<5)+31; !(Bits&0x80000000); Bits<<=1) Cluster--;
+        return Cluster;
+    }
+
+    return FS_DISK_FULL;
 }
 
 
 /*****
-    Calcule une taille en fonction des paramtres en entre.
-    * Paramtres:
+    Calcule une taille en fonction des paramètres en entrée.
+    * Paramètres:
       FS: pointeur sur la structure FileSystem
       Cluster: premier cluster d'une chaine de clusters
-      EndSize: taille occupe par le dernier secteur
-      CountOfBlocks: retourne le nombre de clusters occups
+      EndSize: taille occupée par le dernier secteur
+      CountOfBlocks: retourne le nombre de clusters occupés
     * Retourne:
-      retourne la taille calcule
+      retourne la taille calculée
 *****/
 
 LONG P_FS_CalcFileSize(struct FileSystem *FS, LONG Cluster, LONG EndSize, LONG *CountOfBlocks)
@@ -1346,16 +1599,312 @@ LONG P_FS_GetLastSectorLen(struct FileSystem *FS, LONG FileInfoIdx)
 }
 
 
+/*****
+    Construit la liste des clusters du fichier si elle n'est plus à jour.
+    La liste est invalidée par toute libération de clusters ou tout rechargement de la FAT.
+*****/
+
+void P_FS_UpdateClusterList(struct FSHandle *h)
+{
+    struct FileSystem *FS=h->FS;
+
+    if(h->CountOfClusters==0 || h->ClusterListGeneration!=FS->FATGeneration)
+    {
+        LONG Cluster=P_FS_GetFirstCluster(FS,h->FileInfoIdx);
+
+        h->ClusterList[0]=(UBYTE)Cluster;
+        h->CountOfClusters=1;
+        while(Cluster<=CLST_TERM && h->CountOfClusters<FS->MaxBlocks)
+        {
+            Cluster=(LONG)FS->FAT[Cluster+1];
+            if(Cluster<=CLST_TERM) h->ClusterList[h->CountOfClusters++]=(UBYTE)Cluster;
+        }
+
+        h->ClusterListGeneration=FS->FATGeneration;
+    }
+}
+
+
+/*****
+    Retourne l'offset du début du dernier secteur du fichier, à partir
+    du dernier cluster de la liste des clusters du handle.
+*****/
+
+LONG P_FS_GetTailOffset(struct FSHandle *h)
+{
+    struct FileSystem *FS=h->FS;
+    LONG Cluster,SectorCount;
+
+    P_FS_UpdateClusterList(h);
+    Cluster=(LONG)h->ClusterList[h->CountOfClusters-1];
+    SectorCount=(LONG)FS->FAT[Cluster+1]-CLST_TERM;
+    if(SectorCount>FS->SectorsPerBlock) SectorCount=FS->SectorsPerBlock;
+
+    return ((h->CountOfClusters-1)*FS->SectorsPerBlock+SectorCount-1)*FS->FSSectorSize;
+}
+
+
+/*****
+    Complète les listes de clusters des handles ouverts sur le fichier
+    lorsqu'un nouveau cluster est chaîné à la suite de Cluster.
+*****/
+
+void P_FS_AppendToClusterLists(struct FileSystem *FS, LONG FileInfoIdx, LONG Cluster, LONG NewCluster)
+{
+    struct FSHandle *h;
+
+    for(h=FS->FirstHandlePtr; h!=NULL && FileInfoIdx>=0; h=h->NextHandlePtr)
+    {
+        if(h->FileInfoIdx==FileInfoIdx && h->CountOfClusters>0)
+        {
+            if(h->ClusterListGeneration==FS->FATGeneration && h->ClusterList[h->CountOfClusters-1]==(UBYTE)Cluster && h->CountOfClusters<FS->MaxBlocks)
+            {
+                h->ClusterList[h->CountOfClusters++]=(UBYTE)NewCluster;
+            } else h->CountOfClusters=0;
+        }
+    }
+}
+
+
+/*****
+    Construction de l'index des noms de fichiers à partir du répertoire.
+    Les noms sont convertis une fois pour toutes au format hôte et chaînés dans deux
+    tables de hachage: une sur le nom exact et une sur le nom sans tenir compte de la casse.
+*****/
+
+void P_FS_BuildNameIndex(struct FileSystem *FS)
+{
+    LONG Idx;
+
+    FS->CountOfMissingNames=0;
+    FS->DirGeneration++;
+    for(Idx=0; Idx<FS_NAME_HASH_SIZE; Idx++)
+    {
+        FS->NameHash[Idx]=-1;
+        FS->NoCaseHash[Idx]=-1;
+    }
+
+    for(Idx=0; Idx<FS->MaxFiles; Idx++)
+    {
+        FS->Names[Idx].Name[0]=0;
+        FS->Objects[Idx].IsUpToDate=FALSE;
+        P_FS_AddName(FS,Idx);
+    }
+}
+
+
+/*****
+    Ajoute une entrée du répertoire dans l'index des noms.
+    Les chaînes restent triées par index pour que la recherche retourne la première
+    entrée du répertoire, comme le ferait un parcours complet.
+*****/
+
+void P_FS_AddName(struct FileSystem *FS, LONG FileInfoIdx)
+{
+    UBYTE *FileInfo=P_FS_GetFileInfo(FS,FileInfoIdx);
+    struct FSName *NamePtr=&FS->Names[FileInfoIdx];
+
+    if(FileInfo[FIO_NAME]!=FST_NONE && FileInfo[FIO_NAME]!=FST_ERASED)
+    {
+        LONG *IdxPtr;
+
+        /* Un nom apparaît: les noms mémorisés comme absents ne le sont peut-être plus */
+        FS->CountOfMissingNames=0;
+
+        Cnv_ConvertThomsonNameToHostName(FileInfo,NamePtr->Name,TRUE);
+        NamePtr->Key=P_FS_GetNameKey(NamePtr->Name,TRUE);
+        NamePtr->NoCaseKey=P_FS_GetNameKey(NamePtr->Name,FALSE);
+
+        IdxPtr=&FS->NameHash[NamePtr->Key&(FS_NAME_HASH_SIZE-1)];
+        while(*IdxPtr>=0 && *IdxPtr<FileInfoIdx) IdxPtr=&FS->Names[*IdxPtr].NextIdx;
+        NamePtr->NextIdx=*IdxPtr;
+        *IdxPtr=FileInfoIdx;
+
+        IdxPtr=&FS->NoCaseHash[NamePtr->NoCaseKey&(FS_NAME_HASH_SIZE-1)];
+        while(*IdxPtr>=0 && *IdxPtr<FileInfoIdx) IdxPtr=&FS->Names[*IdxPtr].NextNoCaseIdx;
+        NamePtr->NextNoCaseIdx=*IdxPtr;
+        *IdxPtr=FileInfoIdx;
+    }
+}
+
+
+/*****
+    Retire une entrée du répertoire de l'index des noms
+*****/
+
+void P_FS_RemoveName(struct FileSystem *FS, LONG FileInfoIdx)
+{
+    struct FSName *NamePtr=&FS->Names[FileInfoIdx];
+
+    if(NamePtr->Name[0]!=0)
+    {
+        LONG *IdxPtr;
+
+        IdxPtr=&FS->NameHash[NamePtr->Key&(FS_NAME_HASH_SIZE-1)];
+        while(*IdxPtr>=0 && *IdxPtr!=FileInfoIdx) IdxPtr=&FS->Names[*IdxPtr].NextIdx;
+        if(*IdxPtr>=0) *IdxPtr=NamePtr->NextIdx;
+
+        IdxPtr=&FS->NoCaseHash[NamePtr->NoCaseKey&(FS_NAME_HASH_SIZE-1)];
+        while(*IdxPtr>=0 && *IdxPtr!=FileInfoIdx) IdxPtr=&FS->Names[*IdxPtr].NextNoCaseIdx;
+        if(*IdxPtr>=0) *IdxPtr=NamePtr->NextNoCaseIdx;
+
+        NamePtr->Name[0]=0;
+    }
+}
+
+
+/*****
+    Recherche un nom déjà réduit par Cnv_SplitHostName() dans l'index des noms.
+    * Paramètres:
+      FS: pointeur sur la structure FileSystem
+      Name: nom recherché
+      Type: type du fichier, ou NULL pour l'ignorer
+      IsSensitive: TRUE pour tenir compte de la casse
+    * Retourne:
+      l'index de la première entrée correspondante, ou FS_FILE_NOT_FOUND
+*****/
+
+LONG P_FS_FindName(struct FileSystem *FS, const char *Name, const LONG *Type, BOOL IsSensitive)
+{
+    ULONG Key=P_FS_GetNameKey(Name,IsSensitive);
+    LONG Idx=IsSensitive?FS->NameHash[Key&(FS_NAME_HASH_SIZE-1)]:FS->NoCaseHash[Key&(FS_NAME_HASH_SIZE-1)];
+
+    while(Idx>=0)
+    {
+        struct FSName *NamePtr=&FS->Names[Idx];
+
+        if((IsSensitive?NamePtr->Key:NamePtr->NoCaseKey)==Key
+           && Utl_CompareHostName(NamePtr->Name,NULL,Name,NULL,IsSensitive)==0
+           && (Type==NULL || P_FS_GetTypeFromFileInfo(P_FS_GetFileInfo(FS,Idx))==*Type)) return Idx;
+
+        Idx=IsSensitive?NamePtr->NextIdx:NamePtr->NextNoCaseIdx;
+    }
+
+    return FS_FILE_NOT_FOUND;
+}
+
+
+/*****
+    Teste si un nom a déjà été cherché en vain dans le répertoire
+*****/
+
+BOOL P_FS_IsMissingName(struct FileSystem *FS, const char *Name, BOOL IsSensitive)
+{
+    LONG i;
+
+    for(i=0; i<FS->CountOfMissingNames; i++)
+    {
+        struct FSMissingName *MissingPtr=&FS->MissingNames[i];
+        if(MissingPtr->IsSensitive==IsSensitive && Utl_CompareHostName(MissingPtr->Name,NULL,Name,NULL,IsSensitive)==0) return TRUE;
+    }
+
+    return FALSE;
+}
+
+
+/*****
+    Mémorise un nom absent du répertoire, en remplaçant le plus ancien si la table est pleine
+*****/
+
+void P_FS_AddMissingName(struct FileSystem *FS, const char *Name, BOOL IsSensitive)
+{
+    if(Sys_StrLen(Name)<=SIZEOF_HOSTNAME)
+    {
+        struct FSMissingName *MissingPtr;
+
+        if(FS->CountOfMissingNames<FS_MISSING_NAMES) FS->NextMissingName=FS->CountOfMissingNames++;
+        else FS->NextMissingName=(FS->NextMissingName+1)%FS_MISSING_NAMES;
+
+        MissingPtr=&FS->MissingNames[FS->NextMissingName];
+        MissingPtr->IsSensitive=IsSensitive;
+        Sys_StrCopy(MissingPtr->Name,Name,sizeof(MissingPtr->Name));
+    }
+}
+
+
+/*****
+    Retourne l'entrée décodée du répertoire, après l'avoir décodée de nouveau
+    si le descripteur ou la FAT du fichier ont été modifiés depuis.
+*****/
+
+struct FileObject *P_FS_GetFileObject(struct FileSystem *FS, LONG FileInfoIdx)
+{
+    struct FSObject *ObjPtr=&FS->Objects[FileInfoIdx];
+
+    if(!ObjPtr->IsUpToDate)
+    {
+        P_FS_DecodeFileObject(FS,FileInfoIdx,&ObjPtr->FO);
+        ObjPtr->IsUpToDate=TRUE;
+    }
+
+    return &ObjPtr->FO;
+}
+
+
+/*****
+    Décodage d'un descripteur de fichier au format hôte
+*****/
+
+void P_FS_DecodeFileObject(struct FileSystem *FS, LONG FileInfoIdx, struct FileObject *FO)
+{
+    UBYTE *FileInfo=P_FS_GetFileInfo(FS,FileInfoIdx);
+    LONG Cluster=(LONG)FileInfo[FIO_FIRST_CLUSTER];
+    LONG EndSize=(((LONG)FileInfo[FIO_LAST_SEC_LEN])<<8)+(LONG)FileInfo[FIO_LAST_SEC_LEN+1];
+    LONG Year=(LONG)FileInfo[FIO_YEAR];
+    char Suffix[SIZEOF_TOSUFFIX+sizeof(char)];
+
+    Utl_FixedStringToCString(&FileInfo[FIO_SUFFIX],SIZEOF_TOSUFFIX,Suffix);
+
+    FO->FS=FS;
+    FO->FileInfoIdx=FileInfoIdx;
+    Cnv_ConvertThomsonNameToHostName(FileInfo,FO->Name,TRUE);
+    Cnv_ConvertThomsonCommentToHostComment(&FileInfo[FIO_COMMENT],FO->Comment,TRUE);
+    FO->Day=(LONG)FileInfo[FIO_DAY];
+    FO->Month=(LONG)FileInfo[FIO_MONTH];
+    FO->Year=Year+(Year<80?2000:1900);
+    FO->Hour=FS->IsExtended?(LONG)FileInfo[FIO_HOUR]:0;
+    FO->Min=FS->IsExtended?(LONG)FileInfo[FIO_MIN]:0;
+    FO->Sec=FS->IsExtended?(LONG)FileInfo[FIO_SEC]:0;
+    FO->Type=P_FS_GetTypeFromFileInfo(FileInfo);
+    FO->ExtraData=Sys_StrCmp(Suffix,"CHG")==0?((LONG)FileInfo[FIO_CHG1]<<8)+(LONG)FileInfo[FIO_CHG2]:-1;
+    FO->Size=P_FS_CalcFileSize(FS,Cluster,EndSize,&FO->CountOfBlocks);
+
+    FO->IsDateOk=FO->Day>=1 && FO->Day<=31 && FO->Month>=1 && FO->Month<=12?TRUE:FALSE;
+    FO->IsTimeOk=FO->IsDateOk && (FO->Hour!=0 || FO->Min!=0 || FO->Sec!=0)?TRUE:FALSE;
+}
+
+
+/*****
+    Calcule la clé de hachage d'un nom.
+    Sans tenir compte de la casse, seules les lettres A-Z sont repliées, comme dans Sys_StrCmpNoCase().
+*****/
+
+ULONG P_FS_GetNameKey(const char *Name, BOOL IsSensitive)
+{
+    ULONG Key=0;
+
+    while(*Name!=0)
+    {
+        ULONG c=(ULONG)(UBYTE)*(Name++);
+        if(!IsSensitive && c>='A' && c<='Z') c|=32;
+        Key=Key*31+c;
+    }
+
+    return Key;
+}
+
+
 /*****
     Ajoute un handle dans la liste des handles
 *****/
 
 struct FSHandle *P_FS_AddNewHandle(struct FileSystem *FS)
 {
-    struct FSHandle *h=(struct FSHandle *)Sys_AllocMem(sizeof(struct FSHandle)+FS->SectorSize);
+    struct FSHandle *h=(struct FSHandle *)Sys_AllocMem(sizeof(struct FSHandle)+FS->SectorSize+FS->MaxBlocks);
 
     if(h!=NULL)
     {
+        h->ClusterList=&((UBYTE *)h)[sizeof(struct FSHandle)+FS->SectorSize];
         h->NextHandlePtr=FS->FirstHandlePtr;
         h->PrevHandlePtr=NULL;
         if(FS->FirstHandlePtr!=NULL) FS->FirstHandlePtr->PrevHandlePtr=h;
@@ -1367,7 +1916,7 @@ struct FSHandle *P_FS_AddNewHandle(struct FileSystem *FS)
 
 
 /*****
-    Libre un handle de la liste des handles
+    Libère un handle de la liste des handles
 *****/
 
 void P_FS_RemoveHandle(struct FileSystem *FS, struct FSHandle *h)
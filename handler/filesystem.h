@@ -5,7 +5,7 @@
 #define SIZEOF_TONAME           8  /* sizeof(Nom) */
 #define SIZEOF_TOSUFFIX         3  /* sizoef(Suffix) */
 #define SIZEOF_TOFULLNAME       (SIZEOF_TONAME+SIZEOF_TOSUFFIX)
-#define SIZEOF_CONV_HOSTNAME    12 /* sizeof(Nom) + sizeof(Sparateur) + sizeof(Suffixe) */
+#define SIZEOF_CONV_HOSTNAME    12 /* sizeof(Nom) + sizeof(Séparateur) + sizeof(Suffixe) */
 
 /* Offsets dans le nom de volume */
 #define FV_NAME                 0
@@ -62,6 +62,57 @@
 #define CLST_RESERVED           0xfe
 #define CLST_TERM               0xc0
 
+/* Taille des tables de hachage de l'index des noms (puissance de 2) */
+#define FS_NAME_HASH_SIZE       64
+
+/* Nombre de noms absents mémorisés */
+#define FS_MISSING_NAMES        8
+
+
+struct FSName
+{
+    LONG NextIdx;
+    LONG NextNoCaseIdx;
+    ULONG Key;
+    ULONG NoCaseKey;
+    char Name[SIZEOF_CONV_HOSTNAME+sizeof(char)];
+};
+
+
+struct FSMissingName
+{
+    BOOL IsSensitive;
+    char Name[SIZEOF_HOSTNAME+sizeof(char)];
+};
+
+
+struct FileObject
+{
+    struct FileSystem *FS;
+    char Name[13];
+    char Comment[9];
+    LONG Day;
+    LONG Month;
+    LONG Year;
+    LONG Hour;
+    LONG Min;
+    LONG Sec;
+    LONG Type;
+    LONG Size;
+    BOOL IsDateOk;
+    BOOL IsTimeOk;
+    LONG ExtraData;
+    LONG CountOfBlocks;
+    LONG FileInfoIdx;
+};
+
+
+struct FSObject
+{
+    BOOL IsUpToDate;
+    struct FileObject FO;
+};
+
 
 struct FileSystem
 {
@@ -70,6 +121,8 @@ struct FileSystem
     BOOL IsExtended;
     BOOL IsFATUpdated;
     ULONG FileInfoFlags;
+    ULONG FATGeneration;
+    ULONG DirGeneration;
     LONG BlocksPerTrack;
     LONG MaxTracks;
     LONG SectorSize;
@@ -82,10 +135,19 @@ struct FileSystem
     LONG MaxFiles;
     LONG MaxBlocks;
     LONG ClusterSys;
+    LONG CountOfFreeClusters;
+    ULONG *FreeMap;
     UBYTE *Sys;
     UBYTE *Label;
     UBYTE *FAT;
     UBYTE *Dir;
+    struct FSName *Names;
+    struct FSObject *Objects;
+    LONG NameHash[FS_NAME_HASH_SIZE];
+    LONG NoCaseHash[FS_NAME_HASH_SIZE];
+    LONG CountOfMissingNames;
+    LONG NextMissingName;
+    struct FSMissingName MissingNames[FS_MISSING_NAMES];
 };
 
 
@@ -97,27 +159,10 @@ struct FSHandle
     LONG Mode;
     LONG FileInfoIdx;
     LONG Offset;
-};
-
-
-struct FileObject
-{
-    struct FileSystem *FS;
-    char Name[13];
-    char Comment[9];
-    LONG Day;
-    LONG Month;
-    LONG Year;
-    LONG Hour;
-    LONG Min;
-    LONG Sec;
-    LONG Type;
     LONG Size;
-    BOOL IsDateOk;
-    BOOL IsTimeOk;
-    LONG ExtraData;
-    LONG CountOfBlocks;
-    LONG FileInfoIdx;
+    ULONG ClusterListGeneration;
+    LONG CountOfClusters;
+    UBYTE *ClusterList;
 };
 
 
@@ -10,13 +10,17 @@
 #include <devices/input.h>
 
 /*
+    17-10-2026 (Seg)    Ajout de Hdl_WriteProtect() et Hdl_ChangeDisk() pour le disque virtuel
+    17-10-2026 (Seg)    Cache des entrées ExAll() par niveau ED_* et par génération du répertoire
+    17-10-2026 (Seg)    Timer à échéance relancé à la demande, délais séparés pour l'écriture
+                        du cache et l'arrêt du moteur
     01-10-2020 (Seg)    Externalisation des routines de debug dans debuc.c/.h
     23-09-2020 (Seg)    Gestion des buffers
-    10-09-2020 (Seg)    Quelques adaptations suite  la refonte globale de la couche filesystem
-    28-08-2018 (Seg)    Synchro et remaniement de code pour grer les caractres accentus des noms et commentaires de fichiers
-    11-08-2018 (Seg)    Gestion des paramtres gomtriques du disque
-    05-06-2017 (Seg)    Modifications pour grer les "extradata" des fichiers .CHG
-    01-10-2016 (Seg)    Rorganisation du code + ajout version
+    10-09-2020 (Seg)    Quelques adaptations suite à la refonte globale de la couche filesystem
+    28-08-2018 (Seg)    Synchro et remaniement de code pour gérer les caractères accentués des noms et commentaires de fichiers
+    11-08-2018 (Seg)    Gestion des paramètres géométriques du disque
+    05-06-2017 (Seg)    Modifications pour gérer les "extradata" des fichiers .CHG
+    01-10-2016 (Seg)    Réorganisation du code + ajout version
     14-09-2016 (Seg)    Refonte totale
     09-04-2010 (Seg)    Gestion du handler
 */
@@ -40,6 +44,7 @@ LONG Hdl_Seek(struct HandlerData *, struct FileLockTO *, LONG, LONG, LONG *);
 BOOL Hdl_ExamineObject(struct HandlerData *, struct FileLockTO *, struct FileInfoBlock *, LONG *);
 BOOL Hdl_ExamineNext(struct HandlerData *, struct FileLockTO *, struct FileInfoBlock *, LONG *);
 BOOL Hdl_ExamineAll(struct HandlerData *, struct FileLockTO *, UBYTE *, LONG, LONG, struct ExAllControl *, LONG *);
+void Hdl_FreeExAllCaches(struct HandlerData *);
 
 BOOL Hdl_Rename(struct HandlerData *, struct FileLockTO *, const char *, struct FileLockTO *, const char *, LONG *);
 BOOL Hdl_Delete(struct HandlerData *, struct FileLockTO *, const char *, LONG *);
@@ -50,10 +55,13 @@ BOOL Hdl_SetFileSize(struct HandlerData *, struct FileLockTO *, LONG, LONG, LONG
 BOOL Hdl_DiskInfo(struct HandlerData *, struct InfoData *);
 BOOL Hdl_Relabel(struct HandlerData *, const char *, LONG *);
 BOOL Hdl_Format(struct HandlerData *, const char *, LONG *);
+BOOL Hdl_WriteProtect(struct HandlerData *, BOOL, LONG *);
+BOOL Hdl_ChangeDisk(struct HandlerData *, BOOL, LONG *);
 
 void Hdl_CheckChange(struct HandlerData *);
 void Hdl_Change(struct DiskLayer *, void *);
 void Hdl_SendTimeout(struct HandlerData *);
+void Hdl_Timeout(struct HandlerData *);
 
 void Hdl_UnsetVolumeEntry(struct HandlerData *);
 
@@ -63,6 +71,8 @@ LONG Hdl_StringToBSTR(const char *, char *, LONG);
 
 void P_Hdl_FillFib(struct HandlerData *, struct FileObject *, struct FileInfoBlock *);
 LONG P_Hdl_SubExamineAll(struct HandlerData *, struct FileObject *, LONG, UBYTE *, LONG);
+struct ExAllCache *P_Hdl_GetExAllCache(struct HandlerData *, LONG);
+LONG P_Hdl_CopyExAllEntry(struct ExAllCacheEntry *, LONG, UBYTE *, LONG);
 
 BOOL P_Hdl_SetVolumeEntry(struct HandlerData *, const char *, ULONG);
 void P_Hdl_RefreshDiskIcon(struct HandlerData *, LONG);
@@ -78,13 +88,18 @@ void P_Hdl_GetVolumeName(struct HandlerData *, char *);
 ULONG P_Hdl_GetDiskType(struct HandlerData *);
 void P_Hdl_DateToDateStamp(struct DateStamp *, LONG, LONG, LONG, LONG, LONG, LONG);
 
+void P_Hdl_SendTimer(struct HandlerData *, LONG);
+void P_Hdl_UpdateAccessRate(struct HandlerData *, const struct DateStamp *);
+LONG P_Hdl_GetMotorOffDelay(struct HandlerData *);
+LONG P_Hdl_GetElapsedTicks(const struct DateStamp *, const struct DateStamp *);
+
 const char *P_Hdl_SkipVolume(const char *);
 const char *P_Hdl_NamePart(const char *);
 ULONG P_Hdl_ParsePath(struct FileLockTO *, const char *, char *, LONG *);
 
 
 /*****
-    Gestion de la dsactivation/ractivation du handler
+    Gestion de la désactivation/réactivation du handler
 *****/
 
 BOOL Hdl_Inhibit(struct HandlerData *HData, BOOL Flag, LONG *Result2)
@@ -97,7 +112,7 @@ BOOL Hdl_Inhibit(struct HandlerData *HData, BOOL Flag, LONG *Result2)
         if(HData->FirstLock!=NULL)
         {
             /* Si on a un lock, il est impossible de faire un inhibit!
-               Note: Le cas o le disque est absent ou protg en criture est gr
+               Note: Le cas où le disque est absent ou protégé en écriture est géré
                en amont, dans le main.
             */
             *Result2=ERROR_OBJECT_IN_USE;
@@ -116,7 +131,7 @@ BOOL Hdl_Inhibit(struct HandlerData *HData, BOOL Flag, LONG *Result2)
         {
             if(--HData->InhibitCounter==0)
             {
-                /* Permet de relire le file system, rallouer le Dos Entry
+                /* Permet de relire le file system, réallouer le Dos Entry
                    pour avoir le TA0: et l'icone sur le workbench, ainsi
                    que de lancer un time out pour l'extinction du moteur.
                 */
@@ -130,7 +145,7 @@ BOOL Hdl_Inhibit(struct HandlerData *HData, BOOL Flag, LONG *Result2)
 
 
 /*****
-    Permet d'obtenir un lock sur un fichier,  partir de son nom
+    Permet d'obtenir un lock sur un fichier, à partir de son nom
 *****/
 
 struct FileLockTO *Hdl_LockObjectFromName(struct HandlerData *HData, struct FileLockTO *FLBase, const char *Name, LONG LockMode, LONG *Result2)
@@ -138,7 +153,7 @@ struct FileLockTO *Hdl_LockObjectFromName(struct HandlerData *HData, struct File
     struct FileLockTO *NewFL=NULL;
     char ObjectName[SIZEOF_HOSTNAME+sizeof(char)];
 
-    /* Contrle du path et extraction du nom du fichier */
+    /* Contrôle du path et extraction du nom du fichier */
     if(P_Hdl_ParsePath(FLBase,Name,ObjectName,Result2)<=1)
     {
         LONG Idx=FS_FindFile(HData->FS,ObjectName,NULL,HData->IsSensitive);
@@ -161,7 +176,7 @@ struct FileLockTO *Hdl_LockObjectFromName(struct HandlerData *HData, struct File
 
 
 /*****
-    Permet d'obtenir un lock sur un fichier  partir d'un handle de fichier
+    Permet d'obtenir un lock sur un fichier à partir d'un handle de fichier
 *****/
 
 struct FileLockTO *Hdl_LockObjectFromLock(struct HandlerData *HData, struct FileLockTO *FL, LONG *Result2)
@@ -181,7 +196,7 @@ struct FileLockTO *Hdl_LockObjectFromLock(struct HandlerData *HData, struct File
 
 
 /*****
-    Dverrouille l'objet
+    Déverrouille l'objet
 *****/
 
 BOOL Hdl_UnLockObject(struct HandlerData *HData, struct FileLockTO *FL, LONG *Result2)
@@ -204,7 +219,7 @@ BOOL Hdl_UnLockObject(struct HandlerData *HData, struct FileLockTO *FL, LONG *Re
 
 
 /*****
-    Met  jour les donnes des handlers et le cache du device
+    Met à jour les données des handlers et le cache du device
     Note: ne pas utiliser de Hdl_SetTimeout()!!!
 *****/
 
@@ -271,7 +286,7 @@ struct FileLockTO *Hdl_OpenFile(struct HandlerData *HData, struct FileLockTO *FL
             char ObjectName[SIZEOF_HOSTNAME+sizeof(char)];
             LONG Count;
 
-            /* Contrle du path et extraction du nom du fichier */
+            /* Contrôle du path et extraction du nom du fichier */
             if((Count=P_Hdl_ParsePath(FLBase,FileName,ObjectName,Result2))<=1)
             {
                 *Result2=ERROR_OBJECT_WRONG_TYPE;
@@ -281,10 +296,10 @@ struct FileLockTO *Hdl_OpenFile(struct HandlerData *HData, struct FileLockTO *FL
                     LONG Type;
                     struct FSHandle *Handle;
 
-                    /* On rduit le nom pass en paramtre, au format Thomson, c'est--dire
-                        12 caractres (avec le point de sparation nom/suffixe), pour obtenir
-                       son suffixe sur 3 caractres, sachant qu'une rduction de nom se fait
-                       dj dans FS_OpenFile pour viter la cration de doublons de fichiers.
+                    /* On réduit le nom passé en paramètre, au format Thomson, c'est-à-dire
+                       à 12 caractères (avec le point de séparation nom/suffixe), pour obtenir
+                       son suffixe sur 3 caractères, sachant qu'une réduction de nom se fait
+                       déjà dans FS_OpenFile pour éviter la création de doublons de fichiers.
                     */
                     Cnv_SplitHostName(ObjectName,FinalName);
                     Type=Utl_GetTypeFromHostName(FinalName);
@@ -405,7 +420,7 @@ LONG Hdl_Seek(struct HandlerData *HData, struct FileLockTO *FL, LONG Pos, LONG M
 
 
 /*****
-    Retourne les informations sur le lock donn
+    Retourne les informations sur le lock donné
     struct FileInfoBlock {
         LONG   fib_DiskKey;
         LONG   fib_DirEntryType;    Type of Directory. If < 0, then a plain file.
@@ -435,10 +450,10 @@ BOOL Hdl_ExamineObject(struct HandlerData *HData, struct FileLockTO *FL, struct
 
     if(FL==NULL || FL->fl.fl_Key<0)
     {
-        char Tmp[TMPSIZEOF]; /* Taille arbitraire assez grande pour contenir un nom potentiellement retravaill */
+        char Tmp[TMPSIZEOF]; /* Taille arbitraire assez grande pour contenir un nom potentiellement retravaillé */
 
-        /* L'objet est le rpertoire root */
-        fib->fib_DiskKey=-1; /* Comme on va commencer  scanner le root, une positionne l'quivalent du FileInfoIdx de la dos lib  -1 pour que le prochain Hdl_ExamineNext() le positionne  0 */
+        /* L'objet est le répertoire root */
+        fib->fib_DiskKey=-1; /* Comme on va commencer à scanner le root, une positionne l'équivalent du FileInfoIdx de la dos lib à -1 pour que le prochain Hdl_ExamineNext() le positionne à 0 */
         fib->fib_DirEntryType=ST_ROOT;
         P_Hdl_GetVolumeName(HData,Tmp);
         Hdl_StringToBSTR(Tmp,fib->fib_FileName,sizeof(fib->fib_FileName));
@@ -460,7 +475,7 @@ BOOL Hdl_ExamineObject(struct HandlerData *HData, struct FileLockTO *FL, struct
         FO.FileInfoIdx=FL->fl.fl_Key-1;
         IsSuccess=FS_ExamineNextFileObject(&FO);
         if(IsSuccess) P_Hdl_FillFib(HData,&FO,fib); //else *Result2=ERROR_NO_MORE_ENTRIES;
-        fib->fib_DiskKey=-2; /* Un fichier n'est pas scannable. On positionne l'quivalent du FileInfoIdx de la dos lib  -2 pour qu'il soit rejet par Hdl_ExamineNext() */
+        fib->fib_DiskKey=-2; /* Un fichier n'est pas scannable. On positionne l'équivalent du FileInfoIdx de la dos lib à -2 pour qu'il soit rejeté par Hdl_ExamineNext() */
     }
 
     return IsSuccess;
@@ -492,7 +507,7 @@ BOOL Hdl_ExamineNext(struct HandlerData *HData, struct FileLockTO *FL, struct Fi
 
 
 /*****
-    Retourne toutes les informations du rpertoire
+    Retourne toutes les informations du répertoire
 *****/
 
 BOOL Hdl_ExamineAll(struct HandlerData *HData, struct FileLockTO *FL, UBYTE *BufferPtr, LONG Len, LONG Type, struct ExAllControl *eac, LONG *Result2)
@@ -505,42 +520,56 @@ BOOL Hdl_ExamineAll(struct HandlerData *HData, struct FileLockTO *FL, UBYTE *Buf
         *Result2=ERROR_BAD_NUMBER;
         if(Type>=ED_NAME && Type<=ED_OWNER)
         {
-            struct FileObject FO;
-            struct ExAllData *PrevEAC=NULL;
-            LONG Size=Len;
-            BOOL IsNewEntry=TRUE;
-
-            eac->eac_Entries=0;
-            FO.FS=HData->FS;
-            FO.FileInfoIdx=(LONG)eac->eac_LastKey-1;
-            while(Len>0 && Size>0 && (IsNewEntry=FS_ExamineNextFileObject(&FO))!=FALSE)
+            struct ExAllCache *Cache=P_Hdl_GetExAllCache(HData,Type);
+
+            *Result2=ERROR_NO_FREE_STORE;
+            if(Cache!=NULL)
             {
-                if((Size=P_Hdl_SubExamineAll(HData,&FO,Type,BufferPtr,Len))>0)
+                UBYTE *CachePtr=Cache->Buffer;
+                UBYTE *CacheEnd=&Cache->Buffer[Cache->Size];
+                struct ExAllData *PrevEAC=NULL;
+                LONG Size=Len;
+                BOOL IsNewEntry=TRUE;
+
+                /* On se replace après la dernière entrée retournée */
+                eac->eac_Entries=0;
+                while(CachePtr<CacheEnd && ((struct ExAllCacheEntry *)CachePtr)->FileInfoIdx<(LONG)eac->eac_LastKey)
+                {
+                    CachePtr=&CachePtr[sizeof(struct ExAllCacheEntry)+((((struct ExAllCacheEntry *)CachePtr)->Size+3)&0xfffffffc)];
+                }
+
+                while(Len>0 && Size>0 && (IsNewEntry=CachePtr<CacheEnd?TRUE:FALSE)!=FALSE)
                 {
-                    BOOL IsWanted=TRUE;
-                    if(eac->eac_MatchFunc!=NULL) IsWanted=CallHookPkt(eac->eac_MatchFunc,&Type,BufferPtr);
-                    else if(eac->eac_MatchString!=NULL) IsWanted=MatchPatternNoCase(eac->eac_MatchString,((struct ExAllData *)BufferPtr)->ed_Name);
+                    struct ExAllCacheEntry *Entry=(struct ExAllCacheEntry *)CachePtr;
 
-                    if(IsWanted)
+                    if((Size=P_Hdl_CopyExAllEntry(Entry,Type,BufferPtr,Len))>0)
                     {
-                        if(PrevEAC!=NULL) PrevEAC->ed_Next=(struct ExAllData *)BufferPtr;
-                        PrevEAC=(struct ExAllData *)BufferPtr;
+                        BOOL IsWanted=TRUE;
+                        if(eac->eac_MatchFunc!=NULL) IsWanted=CallHookPkt(eac->eac_MatchFunc,&Type,BufferPtr);
+                        else if(eac->eac_MatchString!=NULL) IsWanted=MatchPatternNoCase(eac->eac_MatchString,((struct ExAllData *)BufferPtr)->ed_Name);
 
-                        Size=(Size+3)&0xfffffffc; /* On aligne la prochaine structure */
-                        BufferPtr=&BufferPtr[Size];
-                        Len-=Size;
+                        if(IsWanted)
+                        {
+                            if(PrevEAC!=NULL) PrevEAC->ed_Next=(struct ExAllData *)BufferPtr;
+                            PrevEAC=(struct ExAllData *)BufferPtr;
+
+                            Size=(Size+3)&0xfffffffc; /* On aligne la prochaine structure */
+                            BufferPtr=&BufferPtr[Size];
+                            Len-=Size;
 
-                        eac->eac_LastKey=FO.FileInfoIdx+1;
-                        eac->eac_Entries++;
+                            eac->eac_LastKey=Entry->FileInfoIdx+1;
+                            eac->eac_Entries++;
+                        }
                     }
+                    CachePtr=&CachePtr[sizeof(struct ExAllCacheEntry)+((Entry->Size+3)&0xfffffffc)];
                 }
-            }
 
-            *Result2=ERROR_NO_MORE_ENTRIES;
-            if(IsNewEntry)
-            {
-                *Result2=RETURN_OK;
-                IsSuccess=TRUE;
+                *Result2=ERROR_NO_MORE_ENTRIES;
+                if(IsNewEntry)
+                {
+                    *Result2=RETURN_OK;
+                    IsSuccess=TRUE;
+                }
             }
         }
     }
@@ -549,6 +578,22 @@ BOOL Hdl_ExamineAll(struct HandlerData *HData, struct FileLockTO *FL, UBYTE *Buf
 }
 
 
+/*****
+    Libère les caches ExAll()
+*****/
+
+void Hdl_FreeExAllCaches(struct HandlerData *HData)
+{
+    LONG i;
+
+    for(i=0; i<HDL_EXALL_TYPES; i++)
+    {
+        Sys_FreeMem((void *)HData->ExAllCaches[i].Buffer);
+        HData->ExAllCaches[i].Buffer=NULL;
+    }
+}
+
+
 /*****
     Renommage d'un fichier
 *****/
@@ -562,12 +607,12 @@ BOOL Hdl_Rename(struct HandlerData *HData, struct FileLockTO *FLBase1, const cha
     {
         char ObjectNameOld[SIZEOF_HOSTNAME+sizeof(char)];
 
-        /* Contrle du path et extraction du nom du fichier */
+        /* Contrôle du path et extraction du nom du fichier */
         if(P_Hdl_ParsePath(FLBase1,PathName1,ObjectNameOld,Result2)<=1)
         {
             char ObjectNameNew[SIZEOF_HOSTNAME+sizeof(char)];
 
-            /* Contrle du path et extraction du nom du fichier */
+            /* Contrôle du path et extraction du nom du fichier */
             if(P_Hdl_ParsePath(FLBase2,PathName2,ObjectNameNew,Result2)<=1)
             {
                 LONG ErrorCode=FS_RenameFile(HData->FS,ObjectNameOld,NULL,HData->IsSensitive,ObjectNameNew);
@@ -600,7 +645,7 @@ BOOL Hdl_Delete(struct HandlerData *HData, struct FileLockTO *FLBase, const char
     {
         char ObjectName[SIZEOF_HOSTNAME+sizeof(char)];
 
-        /* Contrle du path et extraction du nom du fichier */
+        /* Contrôle du path et extraction du nom du fichier */
         if(P_Hdl_ParsePath(FLBase,PathName,ObjectName,Result2)<=1)
         {
             LONG Idx=FS_FindFile(HData->FS,ObjectName,NULL,HData->IsSensitive);
@@ -643,7 +688,7 @@ BOOL Hdl_SetComment(struct HandlerData *HData, struct FileLockTO *FLBase, const
     {
         char ObjectName[SIZEOF_HOSTNAME+sizeof(char)];
 
-        /* Contrle du path et extraction du nom du fichier */
+        /* Contrôle du path et extraction du nom du fichier */
         if(P_Hdl_ParsePath(FLBase,PathName,ObjectName,Result2)<=1)
         {
             LONG ErrorCode=FS_SetComment(HData->FS,ObjectName,NULL,HData->IsSensitive,Comment);
@@ -676,7 +721,7 @@ BOOL Hdl_SetDate(struct HandlerData *HData, struct FileLockTO *FLBase, const cha
     {
         char ObjectName[SIZEOF_HOSTNAME+sizeof(char)];
 
-        /* Contrle du path et extraction du nom du fichier */
+        /* Contrôle du path et extraction du nom du fichier */
         if(P_Hdl_ParsePath(FLBase,PathName,ObjectName,Result2)<=1)
         {
             struct ClockData cd;
@@ -707,7 +752,7 @@ BOOL Hdl_SetDate(struct HandlerData *HData, struct FileLockTO *FLBase, const cha
 
 
 /*****
-    Rserve un espace sur le disque pour un fichier
+    Réserve un espace sur le disque pour un fichier
 *****/
 
 BOOL Hdl_SetFileSize(struct HandlerData *HData, struct FileLockTO *FL, LONG Mode, LONG Len, LONG *Result2)
@@ -803,7 +848,7 @@ BOOL Hdl_Relabel(struct HandlerData *HData, const char *VolumeName, LONG *Result
 
         if(ErrorCode>=0)
         {
-            char Tmp[TMPSIZEOF]; /* Taille arbitraire assez grande pour contenir un nom potentiellement retravaill */
+            char Tmp[TMPSIZEOF]; /* Taille arbitraire assez grande pour contenir un nom potentiellement retravaillé */
             FS_GetVolumeName(HData->FS,Tmp);
             IsSuccess=P_Hdl_SetVolumeEntry(HData,Tmp,P_Hdl_GetDiskType(HData));
             DateStamp(&HData->LatestMod);
@@ -844,7 +889,7 @@ BOOL Hdl_Format(struct HandlerData *HData, const char *VolumeName, LONG *Result2
         DateStamp(&HData->LatestMod);
 
         /* Note: La relecture du file system, ainsi que l'extinction du moteur, sont
-           lancs par le d-hinibit.
+           lancés par le dé-hinibit.
         */
     }
 
@@ -853,7 +898,45 @@ BOOL Hdl_Format(struct HandlerData *HData, const char *VolumeName, LONG *Result2
 
 
 /*****
-    Fonction appele automatiquement quand un disque a t insr ou enlev
+    Protection logicielle du disque.
+    Seul le disque virtuel en mémoire peut être protégé de cette manière. Les données en
+    attente sont écrites avant la protection. La clé de protection n'est pas gérée.
+*****/
+
+BOOL Hdl_WriteProtect(struct HandlerData *HData, BOOL IsProtected, LONG *Result2)
+{
+    if(IsProtected && !Hdl_Flush(HData,Result2) && *Result2!=RETURN_OK) return FALSE;
+
+    *Result2=ERROR_ACTION_NOT_KNOWN;
+    if(!DL_SetProtected(HData->DiskLayerPtr,IsProtected)) return FALSE;
+
+    if(HData->DeviceState!=DS_NONE) HData->DeviceState=IsProtected?DS_WRITE_PROTECTED:DS_READY;
+    *Result2=RETURN_OK;
+
+    return TRUE;
+}
+
+
+/*****
+    Insertion ou retrait simulé du disque virtuel en mémoire.
+    Les données en attente sont écrites avant le retrait. Le changement est ensuite
+    traité comme celui d'un lecteur (voir Hdl_CheckChange()).
+*****/
+
+BOOL Hdl_ChangeDisk(struct HandlerData *HData, BOOL IsDiskIn, LONG *Result2)
+{
+    if(!IsDiskIn && !Hdl_Flush(HData,Result2) && *Result2!=RETURN_OK) return FALSE;
+
+    *Result2=ERROR_ACTION_NOT_KNOWN;
+    if(!DL_ChangeDisk(HData->DiskLayerPtr,IsDiskIn)) return FALSE;
+    *Result2=RETURN_OK;
+
+    return TRUE;
+}
+
+
+/*****
+    Fonction appelée automatiquement quand un disque a été inséré ou enlevé
 *****/
 
 void Hdl_CheckChange(struct HandlerData *HData)
@@ -864,9 +947,9 @@ void Hdl_CheckChange(struct HandlerData *HData)
     if(DL_IsDiskIn(HData->DiskLayerPtr))
     {
         /* Disk In */
-        char VolumeName[TMPSIZEOF]="TFS"; /* Taille arbitraire assez grande pour contenir un nom potentiellement retravaill */
+        char VolumeName[TMPSIZEOF]="TFS"; /* Taille arbitraire assez grande pour contenir un nom potentiellement retravaillé */
 
-        /* Rcupration du statut du lecteur ou du disque */
+        /* Récupération du statut du lecteur ou du disque */
         HData->DeviceState=DL_IsProtected(HData->DiskLayerPtr)?DS_WRITE_PROTECTED:DS_READY;
 
         /* On nettoie le cache du device et le cache de la couche DiskLayer */
@@ -880,17 +963,17 @@ void Hdl_CheckChange(struct HandlerData *HData)
             LONG Year,Month,Day,Hour,Min,Sec;
             if(FS_GetVolumeDate(HData->FS,&Year,&Month,&Day,&Hour,&Min,&Sec))
             {
-                /* On fixe la date du disque comme dernire date de modification */
+                /* On fixe la date du disque comme dernière date de modification */
                 P_Hdl_DateToDateStamp(&HData->LatestMod,Year,Month,Day,Hour,Min,Sec);
             }
             else
             {
-                /* Note: comme il n'y a pas de date pour les rpertoires, on met la
-                   date courante. Le systme se sert de la date du rpertoire comme UID
+                /* Note: comme il n'y a pas de date pour les répertoires, on met la
+                   date courante. Le système se sert de la date du répertoire comme UID
                    pour savoir s'il y a eu des modifications sur le disque.
-                   Par exemple, si la date est la mme entre 2 disques, diskmaster
-                   ne rafrachit pas sa liste de fichiers.
-                   Donc, de cette manire, la liste est rafrachie.
+                   Par exemple, si la date est la même entre 2 disques, diskmaster
+                   ne rafraîchit pas sa liste de fichiers.
+                   Donc, de cette manière, la liste est rafraîchie.
                 */
                 DateStamp(&HData->LatestMod);
             }
@@ -898,12 +981,12 @@ void Hdl_CheckChange(struct HandlerData *HData)
             P_Hdl_GetVolumeName(HData,VolumeName);
         }
 
-        /* On rafrachit le nom et l'icone du volume dans l'amiga OS */
+        /* On rafraîchit le nom et l'icone du volume dans l'amiga OS */
         P_Hdl_SetVolumeEntry(HData,VolumeName,P_Hdl_GetDiskType(HData));
         P_Hdl_RefreshDiskIcon(HData,IECLASS_DISKINSERTED);
         Debug(T("Disk inserted"));
 
-        /* On lance un timeout pour excuter un Motor Off */
+        /* On lance un timeout pour exécuter un Motor Off */
         Hdl_SendTimeout(HData);
     }
     else
@@ -918,7 +1001,7 @@ void Hdl_CheckChange(struct HandlerData *HData)
 
 
 /*****
-    Hook pour grer le changement de disque
+    Hook pour gérer le changement de disque
 *****/
 
 void Hdl_Change(struct DiskLayer *DLayer, void *UserData)
@@ -929,39 +1012,93 @@ void Hdl_Change(struct DiskLayer *DLayer, void *UserData)
 
 
 /*****
-    Envoie ou prolonge une requte Time Out pour l'criture
+    Signale un accès au disque: l'écriture du cache et l'arrêt du moteur sont repoussés.
+    Seule la date de l'accès est notée. Le timer n'est envoyé que s'il n'est pas déjà en
+    cours: c'est à son échéance que Hdl_Timeout() calcule la suivante.
 *****/
 
 void Hdl_SendTimeout(struct HandlerData *HData)
 {
-    if(!CheckIO((struct IORequest *)HData->TimerIO))
+    /* Sans écriture du cache en attente, le timer en cours ne vise que l'arrêt du moteur
+       et peut échoir trop tard: il est alors relancé, une fois par rafale d'accès. */
+    BOOL IsMotorOffTimer=!HData->IsFlushPending;
+
+    DateStamp(&HData->LastAccess);
+    P_Hdl_UpdateAccessRate(HData,&HData->LastAccess);
+    HData->CountOfAccesses++;
+    HData->IsFlushPending=TRUE;
+    HData->IsMotorOffPending=TRUE;
+
+    if(CheckIO((struct IORequest *)HData->TimerIO)==NULL)
     {
-        /* On annule la requte en cours */
+        if(!IsMotorOffTimer) return;
         AbortIO((struct IORequest *)HData->TimerIO);
         Debug(T("Annulation Timeout"));
     }
 
-    /* On attend le droit d'envoyer une nouvelle requte */
+    P_Hdl_SendTimer(HData,HData->FlushDelay);
+    Debug(T("Envoi Timeout"));
+}
+
+
+/*****
+    Echéance du timer: on vide le cache si le disque est inactif depuis FlushDelay, puis
+    on arrête le moteur s'il est inactif depuis le délai d'arrêt du moteur.
+    Sinon, le timer est relancé pour la prochaine échéance.
+*****/
+
+void Hdl_Timeout(struct HandlerData *HData)
+{
+    struct DateStamp Now;
+    LONG Elapsed,Next=-1;
+
+    if(CheckIO((struct IORequest *)HData->TimerIO)==NULL) return;
     WaitIO((struct IORequest *)HData->TimerIO);
 
-    HData->TimerIO->tr_time.tv_secs=1; /* 1 seconde */
-    HData->TimerIO->tr_time.tv_micro=0;
-    HData->TimerIO->tr_node.io_Command=TR_ADDREQUEST;
-    SetSignal(0L,1UL<<HData->TimerPort->mp_SigBit);
-    SendIO((struct IORequest *)HData->TimerIO);
-    Debug(T("Envoi Timeout"));
+    DateStamp(&Now);
+    Elapsed=P_Hdl_GetElapsedTicks(&HData->LastAccess,&Now);
+
+    if(HData->IsFlushPending)
+    {
+        if(Elapsed>=HData->FlushDelay)
+        {
+            LONG Result2=RETURN_OK;
+
+            Hdl_Flush(HData,&Result2);
+            HData->IsFlushPending=FALSE;
+            Debug(T("Time Out: FLUSH\nState=%ld\nResult2=%ld",(long)HData->DeviceState,Result2));
+        }
+        else Next=HData->FlushDelay-Elapsed;
+    }
+
+    if(HData->IsMotorOffPending)
+    {
+        LONG Remaining;
+
+        P_Hdl_UpdateAccessRate(HData,&Now);
+        Remaining=P_Hdl_GetMotorOffDelay(HData)-Elapsed;
+        if(Remaining<=0 && !HData->IsFlushPending)
+        {
+            DL_MotorOff(HData->DiskLayerPtr);
+            HData->IsMotorOffPending=FALSE;
+            Debug(T("Time Out: MOTOR OFF"));
+        }
+        else if(Remaining>0 && (Next<0 || Remaining<Next)) Next=Remaining;
+    }
+
+    if(Next>=0) P_Hdl_SendTimer(HData,Next);
 }
 
 
 /*****
-    Retire le volume ajout par P_Hdl_SetVolumeEntry()
+    Retire le volume ajouté par P_Hdl_SetVolumeEntry()
 *****/
 
 void Hdl_UnsetVolumeEntry(struct HandlerData *HData)
 {
     if(HData->DeviceList!=NULL)
     {
-        /* On tente de verrouiller la DosList des volumes, en mode criture, pour pouvoir
+        /* On tente de verrouiller la DosList des volumes, en mode écriture, pour pouvoir
            Retirer notre volume de cette DosList.
         */
         while(!AttemptLockDosList(LDF_VOLUMES|LDF_WRITE)) Delay(5);
@@ -969,7 +1106,7 @@ void Hdl_UnsetVolumeEntry(struct HandlerData *HData)
         RemDosEntry((struct DosList *)HData->DeviceList);
         UnLockDosList(LDF_VOLUMES|LDF_WRITE);
 
-        /* On libre le noeud allou dans P_Hdl_SetVolumeEntry() */
+        /* On libère le noeud alloué dans P_Hdl_SetVolumeEntry() */
         FreeDosEntry((struct DosList *)HData->DeviceList);
         HData->DeviceList=NULL;
     }
@@ -1054,9 +1191,9 @@ LONG Hdl_ConvertFSCode(struct HandlerData *HData, LONG ErrorCode)
 
 
 /*****
-    Conversion de chane BSTR
-    Entre:
-    - Src: pointeur BCPL sur une chane BSTR
+    Conversion de chaîne BSTR
+    Entrée:
+    - Src: pointeur BCPL sur une chaîne BSTR
     - Dst: pointeur normal sur un buffer de conversion destination
     - SizeOfDst: taille du buffer destination (max 255 octets)
 *****/
@@ -1074,11 +1211,11 @@ LONG Hdl_BSTRToString(BSTR Src, char *Dst, LONG SizeOfDst)
 
 
 /*****
-    Conversion d'une chine normale au format BSTR
-    Note: Le pointeur Dst ne doit pas tre BSTR
-    Entre:
-    - Src: pointeur normal sur la chane source
-    - Dst: pointeur normal sur le buffer destination qui doit contenir la chane BSTR finale
+    Conversion d'une châine normale au format BSTR
+    Note: Le pointeur Dst ne doit pas être BSTR
+    Entrée:
+    - Src: pointeur normal sur la chaîne source
+    - Dst: pointeur normal sur le buffer destination qui doit contenir la chaîne BSTR finale
     - SizeOfDst: taille du buffer destination (min 256 octets)
 *****/
 
@@ -1109,7 +1246,7 @@ LONG Hdl_StringToBSTR(const char *Src, char *Dst, LONG SizeOfDst)
 
 void P_Hdl_FillFib(struct HandlerData *HData, struct FileObject *FO, struct FileInfoBlock *fib)
 {
-    char Tmp[TMPSIZEOF]; /* Taille arbitraire assez grande pour contenir un nom potentiellement retravaill */
+    char Tmp[TMPSIZEOF]; /* Taille arbitraire assez grande pour contenir un nom potentiellement retravaillé */
 
     fib->fib_DirEntryType=ST_FILE;
     Hdl_StringToBSTR(FO->Name,fib->fib_FileName,sizeof(fib->fib_FileName));
@@ -1134,11 +1271,11 @@ LONG P_Hdl_SubExamineAll(struct HandlerData *HData, struct FileObject *Obj, LONG
 {
     LONG Size=MSIZEOF(struct ExAllData,ed_Next);
     struct ExAllData *ead=(struct ExAllData *)BufferPtr;
-    char *Name=NULL,*Comment=NULL,TmpComment[TMPSIZEOF]; /* Taille arbitraire de commentaire assez grand pour contenir un commentaire potentiellement retravaill */
+    char *Name=NULL,*Comment=NULL,TmpComment[TMPSIZEOF]; /* Taille arbitraire de commentaire assez grand pour contenir un commentaire potentiellement retravaillé */
     LONG NameLen=Sys_StrLen(Obj->Name)+sizeof(char);
     LONG CommentLen=Utl_SetCommentMetaData(Obj->Comment,TmpComment,Obj->Type,Obj->ExtraData)+sizeof(char);
 
-    /* Phase 1: On calcule l'espace ncessaire */
+    /* Phase 1: On calcule l'espace nécessaire */
     if(Type>=ED_NAME) Size+=MSIZEOF(struct ExAllData,ed_Name);
     if(Type>=ED_TYPE) Size+=MSIZEOF(struct ExAllData,ed_Type);
     if(Type>=ED_SIZE) Size+=MSIZEOF(struct ExAllData,ed_Size);
@@ -1185,6 +1322,85 @@ LONG P_Hdl_SubExamineAll(struct HandlerData *HData, struct FileObject *Obj, LONG
 }
 
 
+/*****
+    Retourne le cache ExAll() du niveau ED_* demandé, reconstruit si le répertoire
+    a changé depuis. Les entrées sont construites une fois pour toutes par
+    P_Hdl_SubExamineAll() et rangées dans l'ordre du répertoire.
+    Retourne NULL s'il n'y a pas assez de mémoire.
+*****/
+
+struct ExAllCache *P_Hdl_GetExAllCache(struct HandlerData *HData, LONG Type)
+{
+    struct FileSystem *FS=HData->FS;
+    struct ExAllCache *Cache=&HData->ExAllCaches[Type-ED_NAME];
+    ULONG Protection=P_Hdl_GetProtectionFlags(HData);
+    BOOL IsBuild=FALSE;
+
+    if(Cache->Buffer==NULL)
+    {
+        Cache->Buffer=(UBYTE *)Sys_AllocMem(FS->MaxFiles*(sizeof(struct ExAllCacheEntry)+HDL_EXALL_RECORD_MAX));
+        if(Cache->Buffer==NULL) return NULL;
+        IsBuild=TRUE;
+    }
+
+    if(IsBuild || Cache->DirGeneration!=FS->DirGeneration || Cache->Protection!=Protection)
+    {
+        UBYTE *CachePtr=Cache->Buffer;
+        struct FileObject FO;
+
+        FS_ExamineFileObject(FS,&FO);
+        while(FS_ExamineNextFileObject(&FO))
+        {
+            struct ExAllCacheEntry *Entry=(struct ExAllCacheEntry *)CachePtr;
+
+            Entry->FileInfoIdx=FO.FileInfoIdx;
+            Entry->IsTimeOk=FO.IsTimeOk;
+            Entry->Size=P_Hdl_SubExamineAll(HData,&FO,Type,(UBYTE *)&Entry[1],HDL_EXALL_RECORD_MAX);
+            CachePtr=&CachePtr[sizeof(struct ExAllCacheEntry)+((Entry->Size+3)&0xfffffffc)];
+        }
+
+        Cache->Size=CachePtr-Cache->Buffer;
+        Cache->DirGeneration=FS->DirGeneration;
+        Cache->Protection=Protection;
+    }
+
+    return Cache;
+}
+
+
+/*****
+    Copie d'une entrée du cache ExAll() dans le buffer de l'appelant.
+    Les pointeurs sur le nom et le commentaire sont recalés sur le buffer, et les
+    fichiers sans date reçoivent la date courante comme dans P_Hdl_SubExamineAll().
+    Retourne la taille de l'entrée, ou 0 si la place manque.
+*****/
+
+LONG P_Hdl_CopyExAllEntry(struct ExAllCacheEntry *Entry, LONG Type, UBYTE *BufferPtr, LONG SpaceLeft)
+{
+    struct ExAllData *Src=(struct ExAllData *)&Entry[1];
+    struct ExAllData *ead=(struct ExAllData *)BufferPtr;
+
+    if(Entry->Size<=SpaceLeft)
+    {
+        Sys_MemCopy((void *)ead,(void *)Src,Entry->Size);
+        if(Type>=ED_NAME) ead->ed_Name=&BufferPtr[(UBYTE *)Src->ed_Name-(UBYTE *)Src];
+        if(Type>=ED_COMMENT) ead->ed_Comment=&BufferPtr[(UBYTE *)Src->ed_Comment-(UBYTE *)Src];
+        if(Type>=ED_DATE && !Entry->IsTimeOk)
+        {
+            struct DateStamp ds;
+            DateStamp(&ds);
+            ead->ed_Days=ds.ds_Days;
+            ead->ed_Mins=ds.ds_Minute;
+            ead->ed_Ticks=ds.ds_Tick;
+        }
+
+        return Entry->Size;
+    }
+
+    return 0;
+}
+
+
 /*****************************************************/
 /* SOUS-ROUTINE DE GESTION DU VOLUME POUR LE SYSTEME */
 /*****************************************************/
@@ -1204,7 +1420,7 @@ BOOL P_Hdl_SetVolumeEntry(struct HandlerData *HData, const char *VolumeName, ULO
         ndl->dl_LockList=MKBADDR(HData->FirstLock);
 
         /* Note: On ne doit pas indiquer de date de volume quand celui-ci
-           est non DOS. Sinon, la commande format du workbench condidre
+           est non DOS. Sinon, la commande format du workbench condidère
            le volume comme ayant un file system.
         */
         if(ndl->dl_DiskType==ID_DOS_DISK)
@@ -1222,25 +1438,25 @@ BOOL P_Hdl_SetVolumeEntry(struct HandlerData *HData, const char *VolumeName, ULO
 
         Debug(T("P_Hdl_SetVolumeEntry: Name='%s', Type=%08lX",VolumeName,DiskType));
 
-        /* On retire le prcdent set qu'on a fait. Cette fonction fonctionne mme s'il n'y en a pas */
+        /* On retire le précédent set qu'on a fait. Cette fonction fonctionne même s'il n'y en a pas */
         Hdl_UnsetVolumeEntry(HData);
 
         /* On tente de verrouiller la DosList qui concerne les volumes.
-           Comme on souhaite ajouter un nouveau noeud, on la verrouille en criture.
+           Comme on souhaite ajouter un nouveau noeud, on la verrouille en écriture.
         */
         while(!AttemptLockDosList(LDF_VOLUMES|LDF_WRITE)) Delay(5);
         //LockDosList(LDF_VOLUMES|LDF_READ);
 
-        /* On ajoute le noeud cr en dbut de fonction, dans cette DosList */
+        /* On ajoute le noeud créé en début de fonction, dans cette DosList */
         if(AddDosEntry((struct DosList *)ndl)) HData->DeviceList=ndl;
         else
         {
-            /* Si chec, on libre l'espace allou par MakeDosEntry(), et tant pis... */
+            /* Si échec, on libère l'espace alloué par MakeDosEntry(), et tant pis... */
             FreeDosEntry((struct DosList *)ndl);
             ndl=NULL;
         }
 
-        /* On dverrouille la DosList qui a t verrouille par AttemptLockDosList() */
+        /* On déverrouille la DosList qui a été verrouillée par AttemptLockDosList() */
         UnLockDosList(LDF_VOLUMES|LDF_WRITE);
     }
 
@@ -1249,8 +1465,8 @@ BOOL P_Hdl_SetVolumeEntry(struct HandlerData *HData, const char *VolumeName, ULO
 
 
 /*****
-    Lance le rafrachissement de la Dos List par le workbench.
-    Note: cette fonction acclre le rafrachissement de l'icne
+    Lance le rafraîchissement de la Dos List par le workbench.
+    Note: cette fonction accélère le rafraîchissement de l'icône
 *****/
 
 void P_Hdl_RefreshDiskIcon(struct HandlerData *HData, LONG ClassID)
@@ -1296,7 +1512,7 @@ void P_Hdl_RefreshDiskIcon(struct HandlerData *HData, LONG ClassID)
 /*********************/
 
 /*****
-    Permet d'obtenir un lock sur un fichier  partir de sa cl
+    Permet d'obtenir un lock sur un fichier à partir de sa clé
 *****/
 
 struct FileLockTO *P_Hdl_LockObjectFromKey(struct HandlerData *HData, LONG LockMode, LONG Key, LONG *Result2)
@@ -1316,7 +1532,7 @@ struct FileLockTO *P_Hdl_LockObjectFromKey(struct HandlerData *HData, LONG LockM
 
 
 /*****
-    Permet de savoir si un fichier est lockable  partir de son index (Key)
+    Permet de savoir si un fichier est lockable à partir de son index (Key)
 *****/
 
 BOOL P_Hdl_IsObjectLockable(struct HandlerData *HData, LONG Key, LONG LockMode)
@@ -1372,7 +1588,7 @@ struct FileLockTO *P_Hdl_AddNewLock(struct HandlerData *HData, LONG Key, LONG Lo
 
 
 /*****
-    Libre un lock de la liste des locks
+    Libère un lock de la liste des locks
 *****/
 
 void P_Hdl_RemoveLock(struct HandlerData *HData, struct FileLockTO *FL)
@@ -1391,7 +1607,7 @@ void P_Hdl_RemoveLock(struct HandlerData *HData, struct FileLockTO *FL)
 /************************/
 
 /*****
-    Pour savoir si le priphrique est prt  tre gr
+    Pour savoir si le périphérique est prêt à être géré
 *****/
 
 BOOL P_Hdl_IsDeviceValids(struct HandlerData *HData)
@@ -1402,7 +1618,7 @@ BOOL P_Hdl_IsDeviceValids(struct HandlerData *HData)
 
 
 /*****
-    Rcupration des bits de protection des fichiers
+    Récupération des bits de protection des fichiers
 *****/
 
 ULONG P_Hdl_GetProtectionFlags(struct HandlerData *HData)
@@ -1415,8 +1631,8 @@ ULONG P_Hdl_GetProtectionFlags(struct HandlerData *HData)
 
 
 /*****
-    Rcupration saine du nom du volume
-    Note: il est interdit de donner un nom vide  l'OS.
+    Récupération saine du nom du volume
+    Note: il est interdit de donner un nom vide à l'OS.
 *****/
 
 void P_Hdl_GetVolumeName(struct HandlerData *HData, char *VolumeName)
@@ -1430,7 +1646,7 @@ void P_Hdl_GetVolumeName(struct HandlerData *HData, char *VolumeName)
 
 
 /*****
-    Retourne le bon disque type en fonction de l'tat du disque
+    Retourne le bon disque type en fonction de l'état du disque
     Retour:
     - ID_NO_DISK_PRESENT: si pas de disque dans le lecteur
     - ID_UNREADABLE_DISK: si erreur de lecture sur la piste 20
@@ -1456,7 +1672,7 @@ ULONG P_Hdl_GetDiskType(struct HandlerData *HData)
 /*****
     Conversion d'une date en datestamp
     Retour:
-    - ds: pointe une structure DateStamp qui sera correctement initialise
+    - ds: pointe une structure DateStamp qui sera correctement initialisée
 *****/
 
 void P_Hdl_DateToDateStamp(struct DateStamp *ds, LONG Year, LONG Month, LONG Day, LONG Hour, LONG Min, LONG Sec)
@@ -1479,6 +1695,73 @@ void P_Hdl_DateToDateStamp(struct DateStamp *ds, LONG Year, LONG Month, LONG Day
 }
 
 
+/*****
+    Envoi d'une requête au timer.
+    La requête précédente doit être terminée.
+*****/
+
+void P_Hdl_SendTimer(struct HandlerData *HData, LONG Ticks)
+{
+    WaitIO((struct IORequest *)HData->TimerIO);
+
+    HData->TimerIO->tr_time.tv_secs=Ticks/TICKS_PER_SECOND;
+    HData->TimerIO->tr_time.tv_micro=(Ticks%TICKS_PER_SECOND)*(1000000/TICKS_PER_SECOND);
+    HData->TimerIO->tr_node.io_Command=TR_ADDREQUEST;
+    SetSignal(0L,1UL<<HData->TimerPort->mp_SigBit);
+    SendIO((struct IORequest *)HData->TimerIO);
+}
+
+
+/*****
+    Vieillissement du compteur d'accès: il est divisé par deux pour chaque fenêtre
+    HDL_RATE_WINDOW écoulée.
+*****/
+
+void P_Hdl_UpdateAccessRate(struct HandlerData *HData, const struct DateStamp *Now)
+{
+    LONG Elapsed=P_Hdl_GetElapsedTicks(&HData->RateStart,Now);
+
+    if(Elapsed>=HDL_RATE_WINDOW)
+    {
+        HData->CountOfAccesses=Elapsed<2*HDL_RATE_WINDOW?HData->CountOfAccesses/2:0;
+        HData->RateStart=*Now;
+    }
+}
+
+
+/*****
+    Délai d'arrêt du moteur: il est prolongé quand les accès sont fréquents, pour
+    éviter d'arrêter et de redémarrer le moteur entre deux rafales d'accès.
+*****/
+
+LONG P_Hdl_GetMotorOffDelay(struct HandlerData *HData)
+{
+    if(HData->CountOfAccesses>=HDL_BUSY_ACCESSES) return HData->MotorOffDelay*HDL_BUSY_FACTOR;
+    return HData->MotorOffDelay;
+}
+
+
+/*****
+    Nombre de ticks écoulés entre deux dates.
+    Si la date de fin précède celle du début (horloge changée), on retourne le maximum
+    pour que les échéances en cours soient atteintes.
+*****/
+
+LONG P_Hdl_GetElapsedTicks(const struct DateStamp *From, const struct DateStamp *To)
+{
+    LONG Days=To->ds_Days-From->ds_Days;
+    LONG Ticks;
+
+    /* Au-delà d'un jour, tous les délais sont de toute façon écoulés */
+    if(Days<0 || Days>=2) return 0x7fffffff;
+
+    Ticks=((Days*24*60+To->ds_Minute-From->ds_Minute)*60)*TICKS_PER_SECOND+To->ds_Tick-From->ds_Tick;
+    if(Ticks<0) return 0x7fffffff;
+
+    return Ticks;
+}
+
+
 /*************************************************/
 /* SOUS-ROUTINES DE GESTION DES NOMS DE FICHIERS */
 /*************************************************/
@@ -1517,8 +1800,8 @@ const char *P_Hdl_NamePart(const char *Path)
     Extraction du nom du fichier d'un chemin, si le chemin est valide
     Retourne:
     - 0 si le chemin est valide mais ne contient pas de nom de fichier (par exemple, juste un nom de volume "TA0:")
-    - 1 si un nom de fichier a t extrait
-    - >1 si le chemin contient une arborescence de rpertoire (non valide avec le file system thomson)
+    - 1 si un nom de fichier a été extrait
+    - >1 si le chemin contient une arborescence de répertoire (non valide avec le file system thomson)
 *****/
 
 ULONG P_Hdl_ParsePath(struct FileLockTO *FLBase, const char *Path, char *ObjectName, LONG *Result2)
@@ -9,6 +9,8 @@
 #define ACTION_TOFS_BASE            0x10000
 #define ACTION_TOFS_LOCKSECTOR      (ACTION_TOFS_BASE+1)
 #define ACTION_TOFS_UNLOCKSECTOR    (ACTION_TOFS_BASE+2)
+#define ACTION_TOFS_CHANGEDISK      (ACTION_TOFS_BASE+3)
+#define ACTION_TOFS_GETSIMSTATS     (ACTION_TOFS_BASE+4)
 
 
 #define DS_NONE             0
@@ -17,6 +19,39 @@
 
 #define TMPSIZEOF           32
 
+/* Dlais d'inactivit par dfaut, en ticks */
+#define HDL_DFLT_FLUSH_DELAY        (1*TICKS_PER_SECOND)
+#define HDL_DFLT_MOTOROFF_DELAY     (3*TICKS_PER_SECOND)
+
+/* Mesure du rythme des accs: au-del de HDL_BUSY_ACCESSES accs rcents,
+   le dlai d'arrt du moteur est multipli par HDL_BUSY_FACTOR */
+#define HDL_RATE_WINDOW             (10*TICKS_PER_SECOND)
+#define HDL_BUSY_ACCESSES           32
+#define HDL_BUSY_FACTOR             4
+
+/* Nombre de niveaux ED_* mis en cache pour ExAll(), et taille maximale d'une entre */
+#define HDL_EXALL_TYPES             (ED_OWNER-ED_NAME+1)
+#define HDL_EXALL_RECORD_MAX        ((sizeof(struct ExAllData)+SIZEOF_CONV_HOSTNAME+sizeof(char)+TMPSIZEOF+3)&0xfffffffc)
+
+
+/* Entre d'un cache ExAll(), suivie de l'ExAllData prconstruite */
+struct ExAllCacheEntry
+{
+    LONG FileInfoIdx;
+    LONG Size;
+    BOOL IsTimeOk;
+};
+
+
+/* Flot des entres ExAll() prconstruites pour un niveau ED_*, valable pour une gnration du rpertoire */
+struct ExAllCache
+{
+    UBYTE *Buffer;
+    LONG Size;
+    ULONG DirGeneration;
+    ULONG Protection;
+};
+
 
 struct HandlerData
 {
@@ -30,6 +65,13 @@ struct HandlerData
 
     struct timerequest *TimerIO;
     struct MsgPort *TimerPort;
+    struct DateStamp LastAccess;    /* Date du dernier accs au disque */
+    struct DateStamp RateStart;     /* Dbut de la fentre de comptage des accs */
+    LONG CountOfAccesses;           /* Accs rcents, diviss par deux  chaque fentre coule */
+    LONG FlushDelay;                /* Dlai d'inactivit avant l'criture du cache, en ticks */
+    LONG MotorOffDelay;             /* Dlai d'inactivit avant l'arrt du moteur, en ticks */
+    BOOL IsFlushPending;
+    BOOL IsMotorOffPending;
 
     struct DiskLayer *DiskLayerPtr;
 
@@ -37,6 +79,7 @@ struct HandlerData
     struct FileLockTO *FirstLock;
     LONG FileSystemStatus;
     BOOL IsSensitive;
+    struct ExAllCache ExAllCaches[HDL_EXALL_TYPES];
 
     LONG InhibitCounter;
     ULONG DeviceState;
@@ -76,6 +119,7 @@ extern LONG Hdl_Seek(struct HandlerData *, struct FileLockTO *, LONG, LONG, LONG
 extern BOOL Hdl_ExamineObject(struct HandlerData *, struct FileLockTO *, struct FileInfoBlock *, LONG *);
 extern BOOL Hdl_ExamineNext(struct HandlerData *, struct FileLockTO *, struct FileInfoBlock *, LONG *);
 extern BOOL Hdl_ExamineAll(struct HandlerData *, struct FileLockTO *, UBYTE *, LONG, LONG, struct ExAllControl *, LONG *);
+extern void Hdl_FreeExAllCaches(struct HandlerData *);
 
 extern BOOL Hdl_Rename(struct HandlerData *, struct FileLockTO *, const char *, struct FileLockTO *, const char *, LONG *);
 extern BOOL Hdl_Delete(struct HandlerData *, struct FileLockTO *, const char *, LONG *);
@@ -86,10 +130,13 @@ extern BOOL Hdl_SetFileSize(struct HandlerData *, struct FileLockTO *, LONG, LON
 extern BOOL Hdl_DiskInfo(struct HandlerData *, struct InfoData *);
 extern BOOL Hdl_Relabel(struct HandlerData *, const char *, LONG *);
 extern BOOL Hdl_Format(struct HandlerData *, const char *, LONG *);
+extern BOOL Hdl_WriteProtect(struct HandlerData *, BOOL, LONG *);
+extern BOOL Hdl_ChangeDisk(struct HandlerData *, BOOL, LONG *);
 
 extern void Hdl_CheckChange(struct HandlerData *);
 extern void Hdl_Change(struct DiskLayer *, void *);
 extern void Hdl_SendTimeout(struct HandlerData *);
+extern void Hdl_Timeout(struct HandlerData *);
 
 extern void Hdl_UnsetVolumeEntry(struct HandlerData *);
 
@@ -4,18 +4,26 @@
 #include "handler.h"
 #include "filesystem.h"
 #include "disklayer.h"
+#include "datalayersim.h"
 
 
 /*
-    23-04-2021 (Seg)    Gestion du mode tendu via le flag
-    10-09-2020 (Seg)    Quelques adaptations suite  la refonte globale de la couche filesystem
-    14-08-2018 (Seg)    Gestion des paramtres gomtriques du disque
+    17-10-2026 (Seg)    Lecture des statistiques du lecteur simulé par ACTION_TOFS_GETSIMSTATS
+    17-10-2026 (Seg)    Gestion de ACTION_WRITE_PROTECT et ACTION_TOFS_CHANGEDISK pour le disque virtuel
+    17-10-2026 (Seg)    ACTION_DIE écrit d'abord les données en attente et échoue si l'écriture échoue
+    17-10-2026 (Seg)    Libération des caches ExAll()
+    17-10-2026 (Seg)    Option d'écriture des pistes en entier via le flag
+    17-10-2026 (Seg)    Délais d'écriture du cache et d'arrêt du moteur via le flag
+    17-10-2026 (Seg)    Gestion de la lecture par piste complète via le flag
+    23-04-2021 (Seg)    Gestion du mode étendu via le flag
+    10-09-2020 (Seg)    Quelques adaptations suite à la refonte globale de la couche filesystem
+    14-08-2018 (Seg)    Gestion des paramètres géométriques du disque
     30-08-2016 (Seg)    Finalisation du handler
-    03-01-2009 (Seg)    Dbut du codage du Handler Thomson
+    03-01-2009 (Seg)    Début du codage du Handler Thomson
 
     TODO:
-    - grer les fichiers lower/upper case.
-    - grer les doublons de fichiers lis au type diffrent.
+    - gérer les fichiers lower/upper case.
+    - gérer les doublons de fichiers liés au type différent.
 */
 
 #define DEFAULT_BUFFERS 16
@@ -53,28 +61,31 @@ LONG __saveds main(VOID)
             {
                 if(!OpenDevice(TIMERNAME,UNIT_MICROHZ,(struct IORequest *)HData.TimerIO,0))
                 {
-                    /* Envoi de la premire requte time out */
+                    /* Envoi de la première requête time out */
                     HData.TimerIO->tr_time.tv_secs=0;
                     HData.TimerIO->tr_time.tv_micro=0;
                     HData.TimerIO->tr_node.io_Command=TR_ADDREQUEST;
                     SendIO((struct IORequest *)HData.TimerIO);
 
-                    /* Dbut du traitement des messages */
+                    /* Début du traitement des messages */
                     if(WaitStart(&HData))
                     {
                         LONG Result2=RETURN_OK;
 
                         MainLoop(&HData);
 
-                        /* On nettoie tout. Note: les messages rsiduels sont dtruits
-                           lors de la libration du msgport.
+                        /* On nettoie tout. Note: les messages résiduels sont détruits
+                           lors de la libération du msgport. Le moteur est arrêté par
+                           DL_Close().
                         */
+                        AbortIO((struct IORequest *)HData.TimerIO);
                         WaitIO((struct IORequest *)HData.TimerIO);
-                        Hdl_Flush(&HData,&Result2); /* + MOTOR OFF */
+                        Hdl_Flush(&HData,&Result2);
 
                         DL_Close(HData.DiskLayerPtr);
                     }
 
+                    Hdl_FreeExAllCaches(&HData);
                     FS_FreeFileSystem(HData.FS);
 
                     AbortIO((struct IORequest *)HData.TimerIO);
@@ -123,8 +134,12 @@ BOOL WaitStart(struct HandlerData *HData)
              *  - dp_Arg3: BPTR sur la structure DeviceNode
              *  - dp_Arg4: Reserve pour un Message Port alternatif
              *
-             * Format du flag: eoofllsssss
-             * - e=format tendu (=1) ou original (=0).   Mask=10000000000 ($400)
+             * Format du flag: mmmmmmmmcccccccc000rteoofllsssss
+             * - m=délai d'arrêt du moteur en 1/10s (0=3s).   Mask=$ff000000
+             * - c=délai d'écriture du cache en 1/10s (0=1s). Mask=$00ff0000
+             * - r=écriture des pistes en entier (=1).    Mask=1000000000000 ($1000)
+             * - t=lecture par piste complète (=1).       Mask=100000000000 ($800)
+             * - e=format étendu (=1) ou original (=0).   Mask=10000000000 ($400)
              * - o=Side operation (01=side 0, 10=side 1). Mask=01100000000 ($300)
              * - f=flag Thomson (=1).                     Mask=00010000000 ($080)
              * - l=sector length (10=256 bytes).          Mask=00001100000 ($060)
@@ -138,6 +153,12 @@ BOOL WaitStart(struct HandlerData *HData)
             LONG SectorSize=BitsSectorSize!=0?128<<BitsSectorSize:EnvTab->de_SizeBlock;
             LONG SectorsPerTrack=BitsSectorCount!=0?BitsSectorCount:EnvTab->de_BlocksPerTrack;
             LONG CountOfBufferMax=EnvTab->de_NumBuffers!=0?EnvTab->de_NumBuffers:DEFAULT_BUFFERS;
+            ULONG Options=(((FSStartupMsg->fssm_Flags>>11)&1)?DL_OPT_TRACKREAD:0)|(((FSStartupMsg->fssm_Flags>>12)&1)?DL_OPT_RMW:0);
+            LONG FlushDelay=(FSStartupMsg->fssm_Flags>>16)&0xff;
+            LONG MotorOffDelay=(FSStartupMsg->fssm_Flags>>24)&0xff;
+
+            HData->FlushDelay=FlushDelay!=0?FlushDelay*TICKS_PER_SECOND/10:HDL_DFLT_FLUSH_DELAY;
+            HData->MotorOffDelay=MotorOffDelay!=0?MotorOffDelay*TICKS_PER_SECOND/10:HDL_DFLT_MOTOROFF_DELAY;
 
             if((HData->FS=FS_AllocFileSystem((LONG)EnvTab->de_HighCyl+1,SectorSize,SectorsPerTrack,IsExtended))!=NULL)
             {
@@ -147,11 +168,11 @@ BOOL WaitStart(struct HandlerData *HData)
 
                 HData->DevNode->dn_Task=(struct MsgPort *)&HData->Process->pr_MsgPort;
                 HData->DeviceUnit=FSStartupMsg->fssm_Unit;
-                HData->DeviceFlags=FSStartupMsg->fssm_Flags;
+                HData->DeviceFlags=FSStartupMsg->fssm_Flags&0x7ff; /* Seuls les flags eoofllsssss concernent le device */
                 Hdl_BSTRToString(FSStartupMsg->fssm_Device,HData->DeviceName,sizeof(HData->DeviceName));
                 Debug(T("Startup: Side=%ld",HData->Side));
 
-                HData->DiskLayerPtr=DL_Open(HData->DeviceName,HData->DeviceFlags,HData->DeviceUnit,HData->Side,SectorsPerTrack,SectorSize,CountOfBufferMax,Hdl_Change,(void *)HData,&ErrorCode);
+                HData->DiskLayerPtr=DL_Open(HData->DeviceName,HData->DeviceFlags,Options,HData->DeviceUnit,HData->Side,(ULONG)EnvTab->de_HighCyl+1,SectorsPerTrack,SectorSize,CountOfBufferMax,Hdl_Change,(void *)HData,&ErrorCode);
                 if(HData->DiskLayerPtr!=NULL)
                 {
                     Debug(T("ACTION_STARTUP:\nName='%s'\nFlags=%lx\nUnit=%ld\nInterleave=%ld\nSectorSize=%ld\nSectorsPerTrack=%ld",
@@ -178,14 +199,14 @@ BOOL WaitStart(struct HandlerData *HData)
 
 
 /*****
-    Gestion des messages reus par le handler
+    Gestion des messages reçus par le handler
 *****/
 
 void MainLoop(struct HandlerData *HData)
 {
     BOOL IsExit=FALSE;
 
-    /* Dmarrage du handler */
+    /* Démarrage du handler */
     while(!IsExit)
     {
         ULONG WaitSig=Wait(
@@ -193,25 +214,15 @@ void MainLoop(struct HandlerData *HData)
             (1UL<<HData->TimerPort->mp_SigBit));
         struct DiskLayer *DLayer=HData->DiskLayerPtr;
 
-        /* On vrifie si un disque a t insr ou retir */
+        /* On vérifie si un disque a été inséré ou retiré */
         if(DL_IsChanged(DLayer))
         {
             Hdl_CheckChange(HData);
             DL_SetChanged(DLayer,FALSE);
         }
 
-        /* On vrifie si on a une requte Time out pour vider les buffers */
-        if((WaitSig & (1UL<<HData->TimerPort->mp_SigBit))!=0)
-        {
-            LONG Result2=RETURN_OK;
-
-            WaitIO((struct IORequest *)HData->TimerIO);
-
-            /* On enregistre ce qui est en cache + Motor OFF */
-            Hdl_Flush(HData,&Result2);
-
-            Debug(T("Time Out: FLUSH\nState=%ld\nResult2=%ld",(long)HData->DeviceState,Result2));
-        }
+        /* On vérifie si on a une échéance pour vider les buffers ou arrêter le moteur */
+        if((WaitSig & (1UL<<HData->TimerPort->mp_SigBit))!=0) Hdl_Timeout(HData);
 
         /* Traitement des messages du handler */
         if((WaitSig & (1UL<<HData->Process->pr_MsgPort.mp_SigBit))!=0)
@@ -231,8 +242,12 @@ void MainLoop(struct HandlerData *HData)
                         case ACTION_DIE:
                             /* Note: le DIE ne peut fonctionner que s'il n'y a pas de lock ouvert,
                                sinon, l'action retourne ERROR_OBJECT_IN_USE.
+                               Les données en attente sont écrites avant de quitter: si l'écriture
+                               échoue, le handler reste actif (les données sont gardées) et
+                               l'erreur est retournée.
                             */
                             if(HData->FirstLock!=NULL) Result2=ERROR_OBJECT_IN_USE;
+                            else if(!Hdl_Flush(HData,&Result2) && Result2!=RETURN_OK) Debug(T("ACTION_DIE: flush error %ld",Result2));
                             else {Result1=DOSTRUE; IsExit=TRUE;}
                             break;
 
@@ -241,7 +256,7 @@ void MainLoop(struct HandlerData *HData)
                                                DOSFALSE = uninhibit
                                RES1:   BOOL    Success/failure (DOSTRUE/DOSFALSE)
 
-                               Note: l'action ne fonctionne que s'il n'y a pas de lock dj ouvert,
+                               Note: l'action ne fonctionne que s'il n'y a pas de lock déjà ouvert,
                                sinon, elle retourne ERROR_OBJECT_IN_USE.
                             */
                             {
@@ -275,8 +290,8 @@ void MainLoop(struct HandlerData *HData)
                                RES2:   CODE    Failure code if RES1 = NULL
 
                                Note: Cette action ouvre un handle en fonction d'un lock. Si un handle est
-                               dj attach au lock, celui-ci est cras par le nouveau. C'est  l'utilisateur
-                               de cette action d'tre vigilant.
+                               déjà attaché au lock, celui-ci est écrasé par le nouveau. C'est à l'utilisateur
+                               de cette action d'être vigilant.
                             */
                             {
                                 LONG ErrorCode=FS_SUCCESS;
@@ -301,8 +316,8 @@ void MainLoop(struct HandlerData *HData)
                             /* ARG1:   LOCK    Lock to free
                                RES1:   BOOL    TRUE
 
-                               Note: Cette action libre les ressources alloues par le lock.
-                               Si un handle est attach au lock, celui-ci est ferm par cette action.
+                               Note: Cette action libère les ressources allouées par le lock.
+                               Si un handle est attaché au lock, celui-ci est fermé par cette action.
                             */
                             {
                                 struct FileLockTO *FL=(struct FileLockTO *)BADDR(DosPacket->dp_Arg1);
@@ -468,8 +483,8 @@ void MainLoop(struct HandlerData *HData)
                                RES1:   BOOL    Success/Failure (DOSTRUE/DOSFALSE)
                                RES2:   CODE    Failure code if RES1 is DOSFALSE
 
-                               Note: ces actions sont vites en amont si aucun disque n'est prsent dans
-                               le lecteur. En revanche, ces actions grent si le disque est protg.
+                               Note: ces actions sont évitées en amont si aucun disque n'est présent dans
+                               le lecteur. En revanche, ces actions gèrent si le disque est protégé.
                             */
                             {
                                 struct FileLockTO *NewFL;
@@ -490,8 +505,8 @@ void MainLoop(struct HandlerData *HData)
                             /* ARG1:   ARG1    fh_Arg1 field of the opened FileHandle
                                RES1:   LONG    DOSTRUE
 
-                               Note: cette action est vite en amont si aucun disque n'est prsent dans
-                               le lecteur. En revanche, cette action gre si le disque est protg.
+                               Note: cette action est évitée en amont si aucun disque n'est présent dans
+                               le lecteur. En revanche, cette action gère si le disque est protégé.
                             */
                             {
                                 struct FileLockTO *FL=(struct FileLockTO *)DosPacket->dp_Arg1;
@@ -510,7 +525,7 @@ void MainLoop(struct HandlerData *HData)
                                                -1 indicates ERROR
                                RES2:   CODE    Failure code if RES1 is -1
 
-                               Note: cette action est vite en amont si aucun disque n'est prsent dans
+                               Note: cette action est évitée en amont si aucun disque n'est présent dans
                                le lecteur.
                             */
                             {
@@ -529,8 +544,8 @@ void MainLoop(struct HandlerData *HData)
                                RES1:   LONG    Number of bytes written.
                                RES2:   CODE    Failure code if RES1 not the same as ARG3
 
-                               Note: cette action est vite en amont si aucun disque n'est prsent dans
-                               le lecteur. En revanche, cette action gre si le disque est protg.
+                               Note: cette action est évitée en amont si aucun disque n'est présent dans
+                               le lecteur. En revanche, cette action gère si le disque est protégé.
                             */
                             {
                                 struct FileLockTO *FL=(struct FileLockTO *)DosPacket->dp_Arg1;
@@ -566,8 +581,8 @@ void MainLoop(struct HandlerData *HData)
                                RES1:   BOOL    Success/Failure (DOSTRUE/DOSFALSE)
                                RES2:   CODE    Failure code if RES1 is DOSFALSE
 
-                               Note: cette action est vite en amont si aucun disque n'est prsent dans
-                               le lecteur. En revanche, cette action gre si le disque est protg.
+                               Note: cette action est évitée en amont si aucun disque n'est présent dans
+                               le lecteur. En revanche, cette action gère si le disque est protégé.
                             */
                             {
                                 struct FileLockTO *FL=(struct FileLockTO *)DosPacket->dp_Arg1;
@@ -585,8 +600,8 @@ void MainLoop(struct HandlerData *HData)
                                RES1:   BOOL    Success/Failure (DOSTRUE/DOSFALSE)
                                RES2:   CODE    Failure code if RES1 is DOSFALSE
 
-                               Note: cette action est vite en amont si aucun disque n'est prsent dans
-                               le lecteur. En revanche, cette action gre si le disque est protg.
+                               Note: cette action est évitée en amont si aucun disque n'est présent dans
+                               le lecteur. En revanche, cette action gère si le disque est protégé.
                             */
                             {
                                 LONG Type=DosPacket->dp_Arg2;
@@ -602,8 +617,8 @@ void MainLoop(struct HandlerData *HData)
                                RES1:   BOOL    Success/failure (DOSTRUE/DOSFALSE)
                                RES2:   CODE    Failure code if RES1 = DOSFALSE
 
-                               Note: cette action est vite en amont si aucun disque n'est prsent dans
-                               le lecteur. En revanche, cette action gre si le disque est protg.
+                               Note: cette action est évitée en amont si aucun disque n'est présent dans
+                               le lecteur. En revanche, cette action gère si le disque est protégé.
                             */
                             {
                                 struct FileLockTO *FLBase=(struct FileLockTO *)BADDR(DosPacket->dp_Arg1);
@@ -621,8 +636,8 @@ void MainLoop(struct HandlerData *HData)
                                RES1:   BOOL    Success/failure (DOSTRUE/DOSFALSE)
                                RES2:   CODE    Failure code if RES1 = DOSFALSE
 
-                               Note: cette action est vite en amont si aucun disque n'est prsent dans
-                               le lecteur. En revanche, cette action gre si le disque est protg.
+                               Note: cette action est évitée en amont si aucun disque n'est présent dans
+                               le lecteur. En revanche, cette action gère si le disque est protégé.
                             */
                             {
                                 struct FileLockTO *FLBase=(struct FileLockTO *)BADDR(DosPacket->dp_Arg2);
@@ -641,8 +656,8 @@ void MainLoop(struct HandlerData *HData)
                                RES1:   BOOL    Success/failure (DOSTRUE/DOSFALSE)
                                RES2:   CODE    Failure code if RES1 = DOSFALSE
 
-                               Note: cette action est vite en amont si aucun disque n'est prsent dans
-                               le lecteur. En revanche, cette action gre si le disque est protg.
+                               Note: cette action est évitée en amont si aucun disque n'est présent dans
+                               le lecteur. En revanche, cette action gère si le disque est protégé.
                             */
                             {
                                 struct FileLockTO *FLBase1=(struct FileLockTO *)BADDR(DosPacket->dp_Arg1);
@@ -658,8 +673,8 @@ void MainLoop(struct HandlerData *HData)
                             /* ARG1:   BSTR    New disk name
                                RES1:   BOOL    Success/Failure (DOSTRUE/DOSFALSE)
 
-                               Note: cette action est vite en amont si aucun disque n'est prsent dans
-                               le lecteur. En revanche, cette action gre si le disque est protg.
+                               Note: cette action est évitée en amont si aucun disque n'est présent dans
+                               le lecteur. En revanche, cette action gère si le disque est protégé.
                             */
                             {
                                 Hdl_BSTRToString(DosPacket->dp_Arg1,HData->TmpName,sizeof(HData->TmpName));
@@ -726,8 +741,8 @@ void MainLoop(struct HandlerData *HData)
                                RES1:   BOOL    Success/failure (DOSTRUE/DOSFALSE)
                                RES2:   CODE    Failure code if RES1 = DOSFALSE
 
-                               Note: cette action est vite en amont si aucun disque n'est prsent dans
-                               le lecteur. En revanche, cette action gre si le disque est protg.
+                               Note: cette action est évitée en amont si aucun disque n'est présent dans
+                               le lecteur. En revanche, cette action gère si le disque est protégé.
                             */
                             {
                                 struct FileLockTO *FLBase=(struct FileLockTO *)BADDR(DosPacket->dp_Arg2);
@@ -765,7 +780,11 @@ void MainLoop(struct HandlerData *HData)
                                ARG2:   LONG    32 Bit pass key
                                RES1:   BOOL    DOSTRUE/DOSFALSE
                             */
-                            Debug(T("ACTION_WRITE_PROTECT"));
+                            {
+                                BOOL Flag=(BOOL)DosPacket->dp_Arg1;
+                                if(Hdl_WriteProtect(HData,Flag,&Result2)) Result1=DOSTRUE;
+                                Debug(T("ACTION_WRITE_PROTECT\nMode=%ld\nResult1=%ld\nResult2=%ld",Flag,Result1,Result2));
+                            }
                             break;
 
                         case ACTION_SET_OWNER:
@@ -827,6 +846,32 @@ void MainLoop(struct HandlerData *HData)
                             }
                             break;
 
+                        case ACTION_TOFS_CHANGEDISK:
+                            /* ARG1:   BOOL    DOSTRUE = insertion
+                                               DOSFALSE = retrait
+                               RES1:   BOOL    DOSTRUE/DOSFALSE
+                            */
+                            {
+                                BOOL Flag=(BOOL)DosPacket->dp_Arg1;
+                                if(Hdl_ChangeDisk(HData,Flag,&Result2)) Result1=DOSTRUE;
+                                Debug(T("ACTION_TOFS_CHANGEDISK\nMode=%ld\nResult1=%ld\nResult2=%ld",Flag,Result1,Result2));
+                            }
+                            break;
+
+                        case ACTION_TOFS_GETSIMSTATS:
+                            /* ARG1:   APTR    struct DataLayerSimStats à remplir
+                               ARG2:   BOOL    DOSTRUE pour remettre les statistiques à zéro
+                               RES1:   BOOL    DOSTRUE/DOSFALSE (source non simulée)
+                            */
+                            {
+                                struct DataLayerSimStats *StatsPtr=(struct DataLayerSimStats *)DosPacket->dp_Arg1;
+                                BOOL IsReset=(BOOL)DosPacket->dp_Arg2;
+                                if(DL_GetSimStats(HData->DiskLayerPtr,StatsPtr,IsReset)) Result1=DOSTRUE;
+                                else Result2=ERROR_ACTION_NOT_KNOWN;
+                                Debug(T("ACTION_TOFS_GETSIMSTATS\nReset=%ld\nResult1=%ld",IsReset,Result1));
+                            }
+                            break;
+
                         default:
                             Result2=ERROR_ACTION_NOT_KNOWN;
                             Debug(T("Action inconnue!\n%ld",(long)DosPacket->dp_Type));
@@ -850,10 +895,10 @@ void MainLoop(struct HandlerData *HData)
 
 /*****
     Permet de valider si le type de packet est permis.
-    Cette fonction teste l'tat du file system, la prsence du disque, ainsi
+    Cette fonction teste l'état du file system, la présence du disque, ainsi
     que le flag d'inhibition.
-    Note: Cette fonction ne teste pas si le disque est protg ou non. Ceci
-    est fait au niveau des fonctions concernes.
+    Note: Cette fonction ne teste pas si le disque est protégé ou non. Ceci
+    est fait au niveau des fonctions concernées.
 *****/
 
 BOOL CheckStatus(struct HandlerData *HData, LONG Type, LONG *Result2)
@@ -894,7 +939,7 @@ BOOL CheckStatus(struct HandlerData *HData, LONG Type, LONG *Result2)
         case ACTION_CREATE_DIR:
         case ACTION_CURRENT_VOLUME:
             /* Ces commandes sont non permises en cas d'absence de disque,
-               de file system invalide, ou de mode inhibit activ.
+               de file system invalide, ou de mode inhibit activé.
             */
             if(HData->DeviceState==DS_NONE)
             {
@@ -931,6 +976,8 @@ BOOL CheckStatus(struct HandlerData *HData, LONG Type, LONG *Result2)
         case ACTION_WRITE_PROTECT:
         case ACTION_MORE_CACHE:
         case ACTION_TOFS_LOCKSECTOR:
+        case ACTION_TOFS_CHANGEDISK:
+        case ACTION_TOFS_GETSIMSTATS:
             /* Ces commandes sont toujours permises */
             break;
     }
@@ -2,7 +2,11 @@
 #include "sectorcache.h"
 
 /*
-    23-09-2020 (Seg)    Amlioration de la gestion du cache
+    17-10-2026 (Seg)    Liste des secteurs modifiés triée par piste/secteur
+    17-10-2026 (Seg)    Allocation des noeuds par blocs (slabs) et recyclage sans effacement
+    17-10-2026 (Seg)    Liste LRU des secteurs non modifiés et compteur de noeuds
+    17-10-2026 (Seg)    Indexation des secteurs par table de hachage (Track,Sector)
+    23-09-2020 (Seg)    Amélioration de la gestion du cache
     16-09-2020 (Seg)    Renommage de l'api
     16-08-2020 (Seg)    Gestion d'un cache de secteurs
 */
@@ -12,16 +16,30 @@
 struct SectorCache *Sch_Alloc(ULONG);
 void Sch_Free(struct SectorCache *);
 void Sch_Init(struct SectorCache *, ULONG);
+void Sch_Dispose(struct SectorCache *);
+LONG Sch_SetBufferMax(struct SectorCache *, LONG);
 void Sch_Flush(struct SectorCache *);
 ULONG Sch_GetCount(struct SectorCache *);
 struct SectorCacheNode *Sch_Find(struct SectorCache *, LONG, LONG);
 struct SectorCacheNode *Sch_ObtainOlder(struct SectorCache *, LONG, LONG);
 struct SectorCacheNode *Sch_Obtain(struct SectorCache *, LONG, LONG, BOOL);
-void Sch_Release(struct SectorCacheNode *, BOOL);
+void Sch_Release(struct SectorCache *, struct SectorCacheNode *, BOOL);
+void Sch_SetStatus(struct SectorCache *, struct SectorCacheNode *, LONG);
 void Sch_FreeNode(struct SectorCache *, struct SectorCacheNode *);
 struct SectorCacheNode *Sch_GetMinSectorCacheNode(struct SectorCache *, BOOL);
 
 struct SectorCacheNode *P_Sch_New(struct SectorCache *, LONG, LONG);
+void P_Sch_AddHash(struct SectorCache *, struct SectorCacheNode *);
+void P_Sch_RemHash(struct SectorCache *, struct SectorCacheNode *);
+void P_Sch_Link(struct SectorCache *, struct SectorCacheNode *);
+void P_Sch_Unlink(struct SectorCache *, struct SectorCacheNode *);
+struct SectorCacheNode **P_Sch_GetListHead(struct SectorCache *, LONG);
+struct SectorCacheNode **P_Sch_GetListTail(struct SectorCache *, LONG);
+BOOL P_Sch_SetHashSize(struct SectorCache *, LONG);
+BOOL P_Sch_AddSlab(struct SectorCache *, ULONG);
+BOOL P_Sch_RemSlab(struct SectorCache *, struct SectorCacheSlab *);
+
+#define P_SCH_HASH(Track,Sector) ((((ULONG)(Track))<<4)+(ULONG)(Sector))
 
 
 /*****
@@ -39,14 +57,14 @@ struct SectorCache *Sch_Alloc(ULONG SectorSize)
 
 
 /*****
-    Libration du cache allou par Sch_Alloc(), et libration des ressources associes
+    Libération du cache alloué par Sch_Alloc(), et libération des ressources associées
 *****/
 
 void Sch_Free(struct SectorCache *SectorCachePtr)
 {
     if(SectorCachePtr!=NULL)
     {
-        Sch_Flush(SectorCachePtr);
+        Sch_Dispose(SectorCachePtr);
         Sys_FreeMem((void *)SectorCachePtr);
     }
 }
@@ -60,42 +78,111 @@ void Sch_Init(struct SectorCache *SectorCachePtr, ULONG SectorSize)
 {
     if(SectorCachePtr!=NULL)
     {
-        SectorCachePtr->UID=0;
         SectorCachePtr->SectorSize=SectorSize;
+        SectorCachePtr->Count=0;
         SectorCachePtr->FirstNodePtr=NULL;
+        SectorCachePtr->LastNodePtr=NULL;
+        SectorCachePtr->FirstUpdatedNodePtr=NULL;
+        SectorCachePtr->LastUpdatedNodePtr=NULL;
+        SectorCachePtr->FirstFreeNodePtr=NULL;
+        SectorCachePtr->FirstSlabPtr=NULL;
+        SectorCachePtr->CountOfNodes=0;
+        SectorCachePtr->HashTablePtr=NULL;
+        SectorCachePtr->HashMask=0;
     }
 }
 
 
 /*****
-    Nettoyage des ressources alloues
+    Libération des ressources d'une structure initialisée par Sch_Init()
 *****/
 
-void Sch_Flush(struct SectorCache *SectorCachePtr)
+void Sch_Dispose(struct SectorCache *SectorCachePtr)
 {
     if(SectorCachePtr!=NULL)
     {
-        while(SectorCachePtr->FirstNodePtr!=NULL) Sch_FreeNode(SectorCachePtr,SectorCachePtr->FirstNodePtr);
+        struct SectorCacheSlab *SlabPtr;
+
+        Sch_Flush(SectorCachePtr);
+        while((SlabPtr=SectorCachePtr->FirstSlabPtr)!=NULL)
+        {
+            SectorCachePtr->FirstSlabPtr=SlabPtr->NextPtr;
+            Sys_FreeMem((void *)SlabPtr);
+        }
+        SectorCachePtr->FirstFreeNodePtr=NULL;
+        SectorCachePtr->CountOfNodes=0;
+        Sys_FreeMem((void *)SectorCachePtr->HashTablePtr);
+        SectorCachePtr->HashTablePtr=NULL;
+        SectorCachePtr->HashMask=0;
     }
 }
 
 
 /*****
-    Retourne le nombre de secteurs actuellement en cache
+    Dimensionne le cache en fonction du nombre de buffers maximum.
+    Les noeuds et leurs buffers sont alloués par blocs contigus (slabs): un nouveau bloc
+    est alloué pour la différence lorsque le nombre de buffers augmente, et les blocs
+    devenus inutiles sont rendus lorsqu'il diminue. Un bloc contenant des secteurs
+    modifiés n'est jamais libéré.
+    La table de hachage est redimensionnée à une puissance de 2 supérieure ou égale au
+    nombre de buffers, de manière à garder en moyenne moins d'un secteur par entrée.
+    Retourne le nombre de buffers réellement utilisables, qui peut être inférieur à
+    CountOfBufferMax en cas d'erreur mémoire.
 *****/
 
-ULONG Sch_GetCount(struct SectorCache *SectorCachePtr)
+LONG Sch_SetBufferMax(struct SectorCache *SectorCachePtr, LONG CountOfBufferMax)
 {
-    ULONG Result=0;
-    struct SectorCacheNode *NodePtr=SectorCachePtr->FirstNodePtr;
+    struct SectorCacheSlab *SlabPtr,*NextSlabPtr;
+
+    /* Note: en cas d'erreur mémoire, le cache garde son ancien index */
+    P_Sch_SetHashSize(SectorCachePtr,CountOfBufferMax);
+
+    if((ULONG)CountOfBufferMax>SectorCachePtr->CountOfNodes)
+    {
+        P_Sch_AddSlab(SectorCachePtr,(ULONG)CountOfBufferMax-SectorCachePtr->CountOfNodes);
+    }
+    else
+    {
+        /* On recycle les secteurs les plus anciens en trop */
+        while(SectorCachePtr->Count>(ULONG)CountOfBufferMax && SectorCachePtr->LastNodePtr!=NULL)
+        {
+            Sch_FreeNode(SectorCachePtr,SectorCachePtr->LastNodePtr);
+        }
+
+        /* Puis on rend les blocs qui ne sont plus nécessaires */
+        for(SlabPtr=SectorCachePtr->FirstSlabPtr; SlabPtr!=NULL; SlabPtr=NextSlabPtr)
+        {
+            NextSlabPtr=SlabPtr->NextPtr;
+            if(SectorCachePtr->CountOfNodes-SlabPtr->CountOfNodes>=(ULONG)CountOfBufferMax) P_Sch_RemSlab(SectorCachePtr,SlabPtr);
+        }
+    }
+
+    if(SectorCachePtr->CountOfNodes<(ULONG)CountOfBufferMax) return (LONG)SectorCachePtr->CountOfNodes;
+    return CountOfBufferMax;
+}
+
+
+/*****
+    Nettoyage des ressources allouées
+*****/
 
-    while(NodePtr!=NULL)
+void Sch_Flush(struct SectorCache *SectorCachePtr)
+{
+    if(SectorCachePtr!=NULL)
     {
-        Result++;
-        NodePtr=NodePtr->NextPtr;
+        while(SectorCachePtr->FirstNodePtr!=NULL) Sch_FreeNode(SectorCachePtr,SectorCachePtr->FirstNodePtr);
+        while(SectorCachePtr->FirstUpdatedNodePtr!=NULL) Sch_FreeNode(SectorCachePtr,SectorCachePtr->FirstUpdatedNodePtr);
     }
+}
+
 
-    return Result;
+/*****
+    Retourne le nombre de secteurs actuellement en cache
+*****/
+
+ULONG Sch_GetCount(struct SectorCache *SectorCachePtr)
+{
+    return SectorCachePtr->Count;
 }
 
 
@@ -108,43 +195,49 @@ ULONG Sch_GetCount(struct SectorCache *SectorCachePtr)
 
 struct SectorCacheNode *Sch_Find(struct SectorCache *SectorCachePtr, LONG Track, LONG Sector)
 {
-    struct SectorCacheNode *Ptr=SectorCachePtr->FirstNodePtr;
+    struct SectorCacheNode *Ptr;
 
-    while(Ptr!=NULL && (Ptr->Track!=Track || Ptr->Sector!=Sector)) Ptr=Ptr->NextPtr;
+    if(SectorCachePtr->HashTablePtr!=NULL)
+    {
+        Ptr=SectorCachePtr->HashTablePtr[P_SCH_HASH(Track,Sector)&SectorCachePtr->HashMask];
+        while(Ptr!=NULL && (Ptr->Track!=Track || Ptr->Sector!=Sector)) Ptr=Ptr->HashNextPtr;
+    }
+    else
+    {
+        /* Pas de table de hachage (erreur mémoire): on parcourt les listes */
+        Ptr=SectorCachePtr->FirstNodePtr;
+        while(Ptr!=NULL && (Ptr->Track!=Track || Ptr->Sector!=Sector)) Ptr=Ptr->NextPtr;
+        if(Ptr==NULL)
+        {
+            Ptr=SectorCachePtr->FirstUpdatedNodePtr;
+            while(Ptr!=NULL && (Ptr->Track!=Track || Ptr->Sector!=Sector)) Ptr=Ptr->NextPtr;
+        }
+    }
 
     return Ptr;
 }
 
 
 /*****
-    Cherche un vieux cache pour le librer et l'utiliser comme nouveau cache pour un nouveau couple Track/Sector
+    Cherche un vieux cache pour le libérer et l'utiliser comme nouveau cache pour un nouveau couple Track/Sector.
+    Le cache récupéré est le moins récemment utilisé parmi les caches non modifiés, c'est à dire
+    le dernier de la liste LRU.
+    Note: le buffer n'est pas effacé, puisqu'il est en principe écrasé par la lecture du secteur.
 *****/
 
 struct SectorCacheNode *Sch_ObtainOlder(struct SectorCache *SectorCachePtr, LONG Track, LONG Sector)
 {
-    struct SectorCacheNode *ResultPtr=NULL;
-    struct SectorCacheNode *NodePtr=SectorCachePtr->FirstNodePtr;
-    ULONG UIDMin=~0;
-
-    while(NodePtr!=NULL)
-    {
-        if(NodePtr->Status!=SCN_UPDATED && NodePtr->UID<UIDMin)
-        {
-            UIDMin=NodePtr->UID;
-            ResultPtr=NodePtr;
-        }
-
-        NodePtr=NodePtr->NextPtr;
-    }
+    struct SectorCacheNode *ResultPtr=SectorCachePtr->LastNodePtr;
 
     if(ResultPtr!=NULL)
     {
-        LONG i;
-        for(i=0; i<SectorCachePtr->SectorSize; i++) ResultPtr->BufferPtr[i]=0;
+        P_Sch_RemHash(SectorCachePtr,ResultPtr);
+        P_Sch_Unlink(SectorCachePtr,ResultPtr);
         ResultPtr->Track=Track;
         ResultPtr->Sector=Sector;
         ResultPtr->Status=SCN_NEW;
-        ResultPtr->UID=SectorCachePtr->UID++;
+        P_Sch_Link(SectorCachePtr,ResultPtr);
+        P_Sch_AddHash(SectorCachePtr,ResultPtr);
     }
 
     return ResultPtr;
@@ -152,19 +245,28 @@ struct SectorCacheNode *Sch_ObtainOlder(struct SectorCache *SectorCachePtr, LONG
 
 
 /*****
-    Rcupre le cache associ  la Track et au Sector.
+    Récupère le cache associé à la Track et au Sector.
     Si le cache n'existe pas, la fonction alloue un nouveau cache.
     Retourne:
-    - NULL si erreur mmoire
-    - sinon NULL sinon. Attention  vrifier le champ Status pour savoir s'il s'agit d'un nouveau cache allou, ou d'un
-      ancien dj initialis.
+    - NULL si erreur mémoire
+    - sinon NULL sinon. Attention à vérifier le champ Status pour savoir s'il s'agit d'un nouveau cache alloué, ou d'un
+      ancien déjà initialisé.
 *****/
 
 struct SectorCacheNode *Sch_Obtain(struct SectorCache *SectorCachePtr, LONG Track, LONG Sector, BOOL IsCreateIfNotExists)
 {
     struct SectorCacheNode *Ptr=Sch_Find(SectorCachePtr,Track,Sector);
 
-    if(Ptr==NULL && IsCreateIfNotExists)
+    if(Ptr!=NULL)
+    {
+        /* Le secteur devient le plus récemment utilisé (la liste des secteurs modifiés reste triée) */
+        if(Ptr->Status!=SCN_UPDATED && Ptr!=SectorCachePtr->FirstNodePtr)
+        {
+            P_Sch_Unlink(SectorCachePtr,Ptr);
+            P_Sch_Link(SectorCachePtr,Ptr);
+        }
+    }
+    else if(IsCreateIfNotExists)
     {
         Ptr=P_Sch_New(SectorCachePtr,Track,Sector);
     }
@@ -174,58 +276,84 @@ struct SectorCacheNode *Sch_Obtain(struct SectorCache *SectorCachePtr, LONG Trac
 
 
 /*****
-    Libration d'un cache prcdemment obtenu par Sch_Obtain().
-    Cette mthode ne dsalloue pas les ressources, mais elle libre un vrou dessus.
-    Paramtres:
-    - NodePtr: le pointeur sur le cache  librer
+    Libération d'un cache précédemment obtenu par Sch_Obtain().
+    Cette méthode ne désalloue pas les ressources, mais elle libère un vérou dessus.
+    Paramètres:
+    - SectorCachePtr: pointeur sur le cache
+    - NodePtr: le pointeur sur le cache à libérer
     - IsUpdated: pour indiquer s'il y a eu une modification sur le cache
 *****/
 
-void Sch_Release(struct SectorCacheNode *NodePtr, BOOL IsUpdated)
+void Sch_Release(struct SectorCache *SectorCachePtr, struct SectorCacheNode *NodePtr, BOOL IsUpdated)
 {
     if(NodePtr!=NULL)
     {
-        if(IsUpdated) NodePtr->Status=SCN_UPDATED;
+        if(IsUpdated) Sch_SetStatus(SectorCachePtr,NodePtr,SCN_UPDATED);
+    }
+}
+
+
+/*****
+    Change le statut d'un cache.
+    Un cache qui passe en SCN_UPDATED quitte la liste LRU et ne peut plus être recyclé par
+    Sch_ObtainOlder() avant d'avoir été réécrit et remis dans un autre statut.
+*****/
+
+void Sch_SetStatus(struct SectorCache *SectorCachePtr, struct SectorCacheNode *NodePtr, LONG Status)
+{
+    if(NodePtr!=NULL && NodePtr->Status!=Status)
+    {
+        P_Sch_Unlink(SectorCachePtr,NodePtr);
+        NodePtr->Status=Status;
+        P_Sch_Link(SectorCachePtr,NodePtr);
     }
 }
 
 
 
 /*****
-    Fonction pour librer les resources d'un cache
+    Fonction pour libérer un cache. Le noeud retourne dans la liste des noeuds libres.
 *****/
 
 void Sch_FreeNode(struct SectorCache *SectorCachePtr, struct SectorCacheNode *NodePtr)
 {
-    if(NodePtr!=NULL)
+    if(NodePtr!=NULL && NodePtr->Status!=SCN_FREE)
     {
         /* On refait le chainage */
-        if(NodePtr->PrevPtr!=NULL) NodePtr->PrevPtr->NextPtr=NodePtr->NextPtr; else SectorCachePtr->FirstNodePtr=NodePtr->NextPtr;
-        if(NodePtr->NextPtr!=NULL) NodePtr->NextPtr->PrevPtr=NodePtr->PrevPtr;
+        P_Sch_RemHash(SectorCachePtr,NodePtr);
+        P_Sch_Unlink(SectorCachePtr,NodePtr);
+        SectorCachePtr->Count--;
 
-        /* On libre les ressources */
-        Sys_FreeMem((void *)NodePtr);
+        /* On rend le noeud au pool */
+        NodePtr->Status=SCN_FREE;
+        P_Sch_Link(SectorCachePtr,NodePtr);
     }
 }
 
 
 /*****
     Permet d'obtenir le secteur dans le cache qui est le plus proche de la piste 0, secteur 0.
-    Paramtres:
+    Les secteurs modifiés étant triés par piste/secteur, le premier d'entre eux est obtenu
+    directement. Une écriture de tous les secteurs modifiés se fait ainsi en une seule passe,
+    avec une tête qui avance toujours dans le même sens.
+    Paramètres:
     - SectorCachePtr: pointeur sur le cache
-    - IsUpdatedOnly: pour ne rechercher que les secteurs flagus "SCN_UPDATED"
+    - IsUpdatedOnly: pour ne rechercher que les secteurs flagués "SCN_UPDATED"
     Retourne: un pointeur sur un cache, ou NULL
 *****/
 
 struct SectorCacheNode *Sch_GetMinSectorCacheNode(struct SectorCache *SectorCachePtr, BOOL IsUpdatedOnly)
 {
-    struct SectorCacheNode *NodePtr=NULL;
-    struct SectorCacheNode *CurNodePtr=SectorCachePtr->FirstNodePtr;
-    ULONG Track=~0,Sector=~0;
+    struct SectorCacheNode *NodePtr=SectorCachePtr->FirstUpdatedNodePtr;
 
-    while(CurNodePtr!=NULL)
+    if(!IsUpdatedOnly)
     {
-        if(!IsUpdatedOnly || (IsUpdatedOnly && CurNodePtr->Status==SCN_UPDATED))
+        /* On compare avec les secteurs de la liste LRU, qui n'est pas triée */
+        struct SectorCacheNode *CurNodePtr=SectorCachePtr->FirstNodePtr;
+        ULONG Track=NodePtr!=NULL?NodePtr->Track:~0;
+        ULONG Sector=NodePtr!=NULL?NodePtr->Sector:~0;
+
+        while(CurNodePtr!=NULL)
         {
             if((ULONG)CurNodePtr->Track<Track || ((ULONG)CurNodePtr->Track==Track && (ULONG)CurNodePtr->Sector<Sector))
             {
@@ -233,9 +361,9 @@ struct SectorCacheNode *Sch_GetMinSectorCacheNode(struct SectorCache *SectorCach
                 Track=NodePtr->Track;
                 Sector=NodePtr->Sector;
             }
-        }
 
-        CurNodePtr=CurNodePtr->NextPtr;
+            CurNodePtr=CurNodePtr->NextPtr;
+        }
     }
 
     return NodePtr;
@@ -243,28 +371,230 @@ struct SectorCacheNode *Sch_GetMinSectorCacheNode(struct SectorCache *SectorCach
 
 
 /*****
-    Fonction prive pour allouer un nouveau cache
+    Fonction privée pour obtenir un nouveau cache depuis la liste des noeuds libres
 *****/
 
 struct SectorCacheNode *P_Sch_New(struct SectorCache *SectorCachePtr, LONG Track, LONG Sector)
 {
-    /* Allocation de la structure et du buffer en mme temps */
-    struct SectorCacheNode *Ptr=(struct SectorCacheNode *)Sys_AllocMem(sizeof(struct SectorCacheNode)+sizeof(UBYTE)*SectorCachePtr->SectorSize);
+    struct SectorCacheNode *Ptr=SectorCachePtr->FirstFreeNodePtr;
 
     if(Ptr!=NULL)
     {
-        Ptr->BufferPtr=&((UBYTE *)Ptr)[sizeof(struct SectorCacheNode)];
+        P_Sch_Unlink(SectorCachePtr,Ptr);
         Ptr->Track=Track;
         Ptr->Sector=Sector;
         Ptr->Status=SCN_NEW;
-        Ptr->UID=SectorCachePtr->UID++;
-        if(SectorCachePtr->FirstNodePtr!=NULL)
+        P_Sch_Link(SectorCachePtr,Ptr);
+        P_Sch_AddHash(SectorCachePtr,Ptr);
+        SectorCachePtr->Count++;
+    }
+
+    return Ptr;
+}
+
+
+/*****
+    Fonction privée pour ajouter un noeud dans la table de hachage
+*****/
+
+void P_Sch_AddHash(struct SectorCache *SectorCachePtr, struct SectorCacheNode *NodePtr)
+{
+    if(SectorCachePtr->HashTablePtr!=NULL)
+    {
+        struct SectorCacheNode **BucketPtr=&SectorCachePtr->HashTablePtr[P_SCH_HASH(NodePtr->Track,NodePtr->Sector)&SectorCachePtr->HashMask];
+
+        NodePtr->HashNextPtr=*BucketPtr;
+        *BucketPtr=NodePtr;
+    }
+}
+
+
+/*****
+    Fonction privée pour retirer un noeud de la table de hachage
+*****/
+
+void P_Sch_RemHash(struct SectorCache *SectorCachePtr, struct SectorCacheNode *NodePtr)
+{
+    if(SectorCachePtr->HashTablePtr!=NULL)
+    {
+        struct SectorCacheNode **BucketPtr=&SectorCachePtr->HashTablePtr[P_SCH_HASH(NodePtr->Track,NodePtr->Sector)&SectorCachePtr->HashMask];
+
+        while(*BucketPtr!=NULL && *BucketPtr!=NodePtr) BucketPtr=&(*BucketPtr)->HashNextPtr;
+        if(*BucketPtr!=NULL) *BucketPtr=NodePtr->HashNextPtr;
+    }
+
+    NodePtr->HashNextPtr=NULL;
+}
+
+
+
+/*****
+    Fonction privée pour ajouter un noeud dans la liste correspondant à son statut:
+    - en tête de la liste LRU pour les caches non modifiés,
+    - à sa place dans la liste des caches modifiés, triée par piste/secteur. La recherche se fait
+      depuis la fin de liste, ce qui est immédiat pour des écritures séquentielles.
+    - en tête de la liste des noeuds libres.
+*****/
+
+void P_Sch_Link(struct SectorCache *SectorCachePtr, struct SectorCacheNode *NodePtr)
+{
+    struct SectorCacheNode **FirstPtr=P_Sch_GetListHead(SectorCachePtr,NodePtr->Status);
+    struct SectorCacheNode **LastPtr=P_Sch_GetListTail(SectorCachePtr,NodePtr->Status);
+    struct SectorCacheNode *PrevPtr=NULL;
+
+    if(NodePtr->Status==SCN_UPDATED)
+    {
+        PrevPtr=*LastPtr;
+        while(PrevPtr!=NULL && (PrevPtr->Track>NodePtr->Track || (PrevPtr->Track==NodePtr->Track && PrevPtr->Sector>NodePtr->Sector))) PrevPtr=PrevPtr->PrevPtr;
+    }
+
+    NodePtr->PrevPtr=PrevPtr;
+    NodePtr->NextPtr=PrevPtr!=NULL?PrevPtr->NextPtr:*FirstPtr;
+    if(NodePtr->NextPtr!=NULL) NodePtr->NextPtr->PrevPtr=NodePtr; else if(LastPtr!=NULL) *LastPtr=NodePtr;
+    if(PrevPtr!=NULL) PrevPtr->NextPtr=NodePtr; else *FirstPtr=NodePtr;
+}
+
+
+/*****
+    Fonction privée pour retirer un noeud de la liste correspondant à son statut
+*****/
+
+void P_Sch_Unlink(struct SectorCache *SectorCachePtr, struct SectorCacheNode *NodePtr)
+{
+    struct SectorCacheNode **FirstPtr=P_Sch_GetListHead(SectorCachePtr,NodePtr->Status);
+    struct SectorCacheNode **LastPtr=P_Sch_GetListTail(SectorCachePtr,NodePtr->Status);
+
+    if(NodePtr->PrevPtr!=NULL) NodePtr->PrevPtr->NextPtr=NodePtr->NextPtr;
+    else *FirstPtr=NodePtr->NextPtr;
+
+    if(NodePtr->NextPtr!=NULL) NodePtr->NextPtr->PrevPtr=NodePtr->PrevPtr;
+    else if(LastPtr!=NULL) *LastPtr=NodePtr->PrevPtr;
+
+    NodePtr->PrevPtr=NULL;
+    NodePtr->NextPtr=NULL;
+}
+
+
+/*****
+    Fonction privée pour obtenir la tête de liste associée à un statut
+*****/
+
+struct SectorCacheNode **P_Sch_GetListHead(struct SectorCache *SectorCachePtr, LONG Status)
+{
+    switch(Status)
+    {
+        case SCN_UPDATED: return &SectorCachePtr->FirstUpdatedNodePtr;
+        case SCN_FREE: return &SectorCachePtr->FirstFreeNodePtr;
+    }
+
+    return &SectorCachePtr->FirstNodePtr;
+}
+
+
+/*****
+    Fonction privée pour obtenir la fin de liste associée à un statut.
+    Retourne NULL pour la liste des noeuds libres, qui n'a pas de fin de liste.
+*****/
+
+struct SectorCacheNode **P_Sch_GetListTail(struct SectorCache *SectorCachePtr, LONG Status)
+{
+    switch(Status)
+    {
+        case SCN_UPDATED: return &SectorCachePtr->LastUpdatedNodePtr;
+        case SCN_FREE: return NULL;
+    }
+
+    return &SectorCachePtr->LastNodePtr;
+}
+
+
+/*****
+    Fonction privée pour dimensionner la table de hachage.
+    Retourne:
+    - TRUE si la table a été (ré)allouée ou si elle est déjà à la bonne taille
+    - FALSE si erreur mémoire. Dans ce cas, l'ancienne table reste valide.
+*****/
+
+BOOL P_Sch_SetHashSize(struct SectorCache *SectorCachePtr, LONG CountOfBufferMax)
+{
+    ULONG HashSize=SCH_HASHSIZE_MIN;
+    struct SectorCacheNode **NewTablePtr;
+    struct SectorCacheNode *NodePtr;
+
+    while(HashSize<(ULONG)CountOfBufferMax) HashSize<<=1;
+    if(SectorCachePtr->HashTablePtr!=NULL && SectorCachePtr->HashMask==HashSize-1) return TRUE;
+
+    NewTablePtr=(struct SectorCacheNode **)Sys_AllocMem(sizeof(struct SectorCacheNode *)*HashSize);
+    if(NewTablePtr==NULL) return FALSE;
+
+    /* On remplace la table et on réindexe les secteurs déjà en cache */
+    Sys_FreeMem((void *)SectorCachePtr->HashTablePtr);
+    SectorCachePtr->HashTablePtr=NewTablePtr;
+    SectorCachePtr->HashMask=HashSize-1;
+    for(NodePtr=SectorCachePtr->FirstNodePtr; NodePtr!=NULL; NodePtr=NodePtr->NextPtr) P_Sch_AddHash(SectorCachePtr,NodePtr);
+    for(NodePtr=SectorCachePtr->FirstUpdatedNodePtr; NodePtr!=NULL; NodePtr=NodePtr->NextPtr) P_Sch_AddHash(SectorCachePtr,NodePtr);
+
+    return TRUE;
+}
+
+
+/*****
+    Fonction privée pour allouer un bloc de CountOfNodes noeuds avec leurs buffers, en une
+    seule allocation. Les noeuds sont placés dans la liste des noeuds libres.
+*****/
+
+BOOL P_Sch_AddSlab(struct SectorCache *SectorCachePtr, ULONG CountOfNodes)
+{
+    ULONG i;
+    struct SectorCacheSlab *SlabPtr=(struct SectorCacheSlab *)Sys_AllocMem(sizeof(struct SectorCacheSlab)+(sizeof(struct SectorCacheNode)+sizeof(UBYTE)*SectorCachePtr->SectorSize)*CountOfNodes);
+
+    if(SlabPtr==NULL) return FALSE;
+
+    {
+        struct SectorCacheNode *NodePtr=(struct SectorCacheNode *)&SlabPtr[1];
+        UBYTE *BufferPtr=(UBYTE *)&NodePtr[CountOfNodes];
+
+        for(i=0; i<CountOfNodes; i++, NodePtr++, BufferPtr+=SectorCachePtr->SectorSize)
         {
-            SectorCachePtr->FirstNodePtr->PrevPtr=Ptr;
-            Ptr->NextPtr=SectorCachePtr->FirstNodePtr;
+            NodePtr->BufferPtr=BufferPtr;
+            NodePtr->Status=SCN_FREE;
+            P_Sch_Link(SectorCachePtr,NodePtr);
         }
-        SectorCachePtr->FirstNodePtr=Ptr;
     }
 
-    return Ptr;
+    SlabPtr->CountOfNodes=CountOfNodes;
+    SlabPtr->NextPtr=SectorCachePtr->FirstSlabPtr;
+    SectorCachePtr->FirstSlabPtr=SlabPtr;
+    SectorCachePtr->CountOfNodes+=CountOfNodes;
+
+    return TRUE;
+}
+
+
+/*****
+    Fonction privée pour libérer un bloc de noeuds.
+    Les secteurs non modifiés du bloc sont retirés du cache. Le bloc n'est pas libéré s'il
+    contient des secteurs modifiés.
+*****/
+
+BOOL P_Sch_RemSlab(struct SectorCache *SectorCachePtr, struct SectorCacheSlab *SlabPtr)
+{
+    ULONG i;
+    struct SectorCacheNode *NodePtr=(struct SectorCacheNode *)&SlabPtr[1];
+    struct SectorCacheSlab **PrevSlabPtr=&SectorCachePtr->FirstSlabPtr;
+
+    for(i=0; i<SlabPtr->CountOfNodes; i++) if(NodePtr[i].Status==SCN_UPDATED) return FALSE;
+
+    for(i=0; i<SlabPtr->CountOfNodes; i++)
+    {
+        Sch_FreeNode(SectorCachePtr,&NodePtr[i]);
+        P_Sch_Unlink(SectorCachePtr,&NodePtr[i]);
+    }
+
+    while(*PrevSlabPtr!=SlabPtr) PrevSlabPtr=&(*PrevSlabPtr)->NextPtr;
+    *PrevSlabPtr=SlabPtr->NextPtr;
+    SectorCachePtr->CountOfNodes-=SlabPtr->CountOfNodes;
+    Sys_FreeMem((void *)SlabPtr);
+
+    return TRUE;
 }
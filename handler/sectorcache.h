@@ -4,6 +4,9 @@
 #define SCN_NEW 0
 #define SCN_INITIALIZED 1
 #define SCN_UPDATED 2
+#define SCN_FREE 3
+
+#define SCH_HASHSIZE_MIN 16
 
 struct SectorCacheNode
 {
@@ -11,17 +14,32 @@ struct SectorCacheNode
     LONG Track;
     LONG Sector;
     LONG Status;
-    ULONG UID;
     struct SectorCacheNode *PrevPtr;
     struct SectorCacheNode *NextPtr;
+    struct SectorCacheNode *HashNextPtr;
+};
+
+
+struct SectorCacheSlab
+{
+    struct SectorCacheSlab *NextPtr;
+    ULONG CountOfNodes;
 };
 
 
 struct SectorCache
 {
     ULONG SectorSize;
-    ULONG UID;
+    ULONG Count;
     struct SectorCacheNode *FirstNodePtr;
+    struct SectorCacheNode *LastNodePtr;
+    struct SectorCacheNode *FirstUpdatedNodePtr;
+    struct SectorCacheNode *LastUpdatedNodePtr;
+    struct SectorCacheNode *FirstFreeNodePtr;
+    struct SectorCacheSlab *FirstSlabPtr;
+    ULONG CountOfNodes;
+    struct SectorCacheNode **HashTablePtr;
+    ULONG HashMask;
 };
 
 
@@ -32,12 +50,15 @@ struct SectorCache
 extern struct SectorCache *Sch_Alloc(ULONG);
 extern void Sch_Free(struct SectorCache *);
 extern void Sch_Init(struct SectorCache *, ULONG);
+extern void Sch_Dispose(struct SectorCache *);
+extern LONG Sch_SetBufferMax(struct SectorCache *, LONG);
 extern void Sch_Flush(struct SectorCache *);
 extern ULONG Sch_GetCount(struct SectorCache *);
 extern struct SectorCacheNode *Sch_Find(struct SectorCache *, LONG, LONG);
 extern struct SectorCacheNode *Sch_ObtainOlder(struct SectorCache *, LONG, LONG);
 extern struct SectorCacheNode *Sch_Obtain(struct SectorCache *, LONG, LONG, BOOL);
-extern void Sch_Release(struct SectorCacheNode *, BOOL);
+extern void Sch_Release(struct SectorCache *, struct SectorCacheNode *, BOOL);
+extern void Sch_SetStatus(struct SectorCache *, struct SectorCacheNode *, LONG);
 extern void Sch_FreeNode(struct SectorCache *, struct SectorCacheNode *);
 extern struct SectorCacheNode *Sch_GetMinSectorCacheNode(struct SectorCache *, BOOL);
 
@@ -2,7 +2,7 @@
 #include "system.h"
 
 /*
-    28-08-2018 (Seg)    Fix sur les fonctions de comparaison de chanes
+    28-08-2018 (Seg)    Fix sur les fonctions de comparaison de chaînes
     03-09-2000 (Seg)    Utilisation des fonctions systeme du 3dengine
     19-05-2004 (Seg)    Ajout des fonctions Sys_MemCopy() et Sys_StrCopy()
 */
@@ -64,8 +64,8 @@ void Sys_CloseAllLibs(void)
 
 
 /*****
-    Allocation mmoire
-    - la mmoire alloue est initialise  zro.
+    Allocation mémoire
+    - la mémoire allouée est initialisée à zéro.
     Retourne NULL en cas d'echec
 *****/
 
@@ -76,8 +76,8 @@ void *Sys_AllocMem(ULONG Size)
 
 
 /*****
-    Dsallocation de la mmoire alloue par Sys_AllocMem()
-    Prcondition: Ptr peut tre NULL
+    Désallocation de la mémoire allouée par Sys_AllocMem()
+    Précondition: Ptr peut être NULL
 *****/
 
 void Sys_FreeMem(void *Ptr)
@@ -87,7 +87,7 @@ void Sys_FreeMem(void *Ptr)
 
 
 /*****
-    Ecriture d'une chane de caractres dans la sortie standard.
+    Ecriture d'une chaîne de caractères dans la sortie standard.
 *****/
 #if !defined(__amigaos4__) && !defined(__MORPHOS__)
 LONG Sys_Printf(const char *String, ...)
@@ -105,7 +105,7 @@ LONG Sys_Printf(const char *String, ...)
 
 
 /*****
-    Alloue les ressources ncessaires pour les expressions rgulires
+    Alloue les ressources nécessaires pour les expressions régulières
 *****/
 
 REGEX *Sys_AllocPatternNoCase(const char *Pattern, BOOL *IsPattern)
@@ -130,7 +130,7 @@ REGEX *Sys_AllocPatternNoCase(const char *Pattern, BOOL *IsPattern)
 
 
 /*****
-    Dsalloue les ressources alloues par Sys_AllocTegExPatternNoCase()
+    Désalloue les ressources allouées par Sys_AllocTegExPatternNoCase()
 *****/
 
 void Sys_FreePattern(REGEX *Ptr)
@@ -171,7 +171,7 @@ void Sys_MemCopy(void *Dst, void *Src, LONG Size)
 
 
 /*****
-    Formatage d'une chane de caractres.
+    Formatage d'une chaîne de caractères.
 *****/
 #if !defined(__amigaos4__) && !defined(__MORPHOS__)
 void Sys_SPrintf(char *Buffer,char *String,...)
@@ -198,7 +198,7 @@ void Sys_StrCopy(char *Dst, const char *Src, LONG SizeOfDst)
 
 
 /*****
-    Copie un nombre de caractres spcifi par Len, dans la limite
+    Copie un nombre de caractères spécifié par Len, dans la limite
     du buffer destination.
 *****/
 
@@ -210,7 +210,7 @@ void Sys_StrCopyLen(char *Dst, const char *Src, LONG SizeOfDst, LONG SrcLen)
 
 
 /*****
-    Permet d'obtenir le nombre de caractres du chane.
+    Permet d'obtenir le nombre de caractères du chaîne.
 *****/
 
 LONG Sys_StrLen(const char *String)
@@ -224,7 +224,7 @@ LONG Sys_StrLen(const char *String)
 
 
 /*****
-    Comparaison de deux chanes
+    Comparaison de deux chaînes
 *****/
 
 LONG Sys_StrCmp(const char *Str1, const char *Str2)
@@ -242,7 +242,7 @@ LONG Sys_StrCmp(const char *Str1, const char *Str2)
 
 
 /*****
-    Comparaison de deux chanes
+    Comparaison de deux chaînes
 *****/
 
 LONG Sys_StrCmpNoCase(const char *Str1, const char *Str2)
@@ -8,7 +8,7 @@
 **
 **      todisk device structure and value definitions
 **
-**      (C) Copyright 1999 Rgis GREAU.
+**      (C) Copyright 1999 Régis GREAU.
 **          All Rights Reserved
 **
 */
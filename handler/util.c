@@ -8,10 +8,10 @@
     28-08-2018 (Seg)    Utl_CompareThomsonName() devient Utl_CompareHostName()
     27-08-2018 (Seg)    Remaniement suite gestion des noms avec accents
     11-08-2018 (Seg)    Ajout de Utl_FixedStringToCString()
-    05-06-2017 (Seg)    Modifications pour grer les "extradata" des fichiers .CHG
+    05-06-2017 (Seg)    Modifications pour gérer les "extradata" des fichiers .CHG
     14-09-2016 (Seg)    Ajout de Utl_CompareThomsonName()
     31-08-2016 (Seg)    Modification des commentaires (ajout des accents)
-    23-09-2013 (Seg)    Adaptation du code suite  la migration sous Unix
+    23-09-2013 (Seg)    Adaptation du code suite à la migration sous Unix
     13-01-2013 (Seg)    Normalisation du nom des fonctions
     26-02-2010 (Seg)    Ajout d'une fonction
     30-08-2006 (Seg)    Gestion des noms et label du filesystem
@@ -44,7 +44,7 @@ BOOL Utl_CheckName(const char *, const char *);
 
 
 /*****
-    Permet de convertir un nom en vitant les caractres gnants
+    Permet de convertir un nom en évitant les caractères gênants
 *****/
 
 void Utl_NormalizeName(char *Name, LONG Len)
@@ -60,7 +60,7 @@ void Utl_NormalizeName(char *Name, LONG Len)
 
 
 /*****
-    Permet de convertir une chane en vitant les caractres gnants
+    Permet de convertir une chaîne en évitant les caractères gênants
 *****/
 
 void Utl_NormalizeString(char *Name, LONG Len)
@@ -76,7 +76,7 @@ void Utl_NormalizeString(char *Name, LONG Len)
 
 
 /*****
-    Rduction d'un nom hte en un autre nom hte respectant le nombre de caractres
+    Réduction d'un nom hôte en un autre nom hôte respectant le nombre de caractères
     possibles pour un nom de fichier du file system.
 *****/
 
@@ -93,8 +93,8 @@ void Utl_SplitHostName(const char *HostName, char *SplittedHostName)
     Compare 2 noms de fichier Host ainsi que leur type si besoin.
     Name1: nom 1
     Name2: nom 2
-    Type1: Type du premier fichier. Possibilit de passer NULL.
-    Type2: Type du deuxime fichier. Possibilit de passer NULL.
+    Type1: Type du premier fichier. Possibilité de passer NULL.
+    Type2: Type du deuxième fichier. Possibilité de passer NULL.
 *****/
 
 LONG Utl_CompareHostName(const char *Name1, const LONG *Type1, const char *Name2, const LONG *Type2, BOOL IsSensitive)
@@ -117,7 +117,7 @@ LONG Utl_CompareHostName(const char *Name1, const LONG *Type1, const char *Name2
 /*****
     Conversion d'un nom de fichier Thomson.
     SrcName: 11 octets sans 0 de terminaison
-    DstName: 13 caractres (dont un prvu pour la terminaison et un pour le "." sparateur)
+    DstName: 13 caractères (dont un prévu pour la terminaison et un pour le "." séparateur)
 *****/
 
 void Utl_ConvertThomsonNameToHostName(const UBYTE *SrcName, char *DstName)
@@ -147,7 +147,7 @@ void Utl_ConvertThomsonNameToHostName(const UBYTE *SrcName, char *DstName)
 
 /*****
     Conversion d'un nom de fichier pour le Thomson.
-    SrcName: chane variable termine par un 0
+    SrcName: chaîne variable terminée par un 0
     DstName: 11 octets sans 0 de terminaison
 *****/
 
@@ -165,30 +165,30 @@ void Utl_ConvertHostNameToThomsonName(const char *SrcName, UBYTE *DstName)
     */
     LONG l,p=0;
 
-    /* on scanne jusqu' 8 caractres ou jusqu'au '.' ou jusqu' la fin de chane */
+    /* on scanne jusqu'à 8 caractères ou jusqu'au '.' ou jusqu'à la fin de chaîne */
     for(l=0;p<8 && SrcName[l]!=0 && SrcName[l]!='.';l++) DstName[p++]=SrcName[l];
 
-    /* on complte le nom avec des espaces si besoin */
+    /* on complète le nom avec des espaces si besoin */
     for(;p<8;p++) DstName[p]=' ';
 
-    /* on cherche le '.' ou la fin de chane */
+    /* on cherche le '.' ou la fin de chaîne */
     for(;SrcName[l]!=0 && SrcName[l]!='.';l++);
 
-    /* on cherche le premier caractre aprs le '.' ou la fin de chane */
+    /* on cherche le premier caractère après le '.' ou la fin de chaîne */
     for(;SrcName[l]!=0 && SrcName[l]=='.';l++);
 
-    /* on scanne jusqu' 3 caractres ou jusqu' la fin de chane ou
+    /* on scanne jusqu'à 3 caractères ou jusqu'à la fin de chaîne ou
        jusqu'au prochain point */
     for(;p<11 && SrcName[l]!=0 && SrcName[l]!='.';l++) DstName[p++]=SrcName[l];
 
-    /* on complte le suffixe avec des espaces si besoin */
+    /* on complète le suffixe avec des espaces si besoin */
     for(;p<11;p++) DstName[p]=' ';
 }
 
 
 /*****
-    Retourne un pointeur sur le dbut du commentaire et extrait le Type du commentaire
-    ainsi que l'ventuel "extradata" des fichiers .CHG
+    Retourne un pointeur sur le début du commentaire et extrait le Type du commentaire
+    ainsi que l'éventuel "extradata" des fichiers .CHG
 *****/
 
 const char *Utl_ExtractInfoFromHostComment(const char *Comment, LONG *Type, LONG *ExtraData)
@@ -228,7 +228,7 @@ const char *Utl_ExtractInfoFromHostComment(const char *Comment, LONG *Type, LONG
         }
         if(i==4) ExtractedExtraData=TmpExtraData;
 
-        /* On squizz le contenu restant de la parenthse et les espaces aprs */
+        /* On squizz le contenu restant de la parenthèse et les espaces après */
         while(Comment[p]!=0) if(Comment[p++]==')') break;
         while(Comment[p]==' ') p++;
 
@@ -243,9 +243,9 @@ const char *Utl_ExtractInfoFromHostComment(const char *Comment, LONG *Type, LONG
 
 
 /*****
-    Conversion d'un commentaire Host en commentaire Thomson (8 caractres)
+    Conversion d'un commentaire Host en commentaire Thomson (8 caractères)
     et extraction du type contenu dans le commentaire Host.
-    SrcComment: chane variable contenant ou non un type
+    SrcComment: chaîne variable contenant ou non un type
     DstComment: 8 octets (pas de 0 de terminaison)
     Type (src/dst): type extrait du commentaire SrcComment
     ExtraData (src/dst): extradata (pour les fichiers .CHG) extrait du commentaire SrcComment
@@ -266,8 +266,8 @@ void Utl_ConvertHostCommentToThomsonComment(const char *SrcComment, UBYTE *DstCo
 /*****
     Conversion d'un commentaire Thomson en commentaire Host.
     SrcComment: 8 octets pour le commentaire thomson (pas besoin de 0 en fin)
-    DstComment: 9 caractres dont un pour le 0 de terminaison
-    Type: Type  inclure dans le commentaire DstComment
+    DstComment: 9 caractères dont un pour le 0 de terminaison
+    Type: Type à inclure dans le commentaire DstComment
 *****/
 
 void Utl_ConvertThomsonCommentToHostComment(const UBYTE *SrcComment, char *DstComment)
@@ -284,10 +284,10 @@ void Utl_ConvertThomsonCommentToHostComment(const UBYTE *SrcComment, char *DstCo
 
 
 /*****
-    Pour ajouter ou non les meta data  une zone de commentaire
-    DstComment: buffer de 20 caractres minimum
-    Type: type du fichier  intgrer dans le commentaire
-    ExtraData: donnes CHG  intgrer dans le commentaire (valeur -1 pour ne pas intgrer de donne)
+    Pour ajouter ou non les meta data à une zone de commentaire
+    DstComment: buffer de 20 caractères minimum
+    Type: type du fichier à intégrer dans le commentaire
+    ExtraData: données CHG à intégrer dans le commentaire (valeur -1 pour ne pas intégrer de donnée)
 *****/
 
 LONG Utl_SetCommentMetaData(const char *Comment, char *DstComment, LONG Type, LONG ExtraData)
@@ -302,9 +302,9 @@ LONG Utl_SetCommentMetaData(const char *Comment, char *DstComment, LONG Type, LO
 
 
 /*****
-    Conversion d'une chane en nom de volume Thomson (8 caractres)
-    SrcLabel: chane correspondant au label du disque
-    DstLabel: 8 octets (pas de 0 de terminaison de chane)
+    Conversion d'une chaîne en nom de volume Thomson (8 caractères)
+    SrcLabel: chaîne correspondant au label du disque
+    DstLabel: 8 octets (pas de 0 de terminaison de chaîne)
 *****/
 
 void Utl_ConvertHostLabelToThomsonLabel(const char *SrcLabel, UBYTE *DstLabel)
@@ -317,9 +317,9 @@ void Utl_ConvertHostLabelToThomsonLabel(const char *SrcLabel, UBYTE *DstLabel)
 
 
 /*****
-    Conversion d'un nom de volume Thomson en chane termine par 0
+    Conversion d'un nom de volume Thomson en chaîne terminée par 0
     SrcLabel: 8 octets (pas de 0 de terminaison)
-    DstLabel: 9 caractres minimum (dont un pour le 0 de terminaison)
+    DstLabel: 9 caractères minimum (dont un pour le 0 de terminaison)
 *****/
 
 void Utl_ConvertThomsonLabelToHostLabel(const UBYTE *SrcLabel, char *DstLabel)
@@ -329,9 +329,9 @@ void Utl_ConvertThomsonLabelToHostLabel(const UBYTE *SrcLabel, char *DstLabel)
 
 
 /*****
-    Cette fonction dduit le type d'un fichier en fonction du suffixe de son nom.
+    Cette fonction déduit le type d'un fichier en fonction du suffixe de son nom.
     Name: Nom de fichier classic
-    Retourne: Type dduit du suffixe ($0200 si le suffixe est inconnu)
+    Retourne: Type déduit du suffixe ($0200 si le suffixe est inconnu)
 *****/
 
 LONG Utl_GetTypeFromHostName(const char *Name)
@@ -368,7 +368,7 @@ LONG Utl_GetTypeFromHostName(const char *Name)
         {"#?.AND",0x0500},
         {"#?.PAR",0x0A00},
 #endif
-        {NULL   ,0x0200}    /* type par dfaut *, BIN, MAP,... */
+        {NULL   ,0x0200}    /* type par défaut *, BIN, MAP,... */
     };
     struct AutoType *ATPtr;
 
@@ -390,9 +390,9 @@ LONG Utl_GetTypeFromHostName(const char *Name)
 }
 
 /*****
-    Cette fonction dduit le type d'un fichier en fonction du suffixe de son nom.
+    Cette fonction déduit le type d'un fichier en fonction du suffixe de son nom.
     Name: 11 octets (pas de 0 de terminaison)
-    Retourne: Type dduit du suffixe ($0200 si le suffixe est inconnu)
+    Retourne: Type déduit du suffixe ($0200 si le suffixe est inconnu)
 *****/
 
 LONG Utl_GetTypeFromThomsonName(const UBYTE *Name)
@@ -406,7 +406,7 @@ LONG Utl_GetTypeFromThomsonName(const UBYTE *Name)
 
 
 /*****
-    Conversion du chane de taille fixe, termine par des espaces, en chane termine par nul
+    Conversion du chaîne de taille fixe, terminée par des espaces, en chaîne terminée par nul
 *****/
 
 void Utl_FixedStringToCString(const UBYTE *Str, LONG Size, char *Dst)
@@ -420,7 +420,7 @@ void Utl_FixedStringToCString(const UBYTE *Str, LONG Size, char *Dst)
 
 
 /*****
-    Permet de tester un nom via une expression rgulire
+    Permet de tester un nom via une expression régulière
 *****/
 
 BOOL Utl_CheckName(const char *Pattern, const char *Name)